@@ -10,6 +10,16 @@
 
 //Engine Includes
 #include "Custom_Functions/Custom_RenderFunctions.h"
+#include "Tools/AtlasPacker.h"			//Optional texture atlasing (see BE_RUN_ATLAS_PACKER)
+#include "Tools/SpriteHullBuilder.h"	//Optional frame hulls (see BE_RUN_SPRITE_HULL_BUILDER)
+#include "Tools/SpriteMetaBaker.h"		//Optional baked metadata (see BE_RUN_SPRITE_META_BAKER)
+#include "Tools/JSONLoadBenchmark.h"	//Optional JSON load timings (see BE_RUN_JSON_LOAD_BENCHMARK)
+#include "Tools/ManifestLoadBenchmark.h"	//Optional manifest load timings (see BE_RUN_MANIFEST_LOAD_BENCHMARK)
+#include "Tools/SpriteAnimationBenchmark.h"	//Optional animation timings (see BE_RUN_SPRITE_ANIMATION_BENCHMARK)
+#include "Tools/TextureStreamingBenchmark.h"	//Optional headless streaming run (see BE_RUN_TEXTURE_STREAMING_BENCHMARK)
+#include "Tools/AssetPacker.h"			//Optional asset pack building (see BE_RUN_ASSET_PACKER)
+#include "IO/AssetPack.h"				//Optional asset pack loading (see BE_MOUNT_ASSET_PACK)
+#include "IO/FileWatcher.h"				//Hot reloading (see BE_ENABLE_HOT_RELOAD)
 
 //Project Includes
 #include "All_Managers.h"
@@ -47,6 +57,11 @@ void Game::Update()
 		CloseHandle(eventHandle);
 	}
 
+	//Apply any changed files (patching resources in place before they're used this frame)
+	m_FileWatcher->Update();
+	//Finalise any streamed textures within budget
+	m_TexResourceMgr->UpdateStreaming();
+
 	//Update Controller States
 	m_GPMgr->Update();
 	m_KBMMgr->PreFrameProcess(Game::GetGame()->GetGameTime().DeltaTime());
@@ -301,6 +316,21 @@ bool Game::InitialiseGame()
 	BuildRootSignatures();
 	//Build spritebatches
 	BuildInitialSpritebatches(resourceUpload);
+#if BE_RUN_ASSET_PACKER
+	//Pack the manifests and every file they reference into a single asset pack
+	{
+		AssetPacker assetPacker;
+		assetPacker.AddTextureManifest(BE_TEXTURE_MANIFEST_FP);
+		assetPacker.AddFontManifest(BE_FONT_MANIFEST_FP);
+		assetPacker.AddFile(BE_PREFAB_MANIFEST_FP);
+		assetPacker.Write(BE_ASSET_PACK_FP, AssetPacker::Settings());
+	}
+#endif
+#if BE_MOUNT_ASSET_PACK
+	//Load assets from the pack where it has them (before anything loads), falling back to loose files
+	AssetPack::Mount(BE_ASSET_PACK_FP);
+#endif
+
 	//Build spritefonts (loads fonts from file)
 	BuildInitialSpritefonts(0, resourceUpload);	
 	//Load Textures
@@ -398,6 +428,7 @@ bool Game::ResourceAllocations()
 	m_GraphicsMgr = std::make_unique<Mgr_Graphics>(m_D3DDevice.Get());
 	m_UIMgr = std::make_unique<Mgr_UI>();
 	m_Blackboard = std::make_unique<GameBlackboard>();
+	m_FileWatcher = std::make_unique<FileWatcher>();
 
 	//
 	//Additional M/R/F Here
@@ -500,6 +531,7 @@ bool Game::BuildInitialSpritebatches(DirectX::ResourceUploadBatch& resourceUploa
 		);
 	newSB->m_DrawMode = W_SpriteBatch::DrawMode::BASIC;
 	newSB->m_SortMode = DirectX::SpriteSortMode_FrontToBack;
+	newSB->m_Viewport = m_ScreenViewport;
 	m_GraphicsMgr->InsertNewSpritebatch(newSB);
 
 	//
@@ -515,6 +547,7 @@ bool Game::BuildInitialSpritebatches(DirectX::ResourceUploadBatch& resourceUploa
 		);
 	newSB->m_DrawMode = W_SpriteBatch::DrawMode::TRANSFORMED;
 	newSB->m_SortMode = DirectX::SpriteSortMode_FrontToBack;
+	newSB->m_Viewport = m_ScreenViewport;
 	m_GraphicsMgr->InsertNewSpritebatch(newSB);
 
 	//
@@ -548,6 +581,7 @@ bool Game::BuildInitialSpritebatches(DirectX::ResourceUploadBatch& resourceUploa
 			);
 		newSB->m_DrawMode = W_SpriteBatch::DrawMode::TRANSFORMED;
 		newSB->m_SortMode = DirectX::SpriteSortMode_FrontToBack;
+		newSB->m_Viewport = m_ScreenViewport;
 		m_GraphicsMgr->InsertNewSpritebatch(newSB);
 	}
 
@@ -576,11 +610,15 @@ bool Game::BuildInitialSpritebatches(DirectX::ResourceUploadBatch& resourceUploa
 			);
 		newSB->m_DrawMode = W_SpriteBatch::DrawMode::BASIC;
 		newSB->m_SortMode = DirectX::SpriteSortMode_Immediate;
+		newSB->m_Viewport = m_ScreenViewport;
 		m_GraphicsMgr->InsertNewSpritebatch(newSB);
 	}
 
 	//Spritebatches create, now need to sync up render group count
 	m_GraphicsMgr->SyncRenderGroupCount();
+#if BE_REPORT_RENDER_GROUP_STATS
+	m_GraphicsMgr->RequestRenderGroupReport();
+#endif
 
 	///////////////////////
 	/// Post-Init Setup ///
@@ -593,9 +631,8 @@ bool Game::BuildInitialSpritebatches(DirectX::ResourceUploadBatch& resourceUploa
 	//Need to bind render function to the target spritebatch as it needs custom behaviour
 	{
 		W_SpriteBatch* sb = m_GraphicsMgr->GetSpritebatch((unsigned)BE_ManagerEnums::SpritebatchIndexes::CUSTOM_OUTLINE_GLOW);
-		std::vector<Actor2D_Interface*>* renderGroup = &m_GraphicsMgr->GetRenderGroup((unsigned)BE_ManagerEnums::SpritebatchIndexes::CUSTOM_OUTLINE_GLOW);
 		sb->m_HasCustomRender = true;
-		sb->m_CustomRenderFunc = std::bind(Custom_WSpritebatchDraw, sb, &m_SystemPointers, renderGroup);
+		sb->m_CustomRenderFunc = std::bind(Custom_WSpritebatchDraw, sb, &m_SystemPointers, (unsigned)BE_ManagerEnums::SpritebatchIndexes::CUSTOM_OUTLINE_GLOW);
 	}
 
 	return true;
@@ -605,7 +642,12 @@ bool Game::BuildInitialSpritefonts(unsigned entryIndex, DirectX::ResourceUploadB
 {
 	//Parse font manifest
 	rapidjson::Document fontDoc;
-	ParseNewJSONDocument(fontDoc, std::string(BE_FONT_MANIFEST_FP));
+	std::string error;
+	if (!ParseNewJSONDocument(fontDoc, BE_FONT_MANIFEST_FP, &error))
+	{
+		DBOUT("BuildInitialSpritefonts(): " << error);
+		return false;
+	}
 
 	//Get heap target and confirm validity
 	unsigned heapIndex = fontDoc["Manifests"][entryIndex]["Heap Index"].GetUint();
@@ -636,8 +678,82 @@ bool Game::BuildInitialSpritefonts(unsigned entryIndex, DirectX::ResourceUploadB
 
 bool Game::LoadInitialTextures(DirectX::ResourceUploadBatch& resourceUpload)
 {
+	std::string manifestFP = BE_TEXTURE_MANIFEST_FP;
+
+#if BE_RUN_JSON_LOAD_BENCHMARK
+	//Time JSON loading of the manifests and texture data
+	std::vector<std::string> benchmarkFiles = { BE_TEXTURE_MANIFEST_FP, BE_FONT_MANIFEST_FP, BE_PREFAB_MANIFEST_FP };
+	JSONLoadBenchmark::GatherTextureFiles(manifestFP, 0, benchmarkFiles);
+	JSONLoadBenchmark jsonBenchmark;
+	jsonBenchmark.Run(benchmarkFiles, 100);
+#endif
+
+#if BE_RUN_MANIFEST_LOAD_BENCHMARK
+	//Time staged manifest loading (headless) against entry count
+	ManifestLoadBenchmark manifestBenchmark;
+	manifestBenchmark.Run(manifestFP, 0, 64);
+#endif
+
+#if BE_RUN_TEXTURE_STREAMING_BENCHMARK
+	//Stream the manifest headless (request > load > budgeted finalise > evict > reload)
+	TextureStreamingBenchmark streamingBenchmark;
+	streamingBenchmark.Run(manifestFP, 0, TextureStreamer::Budget());
+#endif
+
+#if BE_RUN_ATLAS_PACKER
+	//Pack manifest index 0 into atlases, loading from the packed manifest instead
+	AtlasPacker packer;
+	if (packer.PackManifest(manifestFP, 0, BE_ATLAS_TEXTURE_MANIFEST_FP, AtlasPacker::Settings()))
+		manifestFP = BE_ATLAS_TEXTURE_MANIFEST_FP;
+#endif
+#if BE_RUN_SPRITE_HULL_BUILDER
+	//Build frame hulls for the (possibly packed) manifest, loading from the hull manifest instead
+	SpriteHullBuilder hullBuilder;
+	if (hullBuilder.ProcessManifest(manifestFP, 0, BE_HULL_TEXTURE_MANIFEST_FP, SpriteHullBuilder::Settings()))
+		manifestFP = BE_HULL_TEXTURE_MANIFEST_FP;
+#endif
+
+#if BE_RUN_SPRITE_META_BAKER
+	//Bake frame/animation data of whichever manifest is loaded (picked up automatically by the load below)
+	SpriteMetaBaker metaBaker;
+	metaBaker.BakeManifest(manifestFP, 0);
+#endif
+
 	//Load from manifest index 0 into heap 0
-	m_TexResourceMgr->LoadTexturesFromManifest(std::string(BE_TEXTURE_MANIFEST_FP), 0, 0, m_D3DDevice.Get(), resourceUpload);
+	m_TexResourceMgr->LoadTexturesFromManifest(manifestFP, 0, 0, m_D3DDevice.Get(), resourceUpload);
+
+#if BE_RUN_SPRITE_ANIMATION_BENCHMARK
+	//Time per-actor animators against the batched system, up to 100k sprites
+	std::string animTexName = "BE_2DTestingTexture";
+	SpriteAnimationBenchmark animBenchmark;
+	animBenchmark.Run(m_TexResourceMgr->FindTextureData(animTexName), 100000, 60);
+#endif
+
+#if BE_ENABLE_TEXTURE_STREAMING
+	//Stream any further textures into heap 0
+	std::string placeholderName = BE_STREAMING_PLACEHOLDER_TEXTURE;
+	m_TexResourceMgr->EnableStreaming(
+		m_TexResourceMgr->CreateDeviceUploadBackend(0, m_D3DDevice.Get(), m_CommandQueue.Get()),
+		placeholderName
+	);
+#if BE_ENABLE_TEXTURE_RESIDENCY
+	//Keep textures within budget, evicting least recently drawn
+	TextureResidencyCache::Settings residency;
+	residency.m_BudgetBytes = static_cast<size_t>(BE_TEXTURE_RESIDENCY_BUDGET_MB) * 1024 * 1024;
+	residency.m_MinUnusedFrames = g_NUM_FRAME_RESOURCES;
+	m_TexResourceMgr->EnableResidency(residency);
+#endif
+#endif
+
+#if BE_ENABLE_HOT_RELOAD
+	//Patch textures in place when their manifest, frame or animation files change
+	m_TexResourceMgr->EnableHotReload(*m_FileWatcher);
+#endif
+
+#if BE_REPORT_DESCRIPTOR_HEAPS
+	//Fonts and initial textures loaded, so report heap usage
+	m_TexResourceMgr->LogHeapReports();
+#endif
 
 	return true;
 }
@@ -692,6 +808,7 @@ bool Game::BuildSystemContainer()
 	m_SystemPointers.m_Blackboard = m_Blackboard.get();
 
 	//Functionality
+	m_SystemPointers.m_FileWatcher = m_FileWatcher.get();
 
 	return true;
 }
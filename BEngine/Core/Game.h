@@ -40,6 +40,7 @@ class Mgr_Modes;
 class Mgr_Graphics;
 class Mgr_UI;
 struct GameBlackboard;
+class FileWatcher;
 
 //Shipping container for passing all important managers/resources in one go
 struct System
@@ -68,6 +69,8 @@ struct System
 
 	Game*				    m_Game = nullptr;
 	GameBlackboard*		    m_Blackboard = nullptr;
+	//Watches files for hot reloading (see FileWatcher), updated between frames
+	FileWatcher*			m_FileWatcher = nullptr;
 
 
 	//
@@ -288,6 +291,9 @@ private:
 	//Functionality
 	//
 
+	//Watches files for changes (see BE_ENABLE_HOT_RELOAD), updated between frames
+	std::unique_ptr<FileWatcher> m_FileWatcher;
+
 
 //================================================================================\\
 // Custom Behaviour + Data
@@ -1,7 +1,10 @@
 #include "Custom_RenderFunctions.h"
 
+//Engine Includes
+#include "Managers/Mgr_Graphics.h"
 
-void Custom_WSpritebatchDraw(W_SpriteBatch* batch, System* sys, std::vector<Actor2D_Interface*>* renderGroup)
+
+void Custom_WSpritebatchDraw(W_SpriteBatch* batch, System* sys, unsigned renderGroupIndex)
 {
 	//Get CL and current FR
 	ID3D12GraphicsCommandList* cmdList = sys->m_Game->GetCommandList().Get();
@@ -18,21 +21,19 @@ void Custom_WSpritebatchDraw(W_SpriteBatch* batch, System* sys, std::vector<Acto
 		currFR->m_FrameBuffer->Resource()->GetGPUVirtualAddress()				//Resource (aligning with cbuffer sig at b1)
 	);
 
+	//Drop anything off screen before sorting
+	sys->m_GraphicsMgr->CullRenderGroup(renderGroupIndex);
+
 	/*
 		The batch doesn't need to be in immediate mode for this (as we aren't doing per-object CBuffers here), but if it is, we want
-		to maintain draw depths as best as using the actors depth level as a guide. We sort high to low (as per engine standar)
+		to maintain draw depths as best as using the actors depth level as a guide. We sort high to low (as per engine standar),
+		with equal depths grouped by texture (via the groups sort keys)
 	*/
 	if (batch->m_SortMode == DirectX::SpriteSortMode_Immediate)
-	{
-		//Lambda sort the container based on actor depth value
-		std::sort(renderGroup->begin(), renderGroup->end(), [](Actor2D_Interface* a, Actor2D_Interface* b)
-		{
-			return a->GetActorDepth() > b->GetActorDepth();
-		});
-	}
+		sys->m_GraphicsMgr->SortRenderGroup(renderGroupIndex);
 
 	//Render the target group
-	for (auto& a : *renderGroup)
+	for (auto& a : sys->m_GraphicsMgr->GetRenderGroup(renderGroupIndex))
 		a->Render(*sys, batch->m_Batch.get());
 
 	//End batch
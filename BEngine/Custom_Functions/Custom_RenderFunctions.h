@@ -17,6 +17,6 @@
 
 /*
 	Custom bindable function for rendering. Starts batch draw, binds const buffer from FrameResources to slot 2,
-	renders given render group (after sorting if required), and then ends the batch.
+	renders given render group (after culling, and sorting if required), and then ends the batch.
 */
-void Custom_WSpritebatchDraw(W_SpriteBatch* batch, System* sys, std::vector<Actor2D_Interface*>* renderGroup);
+void Custom_WSpritebatchDraw(W_SpriteBatch* batch, System* sys, unsigned renderGroupIndex);
@@ -5,12 +5,19 @@
 
 bool FL_Model::InitModelFromFile(std::string& fp, unsigned configIndex)
 {
-	//Clear and release any existing data
-	Release();
-
 	//Load doc
 	rapidjson::Document doc;
-	ParseNewJSONDocument(doc, fp);
+	std::string error;
+	if (!ParseNewJSONDocument(doc, fp, &error))
+	{
+		DBOUT("InitModelFromFile(): " << error);
+		return false;
+	}
+
+	//Clear and release any existing data (once the new data is in hand, so failed reloads keep the current model)
+	Release();
+	m_Filepath = fp;
+	m_ConfigIndex = configIndex;
 
 	//Grab configs array
 	const rapidjson::Value& arr = doc["FL Configs"].GetArray();
@@ -97,6 +104,14 @@ bool FL_Model::InitModelFromFile(std::string& fp, unsigned configIndex)
 	return true;
 }
 
+bool FL_Model::Reload()
+{
+	msg_assert(!m_Filepath.empty(), "Reload(): Model not loaded from file!");
+
+	std::string fp = m_Filepath;
+	return InitModelFromFile(fp, m_ConfigIndex);
+}
+
 int FL_Model::RunModelAlgorithm(const std::vector<float>& inputs)
 {
 	//Pre-check inputs container
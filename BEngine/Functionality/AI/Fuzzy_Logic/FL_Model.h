@@ -35,6 +35,12 @@ public:
 
 	//Inits all model sections from file (See FL_Model_Config_Template.json)
 	bool InitModelFromFile(std::string& fp, unsigned configIndex);
+	/*
+		Reinits the model in place from the file and config it was loaded from, keeping the current model if the file can't
+		be parsed. For hot reloading, e.g. watcher.Watch(model.GetFilepath(), [&model](const std::string&) { model.Reload(); })
+		(see FileWatcher).
+	*/
+	bool Reload();
 
 	//
 	//Operation
@@ -49,6 +55,9 @@ public:
 	/// Accessors ///
 	/////////////////
 
+	//File and config index the model was loaded from
+	const std::string& GetFilepath() { return m_Filepath; }
+	unsigned GetConfigIndex() { return m_ConfigIndex; }
 
 private:
 
@@ -65,6 +74,9 @@ private:
 
 	//Model name (the totality of the subject)
 	std::string m_Name = "N/A";
+	//Where the model was loaded from (for reloading)
+	std::string m_Filepath;
+	unsigned m_ConfigIndex = 0;
 	//Each individual set in the model
 	std::vector<FL_Set> m_Sets;
 	//Associated ruleset
@@ -0,0 +1,252 @@
+#include "Actor2D_FlagRegistry.h"
+
+#include "Utils/Utils_Debug.h"
+#include "Actors/Actor2D_Interface.h"
+
+#include <intrin.h>		//_BitScanForward64
+
+Actor2D_FlagRegistry::~Actor2D_FlagRegistry()
+{
+	//Inform any remaining actors that they are no longer registered
+	Clear();
+}
+
+unsigned Actor2D_FlagRegistry::RegisterActor(Actor2D_Interface* actor)
+{
+	msg_assert(actor, "RegisterActor(): Actor is nullptr!");
+	msg_assert(!actor->m_FlagRegistry, "RegisterActor(): Actor already registered to a registry!");
+
+	//Get index (reusing any free ones first)
+	unsigned index = INVALID_INDEX;
+	if (!m_FreeIndexes.empty())
+	{
+		index = m_FreeIndexes.back();
+		m_FreeIndexes.pop_back();
+		m_Actors[index] = actor;
+	}
+	else
+	{
+		index = static_cast<unsigned>(m_Actors.size());
+		m_Actors.push_back(actor);
+		SyncWordCount();
+	}
+
+	//Mark index as occupied and copy the flags over
+	m_OccupiedSet[index / BITS_PER_WORD] |= (1ull << (index % BITS_PER_WORD));
+	StoreActorFlags(index, actor);
+
+	//Inform actor of registration
+	actor->m_FlagRegistry = this;
+	actor->m_FlagRegistryIndex = index;
+	++m_ActorCount;
+
+	return index;
+}
+
+bool Actor2D_FlagRegistry::UnregisterActor(Actor2D_Interface* actor)
+{
+	//Check that this is the registry the actor is using
+	if (!actor || actor->m_FlagRegistry != this)
+		return false;
+
+	unsigned index = actor->m_FlagRegistryIndex;
+	msg_assert(index < m_Actors.size() && m_Actors[index] == actor, "UnregisterActor(): Actor/Index mismatch!");
+
+	//Clear all bits for this index
+	size_t word = index / BITS_PER_WORD;
+	BitWord bit = ~(1ull << (index % BITS_PER_WORD));
+	m_OccupiedSet[word] &= bit;
+	for (auto& a : m_FlagSets)
+		a[word] &= bit;
+
+	//Free the index for reuse
+	m_Actors[index] = nullptr;
+	m_FreeIndexes.push_back(index);
+	--m_ActorCount;
+
+	actor->m_FlagRegistry = nullptr;
+	actor->m_FlagRegistryIndex = INVALID_INDEX;
+
+	return true;
+}
+
+bool Actor2D_FlagRegistry::TransferActor(Actor2D_Interface* from, Actor2D_Interface* to)
+{
+	if (!from || from->m_FlagRegistry != this)
+		return false;
+	msg_assert(to && !to->m_FlagRegistry, "TransferActor(): Target actor is nullptr or already registered!");
+
+	unsigned index = from->m_FlagRegistryIndex;
+	msg_assert(index < m_Actors.size() && m_Actors[index] == from, "TransferActor(): Actor/Index mismatch!");
+
+	m_Actors[index] = to;
+	to->m_FlagRegistry = this;
+	to->m_FlagRegistryIndex = index;
+	from->m_FlagRegistry = nullptr;
+	from->m_FlagRegistryIndex = INVALID_INDEX;
+
+	return true;
+}
+
+void Actor2D_FlagRegistry::Clear()
+{
+	//Inform actors of removal
+	for (auto& a : m_Actors)
+	{
+		if (a)
+		{
+			a->m_FlagRegistry = nullptr;
+			a->m_FlagRegistryIndex = INVALID_INDEX;
+		}
+	}
+
+	//Clear containers
+	m_Actors.clear();
+	m_FreeIndexes.clear();
+	m_OccupiedSet.clear();
+	for (auto& a : m_FlagSets)
+		a.clear();
+
+	m_ActorCount = 0;
+}
+
+void Actor2D_FlagRegistry::Reserve(size_t count)
+{
+	size_t wordCount = (count + BITS_PER_WORD - 1) / BITS_PER_WORD;
+
+	m_Actors.reserve(count);
+	m_FreeIndexes.reserve(count);
+	m_OccupiedSet.reserve(wordCount);
+	for (auto& a : m_FlagSets)
+		a.reserve(wordCount);
+}
+
+void Actor2D_FlagRegistry::SyncActor(Actor2D_Interface* actor)
+{
+	msg_assert(actor && actor->m_FlagRegistry == this, "SyncActor(): Actor not registered with this registry!");
+	StoreActorFlags(actor->m_FlagRegistryIndex, actor);
+}
+
+void Actor2D_FlagRegistry::SyncAllActors()
+{
+	for (unsigned i(0); i < m_Actors.size(); ++i)
+		if (m_Actors[i])
+			StoreActorFlags(i, m_Actors[i]);
+}
+
+size_t Actor2D_FlagRegistry::FilterIndexes(FlagMask mask, std::vector<unsigned>& indexes)
+{
+	indexes.clear();
+	indexes.reserve(m_ActorCount);
+
+	return RunFilter(mask, [&indexes](unsigned index) { indexes.push_back(index); });
+}
+
+size_t Actor2D_FlagRegistry::FilterActors(FlagMask mask, std::vector<Actor2D_Interface*>& actors)
+{
+	actors.clear();
+	actors.reserve(m_ActorCount);
+
+	return RunFilter(mask, [this, &actors](unsigned index) { actors.push_back(m_Actors[index]); });
+}
+
+size_t Actor2D_FlagRegistry::CountMatching(FlagMask mask)
+{
+	size_t count = 0;
+
+	//Build each word as in RunFilter, only counting the set bits
+	for (size_t i(0); i < m_OccupiedSet.size(); ++i)
+	{
+		BitWord word = m_OccupiedSet[i];
+		for (unsigned j(0); j < FLAG_COUNT && word; ++j)
+			if (mask & (1u << j))
+				word &= m_FlagSets[j][i];
+
+		count += __popcnt64(word);
+	}
+
+	return count;
+}
+
+void Actor2D_FlagRegistry::SetFlag(unsigned index, FlagID id, bool state)
+{
+	msg_assert(index < m_Actors.size() && id != FlagID::COUNT, "SetFlag(): Index or ID OOR!");
+
+	BitWord bit = 1ull << (index % BITS_PER_WORD);
+	BitWord& word = m_FlagSets[static_cast<unsigned>(id)][index / BITS_PER_WORD];
+
+	//Branchless set/clear
+	word = (word & ~bit) | (state ? bit : 0ull);
+}
+
+bool Actor2D_FlagRegistry::GetFlag(unsigned index, FlagID id)
+{
+	msg_assert(index < m_Actors.size() && id != FlagID::COUNT, "GetFlag(): Index or ID OOR!");
+
+	return (m_FlagSets[static_cast<unsigned>(id)][index / BITS_PER_WORD] >> (index % BITS_PER_WORD)) & 1ull;
+}
+
+Actor2D_Interface* Actor2D_FlagRegistry::GetActor(unsigned index)
+{
+	msg_assert(index < m_Actors.size(), "GetActor(): Index OOR!");
+	return m_Actors[index];
+}
+
+void Actor2D_FlagRegistry::StoreActorFlags(unsigned index, Actor2D_Interface* actor)
+{
+	Actor2D_Interface::Flags& flags = actor->GetFlags();
+
+	SetFlag(index, FlagID::IS_ACTIVE, flags.m_IsActive);
+	SetFlag(index, FlagID::CAN_UPDATE, flags.m_CanUpdate);
+	SetFlag(index, FlagID::CAN_RENDER, flags.m_CanRender);
+	SetFlag(index, FlagID::USE_RENDER_GROUPING, flags.m_UseRenderGrouping);
+	SetFlag(index, FlagID::CAN_RUN_ONCE_INIT, flags.m_CanRunOnceInit);
+	SetFlag(index, FlagID::CAN_ACCEPT_INPUTS, flags.m_CanAcceptInputs);
+}
+
+void Actor2D_FlagRegistry::SyncWordCount()
+{
+	size_t wordCount = (m_Actors.size() + BITS_PER_WORD - 1) / BITS_PER_WORD;
+
+	//Only ever grows, new words start cleared
+	if (m_OccupiedSet.size() < wordCount)
+	{
+		m_OccupiedSet.resize(wordCount, 0ull);
+		for (auto& a : m_FlagSets)
+			a.resize(wordCount, 0ull);
+	}
+}
+
+template<class FUNC>
+size_t Actor2D_FlagRegistry::RunFilter(FlagMask mask, FUNC&& func)
+{
+	//Gather the bitsets requested by the mask up front
+	const BitWord* sets[FLAG_COUNT];
+	unsigned setCount = 0;
+	for (unsigned i(0); i < FLAG_COUNT; ++i)
+		if (mask & (1u << i))
+			sets[setCount++] = m_FlagSets[i].data();
+
+	size_t count = 0;
+
+	for (size_t i(0); i < m_OccupiedSet.size(); ++i)
+	{
+		//AND together each requested set (skipping out early if nothing left)
+		BitWord word = m_OccupiedSet[i];
+		for (unsigned j(0); j < setCount && word; ++j)
+			word &= sets[j][i];
+
+		//Extract each set bit, lowest first
+		unsigned base = static_cast<unsigned>(i * BITS_PER_WORD);
+		while (word)
+		{
+			unsigned long bit = 0;
+			_BitScanForward64(&bit, word);
+			func(base + bit);
+			word &= word - 1;
+			++count;
+		}
+	}
+
+	return count;
+}
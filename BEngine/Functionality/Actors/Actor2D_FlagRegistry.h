@@ -0,0 +1,171 @@
+//*********************************************************************************\\
+//
+// Registry that mirrors the Flags of registered actors into packed bitsets (one
+// bitset per flag). Allows for broad filtering (e.g. active + renderable actors)
+// via word-wide bit operations over the sets, without needing to touch each actor
+// in turn, returning compacted lists of indexes/actors that matched the filter.
+//
+//*********************************************************************************\\
+
+#pragma once
+
+//Library Includes
+#include <vector>
+
+//Foward Declarations
+class Actor2D_Interface;
+
+class Actor2D_FlagRegistry
+{
+public:
+
+	//////////////////////////////
+	/// Enums, Types & Statics ///
+	//////////////////////////////
+
+	//Mirrors the general flags found in Actor2D_Interface::Flags (see there for details)
+	enum class FlagID : unsigned
+	{
+		IS_ACTIVE,
+		CAN_UPDATE,
+		CAN_RENDER,
+		USE_RENDER_GROUPING,
+		CAN_RUN_ONCE_INIT,
+		CAN_ACCEPT_INPUTS,
+		COUNT
+	};
+
+	//Combination of FlagIDs as bits (see ToMask)
+	typedef unsigned FlagMask;
+
+	//Converts flag ID to mask bit for use with filter functions
+	static constexpr FlagMask ToMask(FlagID id) { return 1u << static_cast<unsigned>(id); }
+
+	//
+	//Common Filters
+	//
+
+	static constexpr FlagMask MASK_UPDATABLE =
+		(1u << static_cast<unsigned>(FlagID::IS_ACTIVE)) | (1u << static_cast<unsigned>(FlagID::CAN_UPDATE));
+	static constexpr FlagMask MASK_RENDERABLE =
+		(1u << static_cast<unsigned>(FlagID::IS_ACTIVE)) | (1u << static_cast<unsigned>(FlagID::CAN_RENDER));
+	static constexpr FlagMask MASK_RENDER_GROUPED =
+		MASK_RENDERABLE | (1u << static_cast<unsigned>(FlagID::USE_RENDER_GROUPING));
+	static constexpr FlagMask MASK_INPUT_READY =
+		(1u << static_cast<unsigned>(FlagID::IS_ACTIVE)) | (1u << static_cast<unsigned>(FlagID::CAN_ACCEPT_INPUTS));
+
+	//Reserved value for unregistered actors
+	static constexpr unsigned INVALID_INDEX = 0xFFFFFFFF;
+
+	////////////////////
+	/// Constructors ///
+	////////////////////
+
+	Actor2D_FlagRegistry() { }
+	Actor2D_FlagRegistry(size_t reserveCount) { Reserve(reserveCount); }
+	~Actor2D_FlagRegistry();
+
+	//////////////////
+	/// Operations ///
+	//////////////////
+
+	//
+	//Registration
+	//
+
+	/*
+		Registers actor with the registry, storing its current flags state. Index is informed to the actor
+		so that future flag changes via the actor (see Actor2D_Interface::SetFlag) are mirrored here.
+		Freed indexes are reused, so indexes are only stable while the actor remains registered.
+	*/
+	unsigned RegisterActor(Actor2D_Interface* actor);
+	//Removes actor from the registry, clearing all of its flag bits
+	bool UnregisterActor(Actor2D_Interface* actor);
+	//Hands the registration of one actor over to another (unregistered) actor, keeping the index and flags
+	bool TransferActor(Actor2D_Interface* from, Actor2D_Interface* to);
+	//Removes all actors from the registry
+	void Clear();
+
+	//Reserves storage for a given number of actors
+	void Reserve(size_t count);
+
+	//
+	//Syncing
+	//
+
+	/*
+		Re-copies the actors flags into the registry. Use in cases where the flags have been modified directly
+		(i.e. via GetFlags()) rather than via the actors SetFlag function.
+	*/
+	void SyncActor(Actor2D_Interface* actor);
+	//Re-copies flags for all registered actors
+	void SyncAllActors();
+
+	//
+	//Filtering
+	//
+
+	/*
+		Stores the indexes of all actors that have ALL of the flags within the mask set into given container (cleared first).
+		Filter is done word-wide (64 actors per op) and the result is in ascending index order. Returns match count.
+	*/
+	size_t FilterIndexes(FlagMask mask, std::vector<unsigned>& indexes);
+	//As FilterIndexes, except storing the actors themselves
+	size_t FilterActors(FlagMask mask, std::vector<Actor2D_Interface*>& actors);
+	//Returns number of actors that have ALL of the flags within the mask set
+	size_t CountMatching(FlagMask mask);
+
+	/////////////////
+	/// Accessors ///
+	/////////////////
+
+	void SetFlag(unsigned index, FlagID id, bool state);
+	bool GetFlag(unsigned index, FlagID id);
+
+	Actor2D_Interface* GetActor(unsigned index);
+	//Returns number of registered actors
+	size_t GetActorCount() { return m_ActorCount; }
+	//Returns the upper bound of the indexes currently in use
+	size_t GetIndexRange() { return m_Actors.size(); }
+
+private:
+
+	//////////////////////////////
+	/// Enums, Types & Statics ///
+	//////////////////////////////
+
+	typedef unsigned long long BitWord;
+	static constexpr unsigned BITS_PER_WORD = 64;
+	static constexpr unsigned FLAG_COUNT = static_cast<unsigned>(FlagID::COUNT);
+
+	//////////////////
+	/// Operations ///
+	//////////////////
+
+	//Copies the actors flags into the bitsets at the given index
+	void StoreActorFlags(unsigned index, Actor2D_Interface* actor);
+	//Grows the bitsets to match the actor container
+	void SyncWordCount();
+
+	/*
+		Core filter loop. Builds each word from the masked bitsets and calls the function on each set bit index.
+	*/
+	template<class FUNC>
+	size_t RunFilter(FlagMask mask, FUNC&& func);
+
+	////////////
+	/// Data ///
+	////////////
+
+	//Packed flags per flag type (bit position = actor index)
+	std::vector<BitWord> m_FlagSets[FLAG_COUNT];
+	//Tracks what indexes are currently occupied by an actor
+	std::vector<BitWord> m_OccupiedSet;
+
+	//Registered actors (nullptr if free)
+	std::vector<Actor2D_Interface*> m_Actors;
+	//Previously used indexes that can be reused
+	std::vector<unsigned> m_FreeIndexes;
+
+	size_t m_ActorCount = 0;
+};
@@ -2,6 +2,8 @@
 
 #include "Utils/Utils_Debug.h"
 
+#include "Types/BE_Snapshot.h"
+
 #include "Game.h"			//To get unique ID
 
 Actor2D_Interface::Actor2D_Interface()
@@ -9,12 +11,197 @@ Actor2D_Interface::Actor2D_Interface()
 	m_CoreIDs.m_UniqueGameID = Game::GetGame()->RegisterNewGameObject();
 }
 
+Actor2D_Interface::Actor2D_Interface(const Actor2D_Interface& other)
+	:m_Modules(other.m_Modules), m_ModuleArena(other.m_ModuleArena), m_ActorDepth(other.m_ActorDepth),
+	m_Flags(other.m_Flags), m_Signals(other.m_Signals), m_UtilityIDs(other.m_UtilityIDs), m_CoreIDs(other.m_CoreIDs)
+{
+	//Registry data is left as unregistered, as the registry slot belongs to the original
+}
+
+Actor2D_Interface::Actor2D_Interface(Actor2D_Interface&& other) noexcept
+	:m_Modules(std::move(other.m_Modules)), m_ModuleArena(std::move(other.m_ModuleArena)), m_ActorDepth(other.m_ActorDepth),
+	m_Flags(other.m_Flags), m_Signals(other.m_Signals), m_UtilityIDs(other.m_UtilityIDs), m_CoreIDs(other.m_CoreIDs)
+{
+	if (other.m_FlagRegistry)
+		other.m_FlagRegistry->TransferActor(&other, this);
+}
+
+Actor2D_Interface& Actor2D_Interface::operator=(const Actor2D_Interface& other)
+{
+	if (this == &other)
+		return *this;
+
+	m_Modules = other.m_Modules;
+	m_ModuleArena = other.m_ModuleArena;
+	m_ActorDepth = other.m_ActorDepth;
+	m_Flags = other.m_Flags;
+	m_Signals = other.m_Signals;
+	m_UtilityIDs = other.m_UtilityIDs;
+	m_CoreIDs = other.m_CoreIDs;
+
+	//Keep own registration (if any), but mirror the copied flags
+	if (m_FlagRegistry)
+		m_FlagRegistry->SyncActor(this);
+
+	return *this;
+}
+
+Actor2D_Interface& Actor2D_Interface::operator=(Actor2D_Interface&& other) noexcept
+{
+	if (this == &other)
+		return *this;
+
+	m_Modules = std::move(other.m_Modules);
+	m_ModuleArena = std::move(other.m_ModuleArena);
+	m_ActorDepth = other.m_ActorDepth;
+	m_Flags = other.m_Flags;
+	m_Signals = other.m_Signals;
+	m_UtilityIDs = other.m_UtilityIDs;
+	m_CoreIDs = other.m_CoreIDs;
+
+	//Take over the sources registration in place of any current one
+	if (other.m_FlagRegistry)
+	{
+		if (m_FlagRegistry)
+			m_FlagRegistry->UnregisterActor(this);
+		other.m_FlagRegistry->TransferActor(&other, this);
+	}
+	else if (m_FlagRegistry)
+		m_FlagRegistry->SyncActor(this);
+
+	return *this;
+}
+
+void Actor2D_Interface::SaveSnapshot(SnapshotWriter& writer)
+{
+	size_t actorSection = writer.BeginSection(SnapshotWriter::SECTION_ACTOR);
+
+	//Core actor data
+	writer.Write(m_CoreIDs);
+	writer.Write(m_UtilityIDs);
+	writer.Write(m_Flags);
+	writer.Write(m_Signals);
+	writer.Write(m_ActorDepth);
+
+	//Module data, each within its own section
+	uint32_t moduleCount = static_cast<uint32_t>(m_Modules.size());
+	writer.Write(moduleCount);
+	for (auto& a : m_Modules)
+	{
+		size_t moduleSection = writer.BeginSection(static_cast<uint32_t>(a->GetType()));
+		a->SaveSnapshot(writer);
+		writer.EndSection(moduleSection);
+	}
+
+	writer.EndSection(actorSection);
+}
+
+bool Actor2D_Interface::LoadSnapshot(SnapshotReader& reader, bool apply)
+{
+	uint32_t sectionID = 0;
+	size_t actorEnd = 0;
+	if (!reader.BeginSection(sectionID, actorEnd) || sectionID != SnapshotWriter::SECTION_ACTOR)
+	{
+		msg_assert(false, "LoadSnapshot(): Actor section not found!");
+		return false;
+	}
+
+	//Read core data into temporaries, applied once the modules are restored
+	auto coreIDs = m_CoreIDs;
+	auto utilityIDs = m_UtilityIDs;
+	Flags flags;
+	ModuleSignals signals;
+	float actorDepth = 0.f;
+	uint32_t moduleCount = 0;
+
+	bool result = reader.Read(coreIDs) && reader.Read(utilityIDs) && reader.Read(flags) &&
+		reader.Read(signals) && reader.Read(actorDepth) && reader.Read(moduleCount);
+
+	for (uint32_t i(0); result && i < moduleCount; ++i)
+	{
+		size_t moduleEnd = 0;
+		if (!reader.BeginSection(sectionID, moduleEnd))
+		{
+			result = false;
+			break;
+		}
+
+		//Restore modules, matching by index and type
+		if (i < m_Modules.size() && static_cast<uint32_t>(m_Modules[i]->GetType()) == sectionID)
+			result = m_Modules[i]->LoadSnapshot(reader, apply);
+		else if (!apply)
+			DBOUT("Actor2D_Interface::LoadSnapshot(): Module mismatch, skipping module data.");
+
+		//Always move to end of section (skipping anything unread)
+		result = result && reader.SkipTo(moduleEnd);
+	}
+
+	result = result && reader.SkipTo(actorEnd);
+	if (!result)
+	{
+		//Data that passed validation should always apply, so failing here leaves the actor part restored
+		msg_assert(!apply, "LoadSnapshot(): Actor data invalid or truncated!");
+		DBOUT("Actor2D_Interface::LoadSnapshot(): Actor data invalid or truncated!");
+		return false;
+	}
+
+	if (!apply)
+		return true;
+
+	//Apply core data, keeping hold of unique ID (this is assigned per instance)
+	coreIDs.m_UniqueGameID = m_CoreIDs.m_UniqueGameID;
+	m_CoreIDs = coreIDs;
+	m_UtilityIDs = utilityIDs;
+	m_Flags = flags;
+	m_Signals = signals;
+	m_ActorDepth = actorDepth;
+
+	//Mirror restored flags
+	if (m_FlagRegistry)
+		m_FlagRegistry->SyncActor(this);
+
+	return true;
+}
+
 void Actor2D_Interface::ReSyncModules()
 {
 	for (auto& a : m_Modules)
 		a->ReSyncWithActor(this);
 }
 
+void Actor2D_Interface::SetFlag(Actor2D_FlagRegistry::FlagID id, bool state)
+{
+	//Set local flag
+	switch (id)
+	{
+	case Actor2D_FlagRegistry::FlagID::IS_ACTIVE:
+		m_Flags.m_IsActive = state;
+		break;
+	case Actor2D_FlagRegistry::FlagID::CAN_UPDATE:
+		m_Flags.m_CanUpdate = state;
+		break;
+	case Actor2D_FlagRegistry::FlagID::CAN_RENDER:
+		m_Flags.m_CanRender = state;
+		break;
+	case Actor2D_FlagRegistry::FlagID::USE_RENDER_GROUPING:
+		m_Flags.m_UseRenderGrouping = state;
+		break;
+	case Actor2D_FlagRegistry::FlagID::CAN_RUN_ONCE_INIT:
+		m_Flags.m_CanRunOnceInit = state;
+		break;
+	case Actor2D_FlagRegistry::FlagID::CAN_ACCEPT_INPUTS:
+		m_Flags.m_CanAcceptInputs = state;
+		break;
+	default:
+		msg_assert(false, "SetFlag(): Invalid flag ID!");
+		return;
+	}
+
+	//Mirror to registry
+	if (m_FlagRegistry)
+		m_FlagRegistry->SetFlag(m_FlagRegistryIndex, id, state);
+}
+
 void Actor2D_Interface::GetDebugStr_CoreIDs(std::string& str)
 {
 	//Create local string
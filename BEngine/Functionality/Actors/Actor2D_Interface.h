@@ -18,9 +18,15 @@
 
 //Module Includes
 #include "Modules/Module_Interface.h"
+#include "Modules/Module_Arena.h"
+
+//Actor Includes
+#include "Actors/Actor2D_FlagRegistry.h"
 
 //Foward Declarations
 struct System;			//Must define this type (game + target managers) in .cpp files (See Include_SystemTypes.h)
+class SnapshotWriter;
+class SnapshotReader;
 
 //From Box2D library, use in collision callbacks
 class b2Body;
@@ -115,8 +121,20 @@ public:
 	////////////////////
 
 	Actor2D_Interface();
+	/*
+		Copies are not registered with the original's flag registry (if any), so need registering themselves.
+		Moves take over the registration of the source, re-pointing its registry slot at the new actor.
+	*/
+	Actor2D_Interface(const Actor2D_Interface& other);
+	Actor2D_Interface(Actor2D_Interface&& other) noexcept;
+	Actor2D_Interface& operator=(const Actor2D_Interface& other);
+	Actor2D_Interface& operator=(Actor2D_Interface&& other) noexcept;
 	virtual ~Actor2D_Interface()
 	{
+		//Remove self from any flag registry so it doesn't hold a dangling pointer
+		if (m_FlagRegistry)
+			m_FlagRegistry->UnregisterActor(this);
+
 		m_Modules.clear();
 	}
 
@@ -219,6 +237,26 @@ public:
 	*/
 	virtual void HardReset(System& sys) { }
 
+	//
+	//Snapshots
+	//
+
+	/*
+		Writes the actors state (IDs, flags, depth) followed by each modules state into the snapshot, as a single
+		actor section. Derived actors can extend this by calling this first, then writing their own data
+		(ideally within a SECTION_ACTOR_EXTENDED section so it can be skipped if needed).
+	*/
+	virtual void SaveSnapshot(SnapshotWriter& writer);
+	/*
+		Restores state written via SaveSnapshot. Modules are matched by index and type, with any mismatches being
+		skipped. Resources are not stored, so this should be restored onto an actor that is already setup.
+		The actors unique game ID is preserved.
+		Modules apply their state as they are read, so call this with apply false first to check the data
+		without changing anything, then again with apply true from the same read position (see
+		Scene_Demo::LoadSnapshot). Derived actors should do the same with their own data.
+	*/
+	virtual bool LoadSnapshot(SnapshotReader& reader, bool apply);
+
 	//
 	//Utilities
 	//
@@ -247,12 +285,22 @@ public:
 		insert a new module of that type. Args should match target modules constructor(s).
 		Actor2D_Interface pointer is inserted into args list by default (as such each module should have
 		this as its	first parameter).
+		If a module arena is set, the module and its control block are allocated from it in one go (see SetModuleArena).
 	*/
 	template<class MODULE, class... Args>
 	MODULE* AddNewModule(Args&&... args)
 	{
-		//Create new module
-		auto mod = std::make_shared<MODULE>(this, std::forward<Args>(args)...);
+		//Create new module (in arena if one is set)
+		std::shared_ptr<MODULE> mod;
+		if (m_ModuleArena)
+		{
+			mod = std::allocate_shared<MODULE>(ModuleArenaAllocator<MODULE>(m_ModuleArena), this, std::forward<Args>(args)...);
+		}
+		else
+		{
+			mod = std::make_shared<MODULE>(this, std::forward<Args>(args)...);
+			ModuleArena::RecordHeapAllocation();
+		}
 		//Get hold of the pointer
 		MODULE* ptr = mod.get();
 		//Store the module
@@ -318,8 +366,31 @@ public:
 
 	float GetActorDepth() { return m_ActorDepth; }
 
+	unsigned GetRenderGroupIndex() { return m_UtilityIDs.m_RenderGroupIndex; }
+	void SetRenderGroupIndex(unsigned index) { m_UtilityIDs.m_RenderGroupIndex = index; }
+
+	size_t GetModuleCount() { return m_Modules.size(); }
+
+	/*
+		Sets the arena that modules added from here on are allocated from. Can be shared between actors
+		(such as an actor pool) so that all their modules are packed together.
+	*/
+	void SetModuleArena(std::shared_ptr<ModuleArena> arena) { m_ModuleArena = std::move(arena); }
+	//Creates a new arena for this actor alone
+	void CreateModuleArena(size_t blockSize = ModuleArena::DEFAULT_BLOCK_SIZE) { m_ModuleArena = std::make_shared<ModuleArena>(blockSize); }
+	std::shared_ptr<ModuleArena>& GetModuleArena() { return m_ModuleArena; }
+
 	Flags& GetFlags() { return m_Flags; }
 	ModuleSignals& GetSignals() { return m_Signals; }
+
+	/*
+		Sets the given flag, mirroring the change to the flag registry (if registered with one).
+		Flags modified directly via GetFlags() need syncing with the registry manually (see Actor2D_FlagRegistry::SyncActor).
+	*/
+	void SetFlag(Actor2D_FlagRegistry::FlagID id, bool state);
+
+	Actor2D_FlagRegistry* GetFlagRegistry() { return m_FlagRegistry; }
+	unsigned GetFlagRegistryIndex() { return m_FlagRegistryIndex; }
 	//
 	//Modules
 	//
@@ -328,6 +399,11 @@ public:
 
 protected:
 
+	//Registry manages registration data directly
+	friend class Actor2D_FlagRegistry;
+	//Prefab instancing copies actor data directly
+	friend class PrefabLibrary;
+
 	////////////
 	/// Data ///
 	////////////
@@ -337,6 +413,8 @@ protected:
 	//
 
 	std::vector<std::shared_ptr<Module_Interface>> m_Modules;
+	//Optional arena modules are allocated from (see AddNewModule)
+	std::shared_ptr<ModuleArena> m_ModuleArena;
 
 	//
 	//General
@@ -355,6 +433,10 @@ protected:
 	Flags m_Flags;
 	ModuleSignals m_Signals;
 
+	//Registry mirroring this actors flags (if any), and the index the actor holds within it
+	Actor2D_FlagRegistry* m_FlagRegistry = nullptr;
+	unsigned m_FlagRegistryIndex = Actor2D_FlagRegistry::INVALID_INDEX;
+
 	//
 	//IDs and Indexes
 	//
@@ -0,0 +1,295 @@
+#include "AnimationStateMachine.h"
+
+//Utilities
+#include "Utils/Utils_Debug.h"
+#include "Utils/Utils_RapidJSON.h"
+
+//Engine Includes
+#include "Types/BE_SharedTypes.h"
+
+bool AnimationStateMachine::LoadFromFile(const std::string& fp, const SpriteTexture* texture)
+{
+	if (!texture)
+	{
+		msg_assert(false, "LoadFromFile(): No texture given!");
+		return false;
+	}
+
+	Clear();
+
+	rapidjson::Document doc;
+	std::string error;
+	if (!ParseNewJSONDocument(doc, fp, &error))
+	{
+		DBOUT("LoadFromFile(): " << error);
+		return false;
+	}
+
+	if (!doc.HasMember("Conditions") || !doc.HasMember("States") || !doc.HasMember("Transitions"))
+	{
+		msg_assert(false, "LoadFromFile(): Conditions, States or Transitions not found!");
+		return false;
+	}
+
+	//
+	//Conditions
+	//
+
+	const rapidjson::Value& conditions = doc["Conditions"];
+	if (conditions.Size() > MAX_CONDITIONS)
+	{
+		msg_assert(false, "LoadFromFile(): Too many conditions!");
+		return false;
+	}
+
+	//Bits assigned in listed order
+	for (unsigned i(0); i < conditions.Size(); ++i)
+		m_ConditionBits[conditions[i].GetString()] = i;
+
+	m_ConditionCount = conditions.Size();
+	m_ConditionMask = (1u << m_ConditionCount) - 1;
+
+	//
+	//States
+	//
+
+	const rapidjson::Value& states = doc["States"];
+	//Leave room for the unmapped state
+	if (states.Size() == 0 || states.Size() >= INVALID_STATE)
+	{
+		msg_assert(false, "LoadFromFile(): Invalid number of states!");
+		return false;
+	}
+
+	m_States.reserve(states.Size());
+	m_AnimToState.resize(texture->m_Animations.size(), static_cast<StateID>(states.Size()));
+
+	for (unsigned i(0); i < states.Size(); ++i)
+	{
+		State state;
+		state.m_Name = states[i]["Name"].GetString();
+
+		//Animation given by name or index
+		const rapidjson::Value& anim = states[i]["Animation"];
+		state.m_AnimationIndex = -1;
+		if (anim.IsString())
+		{
+			for (unsigned j(0); j < texture->m_Animations.size(); ++j)
+			{
+				if (texture->m_Animations[j].m_Name == anim.GetString())
+				{
+					state.m_AnimationIndex = static_cast<int>(j);
+					break;
+				}
+			}
+		}
+		else
+			state.m_AnimationIndex = anim.GetInt();
+
+		if (state.m_AnimationIndex < 0 || state.m_AnimationIndex >= static_cast<int>(texture->m_Animations.size()))
+		{
+			DBOUT("LoadFromFile(): Animation not found for state: " << state.m_Name);
+			Clear();
+			return false;
+		}
+
+		if (states[i].HasMember("Loop"))
+			state.m_Loop = states[i]["Loop"].GetBool();
+		if (states[i].HasMember("Reverse"))
+			state.m_Reverse = states[i]["Reverse"].GetBool();
+		if (states[i].HasMember("Lock"))
+			state.m_Lock = states[i]["Lock"].GetBool();
+
+		//First state using an animation owns it
+		if (m_AnimToState[state.m_AnimationIndex] == states.Size())
+			m_AnimToState[state.m_AnimationIndex] = static_cast<StateID>(i);
+		else
+			DBOUT("LoadFromFile(): Animation already used by another state, ignoring for lookups: " << state.m_Name);
+
+		m_States.push_back(state);
+	}
+
+	//
+	//Transitions
+	//
+
+	const rapidjson::Value& transitions = doc["Transitions"];
+	std::vector<TransitionDesc> descs;
+	descs.reserve(transitions.Size());
+
+	//Builds mask from array of condition names
+	auto buildMask = [this](const rapidjson::Value& trans, const char* key, ConditionBits& mask)
+	{
+		mask = 0;
+		if (!trans.HasMember(key))
+			return true;
+
+		for (unsigned i(0); i < trans[key].Size(); ++i)
+		{
+			auto it = m_ConditionBits.find(trans[key][i].GetString());
+			if (it == m_ConditionBits.end())
+			{
+				DBOUT("LoadFromFile(): Unknown condition: " << trans[key][i].GetString());
+				return false;
+			}
+			mask |= 1u << it->second;
+		}
+
+		return true;
+	};
+
+	for (unsigned i(0); i < transitions.Size(); ++i)
+	{
+		const rapidjson::Value& trans = transitions[i];
+		TransitionDesc desc;
+
+		std::string from = trans["From"].GetString();
+		std::string to = trans["To"].GetString();
+
+		desc.m_FromAny = from == "Any";
+		if (!desc.m_FromAny)
+			desc.m_From = FindState(from);
+		desc.m_To = FindState(to);
+
+		if ((!desc.m_FromAny && desc.m_From == INVALID_STATE) || desc.m_To == INVALID_STATE)
+		{
+			DBOUT("LoadFromFile(): Unknown state in transition: " << from << " -> " << to);
+			Clear();
+			return false;
+		}
+
+		if (!buildMask(trans, "Require", desc.m_Require) || !buildMask(trans, "Exclude", desc.m_Exclude))
+		{
+			Clear();
+			return false;
+		}
+
+		if (trans.HasMember("Branch"))
+			desc.m_Branch = trans["Branch"].GetBool();
+
+		descs.push_back(desc);
+	}
+
+	CompileTable(descs);
+
+	return true;
+}
+
+void AnimationStateMachine::Clear()
+{
+	m_States.clear();
+	m_Table.clear();
+	m_AnimToState.clear();
+	m_ConditionBits.clear();
+	m_ConditionCount = 0;
+	m_ConditionMask = 0;
+}
+
+void AnimationStateMachine::EvaluateBatch(const StateID* states, const ConditionBits* conditions, Transition* outTransitions, size_t count) const
+{
+	const Transition* table = m_Table.data();
+	const unsigned shift = m_ConditionCount;
+	const ConditionBits mask = m_ConditionMask;
+
+	//Straight table lookups, so nothing to branch on
+	for (size_t i = 0; i < count; ++i)
+		outTransitions[i] = table[(states[i] << shift) | (conditions[i] & mask)];
+}
+
+bool AnimationStateMachine::Apply(SpriteAnimator& animator, ConditionBits conditions) const
+{
+	if (!IsLoaded())
+		return false;
+
+	//Current state is whatever the animator is playing
+	const AnimationData* anim = animator.GetCurrentAnimation();
+	StateID state = anim ? GetStateForAnimation(anim->m_AnimationID) : GetUnmappedState();
+
+	Transition transition = Evaluate(state, conditions);
+	StateID next = GetTransitionState(transition);
+	if (next == state)
+		return false;
+
+	return ApplyState(animator, next, IsBranchTransition(transition));
+}
+
+bool AnimationStateMachine::ApplyState(SpriteAnimator& animator, StateID state, bool branch) const
+{
+	//Branching skips the lock check, so check it here
+	if (animator.GetAnimationLockState())
+		return false;
+
+	const State& desc = m_States[state];
+
+	//Keep the current speed when branching, so the frame timing stays in sync as well
+	bool applied = false;
+	if (branch && animator.GetCurrentAnimation())
+		applied = animator.BranchAnimation(desc.m_AnimationIndex, true, desc.m_Loop, desc.m_Reverse, true);
+	if (!applied)
+		applied = animator.SetAnimation(desc.m_AnimationIndex, true, false, desc.m_Loop, desc.m_Reverse);
+
+	if (applied && desc.m_Lock)
+		animator.EnableAnimationLock();
+
+	return applied;
+}
+
+AnimationStateMachine::ConditionBits AnimationStateMachine::GetConditionMask(const std::string& name) const
+{
+	auto it = m_ConditionBits.find(name);
+	if (it != m_ConditionBits.end())
+		return 1u << it->second;
+
+	return 0;
+}
+
+AnimationStateMachine::StateID AnimationStateMachine::FindState(const std::string& name) const
+{
+	for (unsigned i(0); i < m_States.size(); ++i)
+	{
+		if (m_States[i].m_Name == name)
+			return static_cast<StateID>(i);
+	}
+
+	return INVALID_STATE;
+}
+
+AnimationStateMachine::StateID AnimationStateMachine::GetStateForAnimation(unsigned animIndex) const
+{
+	if (animIndex < m_AnimToState.size())
+		return m_AnimToState[animIndex];
+
+	return GetUnmappedState();
+}
+
+void AnimationStateMachine::CompileTable(const std::vector<TransitionDesc>& transitions)
+{
+	//One row per state, plus the unmapped state
+	const unsigned rowCount = static_cast<unsigned>(m_States.size()) + 1;
+	const unsigned columnCount = 1u << m_ConditionCount;
+	m_Table.resize(static_cast<size_t>(rowCount) * columnCount);
+
+	for (unsigned state(0); state < rowCount; ++state)
+	{
+		for (ConditionBits conditions(0); conditions < columnCount; ++conditions)
+		{
+			//Stay in the current state unless a transition matches
+			Transition entry = static_cast<Transition>(state);
+
+			for (auto& trans : transitions)
+			{
+				bool fromMatch = trans.m_FromAny || trans.m_From == state;
+				bool conditionMatch = (conditions & trans.m_Require) == trans.m_Require && (conditions & trans.m_Exclude) == 0;
+				if (!fromMatch || !conditionMatch)
+					continue;
+
+				//Transitions to the current state are a match, but keep the state as is
+				if (trans.m_To != state)
+					entry = trans.m_To | (trans.m_Branch ? BRANCH_FLAG : 0);
+				break;
+			}
+
+			m_Table[(state << m_ConditionCount) | conditions] = entry;
+		}
+	}
+}
@@ -0,0 +1,167 @@
+//*********************************************************************************\\
+//
+// Data-driven animation state machine, loaded from JSON alongside a textures
+// animation file. States map to animations (with playback settings), with
+// transitions selected by a set of named condition bits.
+//
+// On load, states, transitions and conditions are compiled into a flat table
+// indexed by [state][condition bits], so picking the next state is a single
+// lookup with no branching (and can be done in bulk for large numbers of
+// characters). Transitions are prioritised by the order they are listed in.
+//
+// The current state is taken from the animation an animator is playing, so
+// animations set outside the machine (e.g. from collision events) are picked up
+// without any extra syncing. Branch transitions use BranchAnimation, keeping the
+// frame position between compatible animations (e.g. Jump Left <-> Jump Right).
+//
+//*********************************************************************************\\
+
+#pragma once
+
+//Library Includes
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <unordered_map>
+
+//Forward Declarations
+class SpriteAnimator;
+struct SpriteTexture;
+
+class AnimationStateMachine
+{
+public:
+
+	//////////////////////////////
+	/// Enums, Types & Statics ///
+	//////////////////////////////
+
+	typedef uint16_t StateID;
+	typedef uint32_t ConditionBits;
+	//Table entry, holding the next state (low bits) and branch flag (high bit)
+	typedef uint16_t Transition;
+
+	//Each condition doubles the table size, so keep the number sensible
+	static constexpr unsigned MAX_CONDITIONS = 8;
+	static constexpr Transition STATE_MASK = 0x7FFF;
+	static constexpr Transition BRANCH_FLAG = 0x8000;
+	static constexpr StateID INVALID_STATE = STATE_MASK;
+
+	/*
+		Animation (and how to play it) for a state.
+	*/
+	struct State
+	{
+		std::string m_Name;
+		int m_AnimationIndex = 0;
+		bool m_Loop = true;
+		bool m_Reverse = false;
+		//Lock the animation in until it completes (see SpriteAnimator::EnableAnimationLock)
+		bool m_Lock = false;
+	};
+
+	////////////////////
+	/// Constructors ///
+	////////////////////
+
+	AnimationStateMachine() { }
+	~AnimationStateMachine() { }
+
+	//////////////////
+	/// Operations ///
+	//////////////////
+
+	//
+	//Loading
+	//
+
+	/*
+		Loads and compiles state machine from file. Animations can be given by name or index, with names
+		looked up in the given texture (which is also used to map animations back to states).
+	*/
+	bool LoadFromFile(const std::string& fp, const SpriteTexture* texture);
+	void Clear();
+
+	//
+	//Evaluation
+	//
+
+	//Gets transition for the state and conditions (entry state is the current state if nothing changes)
+	Transition Evaluate(StateID state, ConditionBits conditions) const { return m_Table[(state << m_ConditionCount) | (conditions & m_ConditionMask)]; }
+
+	/*
+		Evaluates transitions for arrays of states and conditions. Only entries where the state differs from the
+		current state need applying.
+	*/
+	void EvaluateBatch(const StateID* states, const ConditionBits* conditions, Transition* outTransitions, size_t count) const;
+
+	/*
+		Works out the state from the animators current animation, then evaluates and applies any transition.
+		Returns true if the animation was changed.
+	*/
+	bool Apply(SpriteAnimator& animator, ConditionBits conditions) const;
+	/*
+		Sets the animation for a state, branching from the current animation if requested (falling back to setting
+		it normally if the branch isn't possible). Fails if the animator is locked in.
+	*/
+	bool ApplyState(SpriteAnimator& animator, StateID state, bool branch) const;
+
+	/////////////////
+	/// Accessors ///
+	/////////////////
+
+	static StateID GetTransitionState(Transition transition) { return transition & STATE_MASK; }
+	static bool IsBranchTransition(Transition transition)	 { return (transition & BRANCH_FLAG) != 0; }
+
+	//Gets bit for named condition (0 if not found, so missing conditions are always false)
+	ConditionBits GetConditionMask(const std::string& name) const;
+
+	StateID FindState(const std::string& name) const;
+	//Gets state for animation index (or the unmapped state if no state plays it)
+	StateID GetStateForAnimation(unsigned animIndex) const;
+	//State used for animations not in the machine (only "Any" transitions apply to it)
+	StateID GetUnmappedState() const					 { return static_cast<StateID>(m_States.size()); }
+	const State& GetState(StateID id) const				 { return m_States[id]; }
+
+	size_t GetStateCount() const						 { return m_States.size(); }
+	unsigned GetConditionCount() const					 { return m_ConditionCount; }
+	bool IsLoaded() const								 { return !m_Table.empty(); }
+
+private:
+
+	//////////////////////////////
+	/// Enums, Types & Statics ///
+	//////////////////////////////
+
+	//Transition as loaded (prior to compiling)
+	struct TransitionDesc
+	{
+		StateID m_From = INVALID_STATE;
+		StateID m_To = INVALID_STATE;
+		ConditionBits m_Require = 0;
+		ConditionBits m_Exclude = 0;
+		bool m_Branch = false;
+		bool m_FromAny = false;
+	};
+
+	//////////////////
+	/// Operations ///
+	//////////////////
+
+	//Builds table from transitions (first matching transition for each state and set of conditions wins)
+	void CompileTable(const std::vector<TransitionDesc>& transitions);
+
+	////////////
+	/// Data ///
+	////////////
+
+	std::vector<State> m_States;
+	//Compiled transitions ([state][conditions], with an extra row for the unmapped state)
+	std::vector<Transition> m_Table;
+	//Animation index to state
+	std::vector<StateID> m_AnimToState;
+
+	std::unordered_map<std::string, unsigned> m_ConditionBits;
+	unsigned m_ConditionCount = 0;
+	ConditionBits m_ConditionMask = 0;
+};
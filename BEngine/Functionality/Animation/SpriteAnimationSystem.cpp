@@ -0,0 +1,384 @@
+#include "SpriteAnimationSystem.h"
+
+#include "Utils/Utils_Debug.h"
+
+//Engine Includes
+#include "Types/BE_SharedTypes.h"
+
+#include <cmath>
+
+//Moves last element into index and pops back
+template<class T>
+static inline void SwapAndPop(std::vector<T>& vec, unsigned index)
+{
+	vec[index] = vec.back();
+	vec.pop_back();
+}
+
+SpriteAnimationSystem::AnimatorID SpriteAnimationSystem::AddAnimator(SpriteData* sprite)
+{
+	msg_assert(sprite, "AddAnimator(): Null sprite given!");
+
+	unsigned index = static_cast<unsigned>(m_Sprites.size());
+
+	//Reuse free IDs first
+	AnimatorID id = INVALID_ID;
+	if (!m_FreeIDs.empty())
+	{
+		id = m_FreeIDs.back();
+		m_FreeIDs.pop_back();
+		m_IDToIndex[id] = index;
+	}
+	else
+	{
+		id = static_cast<AnimatorID>(m_IDToIndex.size());
+		m_IDToIndex.push_back(index);
+	}
+	m_IndexToID.push_back(id);
+
+	//Default state (no animation, not playing)
+	m_Elapsed.push_back(0.f);
+	m_FrameDurations.push_back(1.f);
+	m_Frames.push_back(0);
+	m_Reversed.push_back(0);
+	m_Playing.push_back(0);
+	m_Looping.push_back(0);
+	m_Locked.push_back(0);
+	m_Advances.push_back(0);
+
+	m_Sprites.push_back(sprite);
+	m_Animations.push_back(nullptr);
+	m_Speeds.push_back(1.f);
+	m_SpeedMods.push_back(1.f);
+	m_TextureFrames.push_back(0);
+
+	return id;
+}
+
+void SpriteAnimationSystem::RemoveAnimator(AnimatorID id)
+{
+	if (!IsValidID(id))
+	{
+		msg_assert(false, "RemoveAnimator(): Invalid ID!");
+		return;
+	}
+
+	unsigned index = m_IDToIndex[id];
+
+	//Last animator takes this ones place, so update its mapping
+	AnimatorID lastID = m_IndexToID.back();
+	m_IDToIndex[lastID] = index;
+
+	SwapAndPop(m_Elapsed, index);
+	SwapAndPop(m_FrameDurations, index);
+	SwapAndPop(m_Frames, index);
+	SwapAndPop(m_Reversed, index);
+	SwapAndPop(m_Playing, index);
+	SwapAndPop(m_Looping, index);
+	SwapAndPop(m_Locked, index);
+	SwapAndPop(m_Advances, index);
+	SwapAndPop(m_Sprites, index);
+	SwapAndPop(m_Animations, index);
+	SwapAndPop(m_Speeds, index);
+	SwapAndPop(m_SpeedMods, index);
+	SwapAndPop(m_TextureFrames, index);
+	SwapAndPop(m_IndexToID, index);
+
+	m_IDToIndex[id] = INVALID_ID;
+	m_FreeIDs.push_back(id);
+}
+
+void SpriteAnimationSystem::Clear()
+{
+	m_Elapsed.clear();
+	m_FrameDurations.clear();
+	m_Frames.clear();
+	m_Reversed.clear();
+	m_Playing.clear();
+	m_Looping.clear();
+	m_Locked.clear();
+	m_Advances.clear();
+	m_Sprites.clear();
+	m_Animations.clear();
+	m_Speeds.clear();
+	m_SpeedMods.clear();
+	m_TextureFrames.clear();
+	m_IDToIndex.clear();
+	m_IndexToID.clear();
+	m_FreeIDs.clear();
+
+	m_ChangedCount = 0;
+}
+
+void SpriteAnimationSystem::Reserve(size_t count)
+{
+	m_Elapsed.reserve(count);
+	m_FrameDurations.reserve(count);
+	m_Frames.reserve(count);
+	m_Reversed.reserve(count);
+	m_Playing.reserve(count);
+	m_Looping.reserve(count);
+	m_Locked.reserve(count);
+	m_Advances.reserve(count);
+	m_Sprites.reserve(count);
+	m_Animations.reserve(count);
+	m_Speeds.reserve(count);
+	m_SpeedMods.reserve(count);
+	m_TextureFrames.reserve(count);
+	m_IDToIndex.reserve(count);
+	m_IndexToID.reserve(count);
+}
+
+void SpriteAnimationSystem::Update(float dTime)
+{
+	const size_t count = m_Frames.size();
+
+	//Raw pointers so the compiler doesn't need to worry about vector internals
+	float* elapsed = m_Elapsed.data();
+	const float* durations = m_FrameDurations.data();
+	const int32_t* playing = m_Playing.data();
+	int32_t* advances = m_Advances.data();
+
+	/*
+		Accumulate time and work out how many whole frames each animator has passed, carrying the remainder.
+		Everything is done with selects rather than branches so this can be vectorised, with stopped animators
+		simply not accumulating time.
+	*/
+	for (size_t i = 0; i < count; ++i)
+	{
+		float time = elapsed[i] + (playing[i] ? dTime : 0.f);
+		float frames = time / durations[i];
+		frames = frames < MAX_FRAME_ADVANCE ? frames : MAX_FRAME_ADVANCE;
+
+		int32_t advance = playing[i] ? static_cast<int32_t>(frames) : 0;
+		elapsed[i] = time - static_cast<float>(advance) * durations[i];
+		advances[i] = advance;
+	}
+
+	//Step frames (and write them out) only for animators that advanced
+	m_ChangedCount = 0;
+	for (unsigned i(0); i < count; ++i)
+	{
+		if (advances[i] == 0)
+			continue;
+
+		int relativeFrame = m_Frames[i];
+		if (!m_Animations[i]->StepRelativeFrame(relativeFrame, advances[i], m_Looping[i] != 0, m_Reversed[i] != 0))
+		{
+			//Animation ended
+			m_Playing[i] = 0;
+			m_Locked[i] = 0;
+			m_Elapsed[i] = 0.f;
+		}
+
+		if (relativeFrame != m_Frames[i])
+		{
+			m_Frames[i] = relativeFrame;
+			WriteFrame(i);
+			++m_ChangedCount;
+		}
+	}
+}
+
+void SpriteAnimationSystem::SetAnimationTime(AnimatorID id, float time)
+{
+	unsigned index = GetIndex(id);
+	const AnimationData* anim = m_Animations[index];
+	if (!anim)
+		return;
+
+	if (time < 0.f)
+		time = 0.f;
+
+	//Step from the start of the animation to the given time
+	int relativeFrame = m_Reversed[index] ? anim->GetFrameCount() - 1 : 0;
+	long long frames = static_cast<long long>(time / m_FrameDurations[index]);
+	if (anim->StepRelativeFrame(relativeFrame, frames, m_Looping[index] != 0, m_Reversed[index] != 0))
+	{
+		m_Elapsed[index] = std::fmod(time, m_FrameDurations[index]);
+	}
+	else
+	{
+		m_Playing[index] = 0;
+		m_Locked[index] = 0;
+		m_Elapsed[index] = 0.f;
+	}
+
+	m_Frames[index] = relativeFrame;
+	WriteFrame(index);
+}
+
+int SpriteAnimationSystem::SampleFrame(AnimatorID id, float time)
+{
+	unsigned index = GetIndex(id);
+	const AnimationData* anim = m_Animations[index];
+	if (!anim)
+		return m_TextureFrames[index];
+
+	int relativeFrame = anim->SampleRelativeFrame(time, m_FrameDurations[index], m_Looping[index] != 0, m_Reversed[index] != 0);
+	return anim->GetTextureFrame(relativeFrame);
+}
+
+bool SpriteAnimationSystem::SetAnimation(AnimatorID id, int animIndex, bool play, bool restartIfPlaying, bool loop, bool reverse)
+{
+	unsigned index = GetIndex(id);
+	SpriteData* spr = m_Sprites[index];
+
+	//Textures still streaming in have no animations yet (see TextureStreamer::Request), so wait for them to be resident
+	if (spr->m_Texture && spr->m_Texture->m_Animations.empty())
+	{
+		DBOUT("SetAnimation(): Texture has no animations (still streaming?): " << spr->m_Texture->m_Name);
+		return false;
+	}
+
+	//Check index validity
+	bool isValid = spr->m_Texture && animIndex >= 0 && animIndex < static_cast<int>(spr->m_Texture->m_Animations.size());
+	if (!isValid)
+	{
+		msg_assert(false, "SetAnimation(): Index invalid!");
+		return false;
+	}
+
+	//Locked animations must finish first, and already playing animations are only restarted if requested
+	const AnimationData* anim = &spr->m_Texture->m_Animations[animIndex];
+	if (m_Locked[index] || (m_Animations[index] == anim && !restartIfPlaying))
+		return false;
+
+	if (anim->GetFrameCount() <= 0)
+	{
+		msg_assert(false, "SetAnimation(): Animation has no frames!");
+		return false;
+	}
+
+	m_Animations[index] = anim;
+	m_Looping[index] = loop;
+	m_Reversed[index] = reverse;
+
+	RestartAnimation(id, play);
+
+	return true;
+}
+
+void SpriteAnimationSystem::RestartAnimation(AnimatorID id, bool play)
+{
+	unsigned index = GetIndex(id);
+
+	const AnimationData* anim = m_Animations[index];
+
+	m_Frames[index] = (m_Reversed[index] && anim) ? anim->GetFrameCount() - 1 : 0;
+	m_Elapsed[index] = 0.f;
+	m_Playing[index] = play && anim;
+
+	if (anim)
+	{
+		//Speed is read from the animation each time it's applied, so reloaded FPS values are picked up
+		m_Speeds[index] = anim->m_Speed;
+		UpdateFrameDuration(index);
+		WriteFrame(index);
+	}
+}
+
+void SpriteAnimationSystem::SetRelativeFrame(AnimatorID id, int relativeFrame)
+{
+	unsigned index = GetIndex(id);
+
+	const AnimationData* anim = m_Animations[index];
+	if (!anim || relativeFrame < 0 || relativeFrame >= anim->GetFrameCount())
+	{
+		msg_assert(false, "SetRelativeFrame(): No animation set, or frame OOR!");
+		return;
+	}
+
+	m_Frames[index] = relativeFrame;
+	m_Elapsed[index] = 0.f;
+	WriteFrame(index);
+}
+
+void SpriteAnimationSystem::SetPlay(AnimatorID id, bool play)
+{
+	//Can't play without an animation
+	unsigned index = GetIndex(id);
+	m_Playing[index] = play && m_Animations[index];
+}
+
+void SpriteAnimationSystem::SetLoop(AnimatorID id, bool loop)
+{
+	m_Looping[GetIndex(id)] = loop;
+}
+
+void SpriteAnimationSystem::SetReverse(AnimatorID id, bool reverse)
+{
+	m_Reversed[GetIndex(id)] = reverse;
+}
+
+void SpriteAnimationSystem::SetSpeed(AnimatorID id, float speed)
+{
+	unsigned index = GetIndex(id);
+	m_Speeds[index] = speed;
+	UpdateFrameDuration(index);
+}
+
+void SpriteAnimationSystem::SetAnimationSpeedMod(AnimatorID id, float modSpeed)
+{
+	unsigned index = GetIndex(id);
+	m_SpeedMods[index] = modSpeed;
+	UpdateFrameDuration(index);
+}
+
+void SpriteAnimationSystem::EnableAnimationLock(AnimatorID id)
+{
+	unsigned index = GetIndex(id);
+	m_Locked[index] = 1;
+	m_Looping[index] = 0;
+}
+
+void SpriteAnimationSystem::DisableAnimationLock(AnimatorID id, bool loop)
+{
+	unsigned index = GetIndex(id);
+	m_Locked[index] = 0;
+	m_Looping[index] = loop;
+}
+
+bool SpriteAnimationSystem::GetPlayState(AnimatorID id)
+{
+	return m_Playing[GetIndex(id)] != 0;
+}
+
+bool SpriteAnimationSystem::GetAnimationLockState(AnimatorID id)
+{
+	return m_Locked[GetIndex(id)] != 0;
+}
+
+int SpriteAnimationSystem::GetRelativeCurrentFrame(AnimatorID id)
+{
+	return m_Frames[GetIndex(id)];
+}
+
+int SpriteAnimationSystem::GetFrame(AnimatorID id)
+{
+	return m_TextureFrames[GetIndex(id)];
+}
+
+const AnimationData* SpriteAnimationSystem::GetCurrentAnimation(AnimatorID id)
+{
+	return m_Animations[GetIndex(id)];
+}
+
+unsigned SpriteAnimationSystem::GetIndex(AnimatorID id)
+{
+	msg_assert(IsValidID(id), "GetIndex(): Invalid animator ID!");
+	return m_IDToIndex[id];
+}
+
+void SpriteAnimationSystem::UpdateFrameDuration(unsigned index)
+{
+	//Calculate current frame duration (in terms of Frames Per Second, modified by speed multiplier)
+	m_FrameDurations[index] = 1.f / (m_Speeds[index] * m_SpeedMods[index]);
+}
+
+void SpriteAnimationSystem::WriteFrame(unsigned index)
+{
+	int32_t texFrame = m_Animations[index]->GetTextureFrame(m_Frames[index]);
+	m_TextureFrames[index] = texFrame;
+	m_Sprites[index]->SetFrame(texFrame);
+}
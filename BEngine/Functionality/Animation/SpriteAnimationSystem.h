@@ -0,0 +1,194 @@
+//*********************************************************************************\\
+//
+// Batched alternative to per-actor SpriteAnimators, for large numbers of animated
+// sprites. Animator state is stored as contiguous arrays (structure of arrays),
+// with time for every animator accumulated in a single branch-free loop over
+// those arrays (carrying remainders, and catching up several frames if needed).
+//
+// Frames are tracked relative to the start of their animation, so linear and
+// non-linear animations step the same way. Only animators that advanced are then
+// stepped, with frames resolved and written to the sprite if they changed.
+//
+// Playback behaviour mirrors SpriteAnimator (speed, speed mod, loop, reverse and
+// animation locks).
+//
+//*********************************************************************************\\
+
+#pragma once
+
+//Library Includes
+#include <vector>
+#include <cstdint>
+
+//Forward Declarations
+class SpriteData;
+struct AnimationData;
+
+class SpriteAnimationSystem
+{
+public:
+
+	//////////////////////////////
+	/// Enums, Types & Statics ///
+	//////////////////////////////
+
+	//Stable handle for an animator (remains valid as other animators are removed)
+	typedef unsigned AnimatorID;
+	static constexpr AnimatorID INVALID_ID = 0xFFFFFFFF;
+
+	//Cap on frames advanced in a single update (keeps float to int conversion in range)
+	static constexpr float MAX_FRAME_ADVANCE = 1048576.f;
+
+	////////////////////
+	/// Constructors ///
+	////////////////////
+
+	SpriteAnimationSystem() { }
+	SpriteAnimationSystem(size_t reserveCount) { Reserve(reserveCount); }
+	~SpriteAnimationSystem() { }
+
+	//////////////////
+	/// Operations ///
+	//////////////////
+
+	//
+	//Animators
+	//
+
+	//Adds new animator for the given sprite (sprite must have its texture set before setting animations)
+	AnimatorID AddAnimator(SpriteData* sprite);
+	//Removes animator, moving the last animator into its place to keep storage contiguous
+	void RemoveAnimator(AnimatorID id);
+	//Removes all animators
+	void Clear();
+
+	void Reserve(size_t count);
+
+	//
+	//Updates
+	//
+
+	/*
+		Advances all playing animators, then writes out frames for those that changed.
+	*/
+	void Update(float dTime);
+
+	/*
+		Moves animator to the state at an absolute time since its animation started, as if updated all the way there.
+		Allows animators to be removed from updates (e.g. while off-screen) and resynced when needed.
+	*/
+	void SetAnimationTime(AnimatorID id, float time);
+	//Evaluates texture frame at an absolute time since the animation started (doesn't modify state)
+	int SampleFrame(AnimatorID id, float time);
+
+	/////////////////
+	/// Accessors ///
+	/////////////////
+
+	//
+	//Animation Control
+	//
+
+	/*
+		Sets/Resets an animation from the sprites texture. Fails if the index is invalid, the animator is locked,
+		or the animation is already playing (unless restartIfPlaying is set).
+	*/
+	bool SetAnimation(AnimatorID id, int animIndex, bool play, bool restartIfPlaying = false, bool loop = true, bool reverse = false);
+	//Restarts current animation from its first frame (or last if reversed), re-reading its speed
+	void RestartAnimation(AnimatorID id, bool play);
+	//Sets frame relative to the start of the current animation (resetting elapsed time)
+	void SetRelativeFrame(AnimatorID id, int relativeFrame);
+
+	void SetPlay(AnimatorID id, bool play);
+	void SetLoop(AnimatorID id, bool loop);
+	//Reversing keeps the current frame, and changes the direction from here
+	void SetReverse(AnimatorID id, bool reverse);
+	void SetSpeed(AnimatorID id, float speed);
+	//Animation speed works via multiplication (e.g. 2.f = 2x Slower AnimSpeed, 0.5f = 2x Faster AnimSpeed)
+	void SetAnimationSpeedMod(AnimatorID id, float modSpeed);
+
+	//Locks current animation cycle, disabling loop, so that it must finish before changes are allowed
+	void EnableAnimationLock(AnimatorID id);
+	void DisableAnimationLock(AnimatorID id, bool loop = false);
+
+	//
+	//State
+	//
+
+	bool GetPlayState(AnimatorID id);
+	bool GetAnimationLockState(AnimatorID id);
+	//Gets frame relative to the start of the current animation
+	int GetRelativeCurrentFrame(AnimatorID id);
+	//Gets current texture frame
+	int GetFrame(AnimatorID id);
+	const AnimationData* GetCurrentAnimation(AnimatorID id);
+
+	//
+	//General
+	//
+
+	bool IsValidID(AnimatorID id) { return id < m_IDToIndex.size() && m_IDToIndex[id] != INVALID_ID; }
+	size_t GetAnimatorCount() { return m_Sprites.size(); }
+	//Number of animators whose frame changed in the last update
+	size_t GetChangedCount() { return m_ChangedCount; }
+
+	/*
+		Texture frame for each animator, in storage order. Useful for consumers that read frames directly (such as
+		instanced rendering) rather than through sprites.
+	*/
+	const std::vector<int32_t>& GetTextureFrames() { return m_TextureFrames; }
+
+private:
+
+	//////////////////
+	/// Operations ///
+	//////////////////
+
+	//Returns storage index for ID
+	unsigned GetIndex(AnimatorID id);
+	//Recalculates cached frame duration from speed values
+	void UpdateFrameDuration(unsigned index);
+	//Resolves relative frame to texture frame, storing and setting it with the sprite
+	void WriteFrame(unsigned index);
+
+	////////////
+	/// Data ///
+	////////////
+
+	//
+	//Hot Data (updated every frame)
+	//
+
+	std::vector<float> m_Elapsed;
+	//Cached 1 / (speed * speed mod)
+	std::vector<float> m_FrameDurations;
+	//Current frame, relative to start of animation
+	std::vector<int32_t> m_Frames;
+	//Flags kept in separate arrays (as 0/1) to keep the update loop branch free
+	std::vector<int32_t> m_Playing;
+	std::vector<int32_t> m_Looping;
+	std::vector<int32_t> m_Reversed;
+	std::vector<int32_t> m_Locked;
+	//Frames passed by each animator in the current update
+	std::vector<int32_t> m_Advances;
+
+	//
+	//Cold Data (used for frame resolution and control)
+	//
+
+	std::vector<SpriteData*> m_Sprites;
+	std::vector<const AnimationData*> m_Animations;
+	std::vector<float> m_Speeds;
+	std::vector<float> m_SpeedMods;
+	std::vector<int32_t> m_TextureFrames;
+
+	//
+	//ID Mapping
+	//
+
+	std::vector<unsigned> m_IDToIndex;
+	std::vector<AnimatorID> m_IndexToID;
+	std::vector<AnimatorID> m_FreeIDs;
+
+	size_t m_ChangedCount = 0;
+};
@@ -0,0 +1,178 @@
+#include "AssetPack.h"
+
+//Library Includes
+#include <cstring>
+#include <cctype>
+#include <algorithm>
+#include <filesystem>
+
+//Utilities
+#include "Utils/Utils_Debug.h"
+
+//Engine Includes
+#include "IO/BlockCompressor.h"
+
+static_assert(sizeof(AssetPack::Header) == 40, "AssetPack header size mismatch!");
+static_assert(sizeof(AssetPack::IndexRecord) == 40, "AssetPack index record size mismatch!");
+
+//Mounted packs, most recently mounted last
+static std::vector<std::unique_ptr<AssetPack>> s_MountedPacks;
+
+bool AssetPack::Open(const std::string& fp)
+{
+	Close();
+
+	if (!m_File.Open(fp) || m_File.GetSize() < sizeof(Header))
+	{
+		DBOUT("Open(): Failed to open asset pack: " << fp);
+		m_File.Close();
+		return false;
+	}
+
+	const unsigned char* base = m_File.GetData();
+	const uint64_t size = m_File.GetSize();
+	const Header& header = *reinterpret_cast<const Header*>(base);
+
+	//Check pack was written by this version
+	if (header.m_Magic != MAGIC || header.m_Version != VERSION)
+	{
+		DBOUT("Open(): Asset pack is from a different version, ignoring: " << fp);
+		m_File.Close();
+		return false;
+	}
+
+	//Check the index, paths and every entry fit in the file
+	bool valid = (header.m_IndexOffset & 7u) == 0 &&
+		header.m_IndexOffset + static_cast<uint64_t>(header.m_EntryCount) * sizeof(IndexRecord) <= size &&
+		header.m_PathsOffset + header.m_PathsSize <= size;
+	const IndexRecord* index = reinterpret_cast<const IndexRecord*>(base + header.m_IndexOffset);
+	for (uint32_t i(0); valid && i < header.m_EntryCount; ++i)
+	{
+		const IndexRecord& record = index[i];
+		valid = record.m_PathOffset + static_cast<uint64_t>(record.m_PathLength) <= header.m_PathsSize &&
+			record.m_DataOffset <= size && record.m_StoredSize <= size - record.m_DataOffset &&
+			((record.m_Flags & COMPRESSED) || record.m_StoredSize == record.m_Size);
+	}
+	if (!valid)
+	{
+		DBOUT("Open(): Asset pack is truncated or corrupt, ignoring: " << fp);
+		m_File.Close();
+		return false;
+	}
+
+	m_Filepath = fp;
+	m_Header = &header;
+	m_Index = index;
+	m_Paths = reinterpret_cast<const char*>(base + header.m_PathsOffset);
+	m_Decompressed.clear();
+	m_Decompressed.resize(header.m_EntryCount);
+
+	return true;
+}
+
+void AssetPack::Close()
+{
+	std::lock_guard<std::mutex> lock(m_DecompressMutex);
+	m_Decompressed.clear();
+	m_Header = nullptr;
+	m_Index = nullptr;
+	m_Paths = nullptr;
+	m_Filepath.clear();
+	m_File.Close();
+}
+
+bool AssetPack::Find(const std::string& fp, View& outView)
+{
+	const IndexRecord* record = FindRecord(NormalisePath(fp));
+	if (!record)
+		return false;
+
+	//Uncompressed entries are viewed in place
+	if (!(record->m_Flags & COMPRESSED))
+	{
+		outView.m_Data = m_File.GetData() + record->m_DataOffset;
+		outView.m_Size = static_cast<size_t>(record->m_Size);
+		return true;
+	}
+
+	//Compressed entries are decompressed once, then kept
+	std::lock_guard<std::mutex> lock(m_DecompressMutex);
+	std::unique_ptr<std::vector<uint8_t>>& data = m_Decompressed[record - m_Index];
+	if (!data)
+	{
+		std::unique_ptr<std::vector<uint8_t>> decompressed = std::make_unique<std::vector<uint8_t>>(static_cast<size_t>(record->m_Size));
+		if (!BlockCompressor::Decompress(m_File.GetData() + record->m_DataOffset, static_cast<size_t>(record->m_StoredSize), decompressed->data(), decompressed->size()))
+		{
+			DBOUT("Find(): Failed to decompress asset pack entry: " << fp);
+			return false;
+		}
+		data = std::move(decompressed);
+	}
+
+	outView.m_Data = data->data();
+	outView.m_Size = data->size();
+	return true;
+}
+
+std::string AssetPack::NormalisePath(const std::string& fp)
+{
+	std::string path = fp;
+	for (char& c : path)
+		c = c == '\\' ? '/' : static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+
+	return std::filesystem::path(path).lexically_normal().generic_string();
+}
+
+bool AssetPack::Mount(const std::string& fp)
+{
+	std::unique_ptr<AssetPack> pack = std::make_unique<AssetPack>();
+	if (!pack->Open(fp))
+		return false;
+
+	DBOUT("Mount(): Mounted asset pack (" << pack->GetEntryCount() << " entries): " << fp);
+	s_MountedPacks.push_back(std::move(pack));
+	return true;
+}
+
+void AssetPack::UnmountAll()
+{
+	s_MountedPacks.clear();
+}
+
+bool AssetPack::FindMounted(const std::string& fp, View& outView)
+{
+	for (auto it = s_MountedPacks.rbegin(); it != s_MountedPacks.rend(); ++it)
+	{
+		if ((*it)->Find(fp, outView))
+			return true;
+	}
+	return false;
+}
+
+bool AssetPack::HasMounted()
+{
+	return !s_MountedPacks.empty();
+}
+
+std::string AssetPack::GetEntryPath(uint32_t index) const
+{
+	msg_assert(index < GetEntryCount(), "GetEntryPath(): Index OOR!");
+	return std::string(m_Paths + m_Index[index].m_PathOffset, m_Index[index].m_PathLength);
+}
+
+const AssetPack::IndexRecord* AssetPack::FindRecord(const std::string& normalisedFP) const
+{
+	if (!m_Header)
+		return nullptr;
+
+	//Binary search of the sorted index
+	const IndexRecord* end = m_Index + m_Header->m_EntryCount;
+	const IndexRecord* it = std::lower_bound(m_Index, end, normalisedFP, [this](const IndexRecord& record, const std::string& fp)
+	{
+		return fp.compare(0, std::string::npos, m_Paths + record.m_PathOffset, record.m_PathLength) > 0;
+	});
+	if (it == end || normalisedFP.compare(0, std::string::npos, m_Paths + it->m_PathOffset, it->m_PathLength) != 0)
+		return nullptr;
+
+	return it;
+}
@@ -0,0 +1,158 @@
+//*********************************************************************************\\
+//
+// Single file archive of assets (textures, frame/animation JSON, fonts, configs),
+// built offline by AssetPacker. Opened by memory mapping the whole archive, with
+// entries found by binary search of an index sorted by path, and served as views
+// straight into the mapping (no copy, entry data is aligned). Compressed entries
+// (see BlockCompressor) are decompressed on first use and kept for the life of the
+// pack.
+//
+// Packs are mounted globally (see Mount), and the file loaders (texture, font and
+// JSON) check mounted packs before opening loose files, so assets load from a
+// pack under the same filepaths the manifests already use.
+//
+// Layout is little-endian: a header, the index records (sorted by path), the
+// path strings, then the entry data, each entry starting on the packs alignment.
+// Bump the version when changing the layout, and repack.
+//
+//*********************************************************************************\\
+
+#pragma once
+
+//Library Includes
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <cstdint>
+
+//Engine Includes
+#include "IO/MappedFile.h"
+
+class AssetPack
+{
+public:
+
+	//////////////////////////////
+	/// Enums, Types & Statics ///
+	//////////////////////////////
+
+	static constexpr uint32_t MAGIC = 0x4B504542;	//"BEPK"
+	static constexpr uint16_t VERSION = 1;
+
+	struct Header
+	{
+		uint32_t m_Magic;
+		uint16_t m_Version;
+		uint16_t m_Reserved;
+		uint32_t m_EntryCount;
+		//Alignment of each entries data (power of 2)
+		uint32_t m_Alignment;
+		//Section offsets (from the start of the file)
+		uint64_t m_IndexOffset;
+		uint64_t m_PathsOffset;
+		uint64_t m_PathsSize;
+	};
+
+	enum IndexFlags : uint32_t
+	{
+		//Stored as BlockCompressor blocks
+		COMPRESSED = 1 << 0
+	};
+
+	struct IndexRecord
+	{
+		uint64_t m_DataOffset;
+		//Bytes stored in the pack, and once decompressed (equal if not compressed)
+		uint64_t m_StoredSize;
+		uint64_t m_Size;
+		//Path location in the paths section (normalised, see NormalisePath, not null terminated)
+		uint32_t m_PathOffset;
+		uint32_t m_PathLength;
+		uint32_t m_Flags;
+		uint32_t m_Reserved;
+	};
+
+	//Read-only view of an entries data (valid while the pack stays open)
+	struct View
+	{
+		const uint8_t* m_Data = nullptr;
+		size_t m_Size = 0;
+	};
+
+	////////////////////
+	/// Constructors ///
+	////////////////////
+
+	AssetPack() { }
+	~AssetPack() { }
+
+	//Views point into the mapping, so not copyable
+	AssetPack(const AssetPack&) = delete;
+	AssetPack& operator=(const AssetPack&) = delete;
+
+	//////////////////
+	/// Operations ///
+	//////////////////
+
+	//Maps and validates the pack at path (closing any open pack first), returning false if it can't be used
+	bool Open(const std::string& fp);
+	//Closes the pack (any views into it are invalid after this)
+	void Close();
+
+	/*
+		Finds the entry with the given path, returning false if there is none (or it fails to decompress). Safe to call
+		from several threads at once.
+	*/
+	bool Find(const std::string& fp, View& outView);
+
+	//Normalises a path for lookup (forward slashes, lower case, no "." or redundant ".." parts)
+	static std::string NormalisePath(const std::string& fp);
+
+	//
+	//Mounted Packs
+	//
+
+	/*
+		Opens and mounts a pack, searched by FindMounted before packs mounted earlier. Mount and unmount only while
+		nothing is loading (lookups don't lock the mounted list).
+	*/
+	static bool Mount(const std::string& fp);
+	static void UnmountAll();
+	//Finds the path in the mounted packs (false if none have it, so the loader can fall back to the loose file)
+	static bool FindMounted(const std::string& fp, View& outView);
+	static bool HasMounted();
+
+	/////////////////
+	/// Accessors ///
+	/////////////////
+
+	bool IsOpen() const { return m_File.IsOpen(); }
+	const std::string& GetFilepath() const { return m_Filepath; }
+	uint32_t GetEntryCount() const { return m_Header ? m_Header->m_EntryCount : 0; }
+	//Path of the entry at index (in index order)
+	std::string GetEntryPath(uint32_t index) const;
+
+private:
+
+	//////////////////
+	/// Operations ///
+	//////////////////
+
+	//Index record of the normalised path (nullptr if none)
+	const IndexRecord* FindRecord(const std::string& normalisedFP) const;
+
+	////////////
+	/// Data ///
+	////////////
+
+	std::string m_Filepath;
+	MappedFile m_File;
+	const Header* m_Header = nullptr;
+	const IndexRecord* m_Index = nullptr;
+	const char* m_Paths = nullptr;
+
+	//Decompressed entries by index record (filled on first use, guarded by mutex)
+	std::vector<std::unique_ptr<std::vector<uint8_t>>> m_Decompressed;
+	std::mutex m_DecompressMutex;
+};
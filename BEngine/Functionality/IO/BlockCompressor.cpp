@@ -0,0 +1,218 @@
+#include "BlockCompressor.h"
+
+//Library Includes
+#include <cstring>
+#include <algorithm>
+
+static inline uint32_t Read32(const uint8_t* ptr)
+{
+	uint32_t value;
+	std::memcpy(&value, ptr, sizeof(uint32_t));
+	return value;
+}
+
+//Writes the remainder of a length that didn't fit its 4 bit token field (runs of 255, ending on a byte below)
+static inline void WriteLength(size_t length, std::vector<uint8_t>& out)
+{
+	while (length >= 255)
+	{
+		out.push_back(255);
+		length -= 255;
+	}
+	out.push_back(static_cast<uint8_t>(length));
+}
+
+size_t BlockCompressor::Compress(const uint8_t* src, size_t srcSize, std::vector<uint8_t>& out)
+{
+	size_t startSize = out.size();
+	for (size_t offset = 0; offset < srcSize; offset += BLOCK_SIZE)
+	{
+		size_t blockSize = std::min(BLOCK_SIZE, srcSize - offset);
+
+		//Header written once the stored size is known
+		size_t headerPos = out.size();
+		out.resize(headerPos + sizeof(uint32_t));
+
+		uint32_t header = 0;
+		if (CompressBlock(src + offset, blockSize, out))
+			header = static_cast<uint32_t>(out.size() - headerPos - sizeof(uint32_t));
+		else
+		{
+			out.insert(out.end(), src + offset, src + offset + blockSize);
+			header = static_cast<uint32_t>(blockSize) | RAW_BLOCK_FLAG;
+		}
+		std::memcpy(&out[headerPos], &header, sizeof(uint32_t));
+	}
+
+	return out.size() - startSize;
+}
+
+bool BlockCompressor::Decompress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize)
+{
+	size_t srcPos = 0;
+	size_t dstPos = 0;
+	while (dstPos < dstSize)
+	{
+		if (srcSize - srcPos < sizeof(uint32_t))
+			return false;
+		uint32_t header = Read32(src + srcPos);
+		srcPos += sizeof(uint32_t);
+
+		size_t storedSize = header & ~RAW_BLOCK_FLAG;
+		size_t blockSize = std::min(BLOCK_SIZE, dstSize - dstPos);
+		if (storedSize > srcSize - srcPos)
+			return false;
+
+		if (header & RAW_BLOCK_FLAG)
+		{
+			if (storedSize != blockSize)
+				return false;
+			std::memcpy(dst + dstPos, src + srcPos, blockSize);
+		}
+		else if (!DecompressBlock(src + srcPos, storedSize, dst + dstPos, blockSize))
+			return false;
+
+		srcPos += storedSize;
+		dstPos += blockSize;
+	}
+
+	//Everything should have been used
+	return srcPos == srcSize;
+}
+
+bool BlockCompressor::CompressBlock(const uint8_t* src, size_t srcSize, std::vector<uint8_t>& out)
+{
+	size_t startSize = out.size();
+	//Give up as soon as the output is no smaller than the input
+	size_t outLimit = startSize + srcSize;
+
+	//Last position (+1, so 0 is empty) each hashed 4 byte sequence was seen at
+	std::vector<uint32_t> table(static_cast<size_t>(1) << HASH_BITS, 0);
+
+	size_t anchor = 0;
+	size_t pos = 0;
+	if (srcSize > MATCH_SAFE_DISTANCE)
+	{
+		const size_t matchStartLimit = srcSize - MATCH_SAFE_DISTANCE;
+		const size_t matchEndLimit = srcSize - END_LITERALS;
+		while (pos < matchStartLimit)
+		{
+			uint32_t sequence = Read32(src + pos);
+			uint32_t hash = (sequence * 2654435761u) >> (32 - HASH_BITS);
+			size_t candidate = table[hash];
+			table[hash] = static_cast<uint32_t>(pos + 1);
+
+			//Need a real match within reach
+			if (candidate == 0 || pos - (candidate - 1) > MAX_OFFSET || Read32(src + candidate - 1) != sequence)
+			{
+				++pos;
+				continue;
+			}
+			--candidate;
+
+			size_t length = MIN_MATCH;
+			while (pos + length < matchEndLimit && src[candidate + length] == src[pos + length])
+				++length;
+
+			//Sequence: token (literal and match length), literals, offset, then any length remainders
+			size_t literalLength = pos - anchor;
+			size_t matchCode = length - MIN_MATCH;
+			out.push_back(static_cast<uint8_t>((std::min<size_t>(literalLength, 15) << 4) | std::min<size_t>(matchCode, 15)));
+			if (literalLength >= 15)
+				WriteLength(literalLength - 15, out);
+			out.insert(out.end(), src + anchor, src + pos);
+
+			size_t offset = pos - candidate;
+			out.push_back(static_cast<uint8_t>(offset & 0xFF));
+			out.push_back(static_cast<uint8_t>(offset >> 8));
+			if (matchCode >= 15)
+				WriteLength(matchCode - 15, out);
+
+			pos += length;
+			anchor = pos;
+
+			if (out.size() >= outLimit)
+			{
+				out.resize(startSize);
+				return false;
+			}
+		}
+	}
+
+	//Final literals (no match)
+	size_t literalLength = srcSize - anchor;
+	out.push_back(static_cast<uint8_t>(std::min<size_t>(literalLength, 15) << 4));
+	if (literalLength >= 15)
+		WriteLength(literalLength - 15, out);
+	out.insert(out.end(), src + anchor, src + srcSize);
+
+	if (out.size() >= outLimit)
+	{
+		out.resize(startSize);
+		return false;
+	}
+	return true;
+}
+
+bool BlockCompressor::DecompressBlock(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize)
+{
+	const uint8_t* ip = src;
+	const uint8_t* const ipEnd = src + srcSize;
+	uint8_t* op = dst;
+	uint8_t* const opEnd = dst + dstSize;
+
+	auto readLength = [&ip, ipEnd](size_t& length)
+	{
+		uint8_t byte = 0;
+		do
+		{
+			if (ip >= ipEnd)
+				return false;
+			byte = *ip++;
+			length += byte;
+		} while (byte == 255);
+		return true;
+	};
+
+	while (ip < ipEnd)
+	{
+		uint8_t token = *ip++;
+
+		//Literals
+		size_t literalLength = token >> 4;
+		if (literalLength == 15 && !readLength(literalLength))
+			return false;
+		if (literalLength > static_cast<size_t>(ipEnd - ip) || literalLength > static_cast<size_t>(opEnd - op))
+			return false;
+		std::memcpy(op, ip, literalLength);
+		op += literalLength;
+		ip += literalLength;
+
+		//Last sequence has no match
+		if (ip == ipEnd)
+			break;
+
+		//Match
+		if (ipEnd - ip < 2)
+			return false;
+		size_t offset = static_cast<size_t>(ip[0]) | (static_cast<size_t>(ip[1]) << 8);
+		ip += 2;
+		if (offset == 0 || offset > static_cast<size_t>(op - dst))
+			return false;
+
+		size_t length = token & 15;
+		if (length == 15 && !readLength(length))
+			return false;
+		length += MIN_MATCH;
+		if (length > static_cast<size_t>(opEnd - op))
+			return false;
+
+		//Byte by byte, as a match can overlap the bytes it is writing (repeating runs)
+		const uint8_t* match = op - offset;
+		for (size_t i = 0; i < length; ++i)
+			op[i] = match[i];
+		op += length;
+	}
+
+	return op == opEnd;
+}
@@ -0,0 +1,65 @@
+//*********************************************************************************\\
+//
+// Fast LZ block compression (LZ4 style byte oriented sequences of literals and
+// back references, no entropy coding), used for AssetPack entries. Data is split
+// into fixed size blocks compressed independently, each stored raw instead if
+// compression wouldn't make it smaller, so incompressible data (e.g. already
+// block compressed textures) costs only a few bytes per block.
+//
+// Decompression checks every length and offset against its buffers, so corrupt
+// data fails rather than reading or writing out of bounds.
+//
+//*********************************************************************************\\
+
+#pragma once
+
+//Library Includes
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+class BlockCompressor
+{
+public:
+
+	//////////////////////////////
+	/// Enums, Types & Statics ///
+	//////////////////////////////
+
+	//Uncompressed bytes per block (the last block may be smaller)
+	static constexpr size_t BLOCK_SIZE = 64 * 1024;
+
+	//////////////////
+	/// Operations ///
+	//////////////////
+
+	//Compresses data into blocks, appending them to the output (returns bytes appended)
+	static size_t Compress(const uint8_t* src, size_t srcSize, std::vector<uint8_t>& out);
+	//Decompresses blocks into dst, which must be exactly the uncompressed size, returning false if the data is corrupt
+	static bool Decompress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize);
+
+private:
+
+	//////////////////////////////
+	/// Enums, Types & Statics ///
+	//////////////////////////////
+
+	//Block header flag (rest of the header is the stored size) marking a block stored uncompressed
+	static constexpr uint32_t RAW_BLOCK_FLAG = 0x80000000;
+
+	//Shortest back reference, and the literal bytes always left at the end of a block
+	static constexpr size_t MIN_MATCH = 4;
+	static constexpr size_t END_LITERALS = 5;
+	//Matches can't start within this many bytes of the block end
+	static constexpr size_t MATCH_SAFE_DISTANCE = 12;
+	static constexpr size_t MAX_OFFSET = 0xFFFF;
+	static constexpr unsigned HASH_BITS = 14;
+
+	//////////////////
+	/// Operations ///
+	//////////////////
+
+	//Compresses a single block into the output, returning false (output unchanged) if it didn't get smaller
+	static bool CompressBlock(const uint8_t* src, size_t srcSize, std::vector<uint8_t>& out);
+	static bool DecompressBlock(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize);
+};
@@ -0,0 +1,93 @@
+#include "FileWatcher.h"
+
+//Library Includes
+#include <algorithm>
+
+//Utilities
+#include "Utils/Utils_Debug.h"
+
+FileWatcher::WatchID FileWatcher::Watch(const std::string& fp, Callback callback)
+{
+	msg_assert(callback != nullptr, "Watch(): No callback given!");
+
+	WatchedFile watch;
+	watch.m_ID = m_NextID++;
+	watch.m_Filepath = fp;
+	watch.m_Callback = callback;
+	watch.m_Stamp = ReadStamp(fp);
+	m_Watches.push_back(watch);
+
+	return watch.m_ID;
+}
+
+void FileWatcher::Unwatch(WatchID id)
+{
+	m_Watches.erase(std::remove_if(m_Watches.begin(), m_Watches.end(), [id](const WatchedFile& watch) { return watch.m_ID == id; }), m_Watches.end());
+}
+
+void FileWatcher::UnwatchAll()
+{
+	m_Watches.clear();
+}
+
+unsigned FileWatcher::Update()
+{
+	auto now = std::chrono::steady_clock::now();
+	if (now - m_LastPoll < std::chrono::milliseconds(m_Settings.m_PollIntervalMS))
+		return 0;
+	m_LastPoll = now;
+
+	//Find settled changes first, as callbacks may watch or unwatch files
+	std::vector<WatchID> changed;
+	for (auto& watch : m_Watches)
+	{
+		Stamp stamp = ReadStamp(watch.m_Filepath);
+		if (stamp == watch.m_Stamp)
+		{
+			watch.m_HasPending = false;
+			continue;
+		}
+
+		//Report once unchanged since the last poll
+		if (watch.m_HasPending && stamp == watch.m_Pending)
+		{
+			watch.m_Stamp = stamp;
+			watch.m_HasPending = false;
+			if (stamp.m_Exists)
+				changed.push_back(watch.m_ID);
+			continue;
+		}
+		watch.m_Pending = stamp;
+		watch.m_HasPending = true;
+	}
+
+	//Skipping any unwatched by an earlier callback
+	unsigned count = 0;
+	for (WatchID id : changed)
+	{
+		auto it = std::find_if(m_Watches.begin(), m_Watches.end(), [id](const WatchedFile& watch) { return watch.m_ID == id; });
+		if (it == m_Watches.end())
+			continue;
+
+		//Copied, as the callback may change the watches
+		std::string fp = it->m_Filepath;
+		Callback callback = it->m_Callback;
+		DBOUT("Update(): File changed: " << fp);
+		callback(fp);
+		++count;
+	}
+
+	return count;
+}
+
+FileWatcher::Stamp FileWatcher::ReadStamp(const std::string& fp)
+{
+	Stamp stamp;
+	std::error_code ec;
+	stamp.m_WriteTime = std::filesystem::last_write_time(fp, ec);
+	if (ec)
+		return stamp;
+	stamp.m_Size = std::filesystem::file_size(fp, ec);
+	stamp.m_Exists = !ec;
+	return stamp;
+}
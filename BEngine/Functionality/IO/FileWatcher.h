@@ -0,0 +1,117 @@
+//*********************************************************************************\\
+//
+// Watches files for changes, calling back when one is modified (for hot reloading
+// of manifests and config data, see Mgr_TextureResources::EnableHotReload and
+// FL_Model::Reload). Files are polled for their write time and size at a set
+// interval, and a change is only reported once the file has stayed the same for
+// a whole poll, so files still being saved aren't read half written.
+//
+// Callbacks run on the thread calling Update (between frames), so they can patch
+// resources in place without any locking, and can watch or unwatch files.
+//
+//*********************************************************************************\\
+
+#pragma once
+
+//Library Includes
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <filesystem>
+
+class FileWatcher
+{
+public:
+
+	//////////////////////////////
+	/// Enums, Types & Statics ///
+	//////////////////////////////
+
+	typedef uint32_t WatchID;
+	static constexpr WatchID INVALID_ID = 0xFFFFFFFF;
+
+	//Called with the path of the changed file
+	typedef std::function<void(const std::string&)> Callback;
+
+	struct Settings
+	{
+		//Time between polls of every watched file
+		unsigned m_PollIntervalMS = 500;
+	};
+
+	////////////////////
+	/// Constructors ///
+	////////////////////
+
+	FileWatcher() { }
+	~FileWatcher() { }
+
+	//////////////////
+	/// Operations ///
+	//////////////////
+
+	//Starts watching a file (which needn't exist yet), returning an ID to stop watching with
+	WatchID Watch(const std::string& fp, Callback callback);
+	void Unwatch(WatchID id);
+	void UnwatchAll();
+
+	//Polls the watched files if the interval has passed, calling back for each changed file. Returns the number changed.
+	unsigned Update();
+
+	/////////////////
+	/// Accessors ///
+	/////////////////
+
+	void SetSettings(const Settings& settings) { m_Settings = settings; }
+	const Settings& GetSettings() { return m_Settings; }
+	size_t GetWatchCount() { return m_Watches.size(); }
+
+private:
+
+	//////////////////////////////
+	/// Enums, Types & Statics ///
+	//////////////////////////////
+
+	//File state compared between polls
+	struct Stamp
+	{
+		std::filesystem::file_time_type m_WriteTime;
+		uintmax_t m_Size = 0;
+		bool m_Exists = false;
+
+		bool operator==(const Stamp& other) const
+		{
+			return m_Exists == other.m_Exists && m_WriteTime == other.m_WriteTime && m_Size == other.m_Size;
+		}
+		bool operator!=(const Stamp& other) const { return !(*this == other); }
+	};
+
+	struct WatchedFile
+	{
+		WatchID m_ID = INVALID_ID;
+		std::string m_Filepath;
+		Callback m_Callback;
+		//Last reported state, and a changed state waiting to settle
+		Stamp m_Stamp;
+		Stamp m_Pending;
+		bool m_HasPending = false;
+	};
+
+	//////////////////
+	/// Operations ///
+	//////////////////
+
+	static Stamp ReadStamp(const std::string& fp);
+
+	////////////
+	/// Data ///
+	////////////
+
+	Settings m_Settings;
+	std::vector<WatchedFile> m_Watches;
+	WatchID m_NextID = 0;
+
+	std::chrono::steady_clock::time_point m_LastPoll;
+};
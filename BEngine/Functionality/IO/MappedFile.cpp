@@ -0,0 +1,57 @@
+#include "MappedFile.h"
+
+//Library Includes
+#include <windows.h>
+
+bool MappedFile::Open(const std::string& fp)
+{
+	Close();
+
+	HANDLE file = CreateFileA(fp.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+		return false;
+
+	LARGE_INTEGER size = {};
+	if (!GetFileSizeEx(file, &size))
+	{
+		CloseHandle(file);
+		return false;
+	}
+	m_File = file;
+	m_Size = static_cast<size_t>(size.QuadPart);
+
+	//Empty files can't be mapped, but are still valid (just no data)
+	if (m_Size == 0)
+		return true;
+
+	m_Mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (!m_Mapping)
+	{
+		Close();
+		return false;
+	}
+
+	m_Data = static_cast<const unsigned char*>(MapViewOfFile(m_Mapping, FILE_MAP_READ, 0, 0, 0));
+	if (!m_Data)
+	{
+		Close();
+		return false;
+	}
+
+	return true;
+}
+
+void MappedFile::Close()
+{
+	if (m_Data)
+		UnmapViewOfFile(m_Data);
+	if (m_Mapping)
+		CloseHandle(m_Mapping);
+	if (m_File)
+		CloseHandle(m_File);
+
+	m_Data = nullptr;
+	m_Mapping = nullptr;
+	m_File = nullptr;
+	m_Size = 0;
+}
@@ -0,0 +1,60 @@
+//*********************************************************************************\\
+//
+// Read-only memory mapped file. Maps the whole file into the address space so it
+// can be read (or referenced in place) without copying, with pages loaded by the
+// OS on first access. The mapping is released when closed or destroyed, so keep
+// the object alive for as long as anything points into it.
+//
+//*********************************************************************************\\
+
+#pragma once
+
+//Library Includes
+#include <string>
+#include <cstddef>
+
+class MappedFile
+{
+public:
+
+	////////////////////
+	/// Constructors ///
+	////////////////////
+
+	MappedFile() { }
+	~MappedFile() { Close(); }
+
+	//Owns OS handles, so not copyable
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	//////////////////
+	/// Operations ///
+	//////////////////
+
+	//Maps file at path (closing any open file first), returning false if it can't be opened or mapped
+	bool Open(const std::string& fp);
+	//Unmaps and closes the file (any pointers into the data are invalid after this)
+	void Close();
+
+	/////////////////
+	/// Accessors ///
+	/////////////////
+
+	bool IsOpen() const						{ return m_File != nullptr; }
+	const unsigned char* GetData() const	{ return m_Data; }
+	size_t GetSize() const					{ return m_Size; }
+
+private:
+
+	////////////
+	/// Data ///
+	////////////
+
+	//OS handles (kept as void* so Windows.h isn't needed here)
+	void* m_File = nullptr;
+	void* m_Mapping = nullptr;
+
+	const unsigned char* m_Data = nullptr;
+	size_t m_Size = 0;
+};
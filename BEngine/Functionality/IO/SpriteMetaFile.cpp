@@ -0,0 +1,202 @@
+#include "SpriteMetaFile.h"
+
+//Library Includes
+#include <fstream>
+#include <vector>
+#include <memory>
+#include <type_traits>
+
+//Utilities
+#include "Utils/Utils_Debug.h"
+
+//Engine Includes
+#include "Types/BE_SharedTypes.h"
+#include "IO/MappedFile.h"
+
+//Frames are stored and referenced as raw records, so they must stay plain data
+static_assert(std::is_trivially_copyable<SpriteFrame>::value, "SpriteFrame must be trivially copyable to be baked!");
+static_assert(sizeof(SpriteFrame) <= 0xFFFF, "SpriteFrame too large for frame record size!");
+static_assert(sizeof(SpriteMetaFile::Header) == 60, "SpriteMetaFile header size mismatch!");
+static_assert(sizeof(SpriteMetaFile::AnimationRecord) == 28, "SpriteMetaFile animation record size mismatch!");
+
+//Sections start 4 byte aligned (mapped views are page aligned, so records are aligned in memory)
+static inline uint32_t AlignSection(uint32_t offset)
+{
+	return (offset + 3u) & ~3u;
+}
+
+bool SpriteMetaFile::Write(const std::string& fp, const SpriteTexture& tex)
+{
+	msg_assert(tex.m_TexSize.x > 0 && tex.m_TexSize.y > 0, "Write(): Texture size not set!");
+
+	//
+	//Flatten animations
+	//
+
+	std::vector<AnimationRecord> anims;
+	std::vector<int16_t> animFrames;
+	std::string names;
+	anims.reserve(tex.m_Animations.size());
+	for (auto& a : tex.m_Animations)
+	{
+		AnimationRecord record = {};
+		record.m_NameOffset = static_cast<uint32_t>(names.size());
+		record.m_NameLength = static_cast<uint32_t>(a.m_Name.size());
+		record.m_Speed = a.m_Speed;
+		record.m_StartFrame = a.m_StartFrame;
+		record.m_EndFrame = a.m_EndFrame;
+		record.m_AnimationLength = a.m_AnimationLength;
+		record.m_TypeID = static_cast<uint16_t>(a.m_TypeID);
+		record.m_FrameIndexFirst = static_cast<uint32_t>(animFrames.size());
+		record.m_FrameIndexCount = static_cast<uint32_t>(a.m_FrameIndexes.size());
+
+		names += a.m_Name;
+		animFrames.insert(animFrames.end(), a.m_FrameIndexes.begin(), a.m_FrameIndexes.end());
+		anims.push_back(record);
+	}
+
+	//
+	//Header
+	//
+
+	Header header = {};
+	header.m_Magic = MAGIC;
+	header.m_Version = VERSION;
+	header.m_FrameRecordSize = static_cast<uint16_t>(sizeof(SpriteFrame));
+	header.m_TexWidth = tex.m_TexSize.x;
+	header.m_TexHeight = tex.m_TexSize.y;
+
+	header.m_FrameCount = static_cast<uint32_t>(tex.m_Frames.size());
+	header.m_FrameOffset = AlignSection(sizeof(Header));
+	header.m_HullVertexCount = static_cast<uint32_t>(tex.m_HullVertices.size());
+	header.m_HullVertexOffset = AlignSection(header.m_FrameOffset + header.m_FrameCount * static_cast<uint32_t>(sizeof(SpriteFrame)));
+	header.m_AnimationCount = static_cast<uint32_t>(anims.size());
+	header.m_AnimationOffset = AlignSection(header.m_HullVertexOffset + header.m_HullVertexCount * static_cast<uint32_t>(sizeof(DirectX::XMFLOAT2)));
+	header.m_AnimFrameIndexCount = static_cast<uint32_t>(animFrames.size());
+	header.m_AnimFrameIndexOffset = AlignSection(header.m_AnimationOffset + header.m_AnimationCount * static_cast<uint32_t>(sizeof(AnimationRecord)));
+	header.m_NamesSize = static_cast<uint32_t>(names.size());
+	header.m_NamesOffset = AlignSection(header.m_AnimFrameIndexOffset + header.m_AnimFrameIndexCount * static_cast<uint32_t>(sizeof(int16_t)));
+
+	//
+	//Write (padding each section up to its offset)
+	//
+
+	std::ofstream file(fp, std::ios::binary);
+	if (!file.is_open())
+	{
+		DBOUT("Write(): Failed to open file: " << fp);
+		return false;
+	}
+
+	uint32_t written = 0;
+	auto writeSection = [&file, &written](uint32_t offset, const void* data, size_t size)
+	{
+		static const char padding[4] = {};
+		file.write(padding, offset - written);
+		file.write(static_cast<const char*>(data), size);
+		written = offset + static_cast<uint32_t>(size);
+	};
+
+	writeSection(0, &header, sizeof(Header));
+	writeSection(header.m_FrameOffset, tex.m_Frames.data(), tex.m_Frames.size() * sizeof(SpriteFrame));
+	writeSection(header.m_HullVertexOffset, tex.m_HullVertices.data(), tex.m_HullVertices.size() * sizeof(DirectX::XMFLOAT2));
+	writeSection(header.m_AnimationOffset, anims.data(), anims.size() * sizeof(AnimationRecord));
+	writeSection(header.m_AnimFrameIndexOffset, animFrames.data(), animFrames.size() * sizeof(int16_t));
+	writeSection(header.m_NamesOffset, names.data(), names.size());
+
+	return static_cast<bool>(file);
+}
+
+bool SpriteMetaFile::Load(const std::string& fp, SpriteTexture& tex)
+{
+	std::shared_ptr<MappedFile> file = std::make_shared<MappedFile>();
+	if (!file->Open(fp) || file->GetSize() < sizeof(Header))
+		return false;
+
+	const unsigned char* base = file->GetData();
+	const Header& header = *reinterpret_cast<const Header*>(base);
+
+	//Check file was baked by this version, and against this texture
+	if (header.m_Magic != MAGIC || header.m_Version != VERSION || header.m_FrameRecordSize != sizeof(SpriteFrame))
+	{
+		DBOUT("Load(): Baked metadata is from a different version, ignoring: " << fp);
+		return false;
+	}
+	if (header.m_TexWidth != tex.m_TexSize.x || header.m_TexHeight != tex.m_TexSize.y)
+	{
+		DBOUT("Load(): Baked metadata doesn't match texture size, ignoring: " << fp);
+		return false;
+	}
+
+	//Check every section fits in the file
+	const uint64_t size = file->GetSize();
+	auto sectionFits = [size](uint32_t offset, uint64_t bytes)
+	{
+		return (offset & 3u) == 0 && offset + bytes <= size;
+	};
+	if (!sectionFits(header.m_FrameOffset, static_cast<uint64_t>(header.m_FrameCount) * sizeof(SpriteFrame)) ||
+		!sectionFits(header.m_HullVertexOffset, static_cast<uint64_t>(header.m_HullVertexCount) * sizeof(DirectX::XMFLOAT2)) ||
+		!sectionFits(header.m_AnimationOffset, static_cast<uint64_t>(header.m_AnimationCount) * sizeof(AnimationRecord)) ||
+		!sectionFits(header.m_AnimFrameIndexOffset, static_cast<uint64_t>(header.m_AnimFrameIndexCount) * sizeof(int16_t)) ||
+		!sectionFits(header.m_NamesOffset, header.m_NamesSize) ||
+		header.m_FrameCount > SpriteTexture::MAX_FRAMES)
+	{
+		DBOUT("Load(): Baked metadata is truncated or corrupt, ignoring: " << fp);
+		return false;
+	}
+
+	//
+	//Animations (rebuilt, as they own their names and frame indexes)
+	//
+
+	const AnimationRecord* records = reinterpret_cast<const AnimationRecord*>(base + header.m_AnimationOffset);
+	const int16_t* animFrames = reinterpret_cast<const int16_t*>(base + header.m_AnimFrameIndexOffset);
+	const char* names = reinterpret_cast<const char*>(base + header.m_NamesOffset);
+
+	std::vector<AnimationData> anims(header.m_AnimationCount);
+	for (uint32_t i(0); i < header.m_AnimationCount; ++i)
+	{
+		const AnimationRecord& record = records[i];
+		if (record.m_NameOffset + static_cast<uint64_t>(record.m_NameLength) > header.m_NamesSize ||
+			record.m_FrameIndexFirst + static_cast<uint64_t>(record.m_FrameIndexCount) > header.m_AnimFrameIndexCount)
+		{
+			DBOUT("Load(): Baked metadata is truncated or corrupt, ignoring: " << fp);
+			return false;
+		}
+
+		AnimationData& anim = anims[i];
+		anim.m_Name.assign(names + record.m_NameOffset, record.m_NameLength);
+		anim.m_AnimationID = i;
+		anim.m_ContainerIndex = i;
+		anim.m_Speed = record.m_Speed;
+		anim.m_StartFrame = record.m_StartFrame;
+		anim.m_EndFrame = record.m_EndFrame;
+		anim.m_AnimationLength = record.m_AnimationLength;
+		anim.m_TypeID = static_cast<AnimationData::AnimID>(record.m_TypeID);
+		anim.m_FrameIndexes.assign(animFrames + record.m_FrameIndexFirst, animFrames + record.m_FrameIndexFirst + record.m_FrameIndexCount);
+	}
+
+	//
+	//Point texture at the mapped frames
+	//
+
+	tex.m_Frames = ArrayView<SpriteFrame>(reinterpret_cast<const SpriteFrame*>(base + header.m_FrameOffset), header.m_FrameCount);
+	tex.m_HullVertices = ArrayView<DirectX::XMFLOAT2>(reinterpret_cast<const DirectX::XMFLOAT2*>(base + header.m_HullVertexOffset), header.m_HullVertexCount);
+	tex.m_FrameStorage.clear();
+	tex.m_HullVertexStorage.clear();
+	tex.m_Animations = std::move(anims);
+	tex.m_MetaFile = std::move(file);
+
+	return true;
+}
+
+std::string SpriteMetaFile::GetBakedFilepath(const std::string& framesFP)
+{
+	//Swap extension (if the filename has one)
+	size_t dot = framesFP.find_last_of('.');
+	size_t slash = framesFP.find_last_of("/\\");
+	if (dot != std::string::npos && (slash == std::string::npos || dot > slash))
+		return framesFP.substr(0, dot) + EXTENSION;
+
+	return framesFP + EXTENSION;
+}
@@ -0,0 +1,93 @@
+//*********************************************************************************\\
+//
+// Baked binary sprite metadata (frames, hulls and animations of a texture). Written
+// offline (see SpriteMetaBaker) from the same data LoadFrameData/LoadAnimationData
+// produce from JSON, and loaded by memory mapping the file and pointing the
+// textures frame views straight into it, so there is no parsing and no per frame
+// allocation (only animations, being few and holding strings, are rebuilt).
+//
+// Layout is little-endian: a header, then 4 byte aligned sections of SpriteFrame
+// records (stored as is), hull vertices, animation records, animation frame
+// indexes and animation names. Files written with a different version or frame
+// record size are rejected, so bump the version when changing the layout (or
+// SpriteFrame), and rebake.
+//
+//*********************************************************************************\\
+
+#pragma once
+
+//Library Includes
+#include <string>
+#include <cstdint>
+
+//Forward Declarations
+struct SpriteTexture;
+
+class SpriteMetaFile
+{
+public:
+
+	//////////////////////////////
+	/// Enums, Types & Statics ///
+	//////////////////////////////
+
+	static constexpr uint32_t MAGIC = 0x4D535042;	//"BPSM"
+	static constexpr uint16_t VERSION = 1;
+	//Extension of baked files (replaces the extension of the frames file they're baked from)
+	static constexpr const char* EXTENSION = ".spritemeta";
+
+	struct Header
+	{
+		uint32_t m_Magic;
+		uint16_t m_Version;
+		//sizeof(SpriteFrame) when written
+		uint16_t m_FrameRecordSize;
+		//Texture size the frame UVs were baked against
+		uint32_t m_TexWidth;
+		uint32_t m_TexHeight;
+
+		//Section counts and offsets (from the start of the file)
+		uint32_t m_FrameCount;
+		uint32_t m_FrameOffset;
+		uint32_t m_HullVertexCount;
+		uint32_t m_HullVertexOffset;
+		uint32_t m_AnimationCount;
+		uint32_t m_AnimationOffset;
+		uint32_t m_AnimFrameIndexCount;
+		uint32_t m_AnimFrameIndexOffset;
+		uint32_t m_NamesSize;
+		uint32_t m_NamesOffset;
+	};
+
+	struct AnimationRecord
+	{
+		//Name location in the names section (not null terminated)
+		uint32_t m_NameOffset;
+		uint32_t m_NameLength;
+		float m_Speed;
+		int16_t m_StartFrame;
+		int16_t m_EndFrame;
+		int16_t m_AnimationLength;
+		uint16_t m_TypeID;
+		//Frame indexes (non-linear animations only)
+		uint32_t m_FrameIndexFirst;
+		uint32_t m_FrameIndexCount;
+	};
+
+	//////////////////
+	/// Operations ///
+	//////////////////
+
+	//Writes frames, hulls and animations of the texture (texture size must be set)
+	static bool Write(const std::string& fp, const SpriteTexture& tex);
+
+	/*
+		Maps baked file and points texture at its frames and hulls, rebuilding its animations. Texture size must
+		already be set (loaded), and match the size the file was baked against. Returns false (leaving texture
+		untouched) if the file doesn't exist or can't be used, so the caller can fall back to JSON.
+	*/
+	static bool Load(const std::string& fp, SpriteTexture& tex);
+
+	//Gets the baked filepath for a frames filepath
+	static std::string GetBakedFilepath(const std::string& framesFP);
+};
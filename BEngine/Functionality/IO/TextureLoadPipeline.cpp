@@ -0,0 +1,266 @@
+#include "TextureLoadPipeline.h"
+
+//Library Includes
+#include <atomic>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <fstream>
+#include <functional>
+#include <unordered_map>
+
+//Utilities
+#include "Utils/Utils_Debug.h"
+#include "Utils/Utils_RapidJSON.h"
+
+//Engine Includes
+#include "IO/AssetPack.h"
+#include "Types/BE_SharedTypes.h"
+#include "Managers/Mgr_TextureResources.h"
+
+typedef std::chrono::high_resolution_clock Clock;
+
+//Reads top mip size from a DDS header ("DDS " magic, then size, flags, height and width)
+static bool ReadDDSSize(const uint8_t* data, size_t size, uint32_t& outWidth, uint32_t& outHeight)
+{
+	if (size < 128 || data[0] != 'D' || data[1] != 'D' || data[2] != 'S' || data[3] != ' ')
+		return false;
+
+	outHeight = data[12] | (data[13] << 8) | (data[14] << 16) | (static_cast<uint32_t>(data[15]) << 24);
+	outWidth = data[16] | (data[17] << 8) | (data[18] << 16) | (static_cast<uint32_t>(data[19]) << 24);
+	return outWidth > 0 && outHeight > 0;
+}
+
+bool TextureLoadPipeline::StubTextureCreator::CreateTexture(const TextureFile& file, SpriteTexture& outTex)
+{
+	//Share index with earlier entries using the same file
+	size_t index = 0;
+	while (index < m_Files.size() && m_Files[index] != file.m_Filepath)
+		++index;
+	if (index == m_Files.size())
+		m_Files.push_back(file.m_Filepath);
+
+	outTex.m_HeapIndex = static_cast<unsigned>(index);
+	outTex.m_TexSize = DirectX::XMUINT2(file.m_Width, file.m_Height);
+	return true;
+}
+
+TextureLoadPipeline::TextureLoadPipeline()
+{
+}
+
+TextureLoadPipeline::~TextureLoadPipeline()
+{
+}
+
+bool TextureLoadPipeline::ReadManifest(const std::string& manifestFP, unsigned manifestIndex, std::vector<Entry>& outEntries)
+{
+	rapidjson::Document manifestDoc;
+	std::string error;
+	if (!ParseNewJSONDocument(manifestDoc, manifestFP, &error))
+	{
+		DBOUT("ReadManifest(): " << error);
+		return false;
+	}
+
+	if (!manifestDoc.HasMember("Manifests") || manifestIndex >= manifestDoc["Manifests"].Size())
+	{
+		msg_assert(false, "ReadManifest(): Manifest not found!");
+		return false;
+	}
+
+	const rapidjson::Value& textures = manifestDoc["Manifests"][manifestIndex]["Textures"];
+	outEntries.reserve(outEntries.size() + textures.Size());
+	for (unsigned i(0); i < textures.Size(); ++i)
+	{
+		Entry entry;
+		entry.m_Name = textures[i]["Texture_Name"].GetString();
+		entry.m_TextureFP = textures[i]["Texture_Filepath"].GetString();
+		entry.m_FramesFP = textures[i]["Frames_Filepath"].GetString();
+		if (textures[i].HasMember("Animations_Filepath"))
+			entry.m_AnimationsFP = textures[i]["Animations_Filepath"].GetString();
+		outEntries.push_back(entry);
+	}
+
+	return true;
+}
+
+bool TextureLoadPipeline::LoadFiles(const std::vector<Entry>& entries, unsigned workerCount)
+{
+	auto start = Clock::now();
+
+	m_Entries = entries;
+	m_Files.clear();
+	m_EntryFiles.assign(entries.size(), 0);
+	m_Textures.clear();
+	m_Textures.resize(entries.size());
+
+	//Group entries by texture file
+	std::unordered_map<std::string, size_t> fileIndexes;
+	for (size_t i = 0; i < m_Entries.size(); ++i)
+	{
+		auto result = fileIndexes.emplace(m_Entries[i].m_TextureFP, m_Files.size());
+		if (result.second)
+		{
+			m_Files.push_back(TextureFile());
+			m_Files.back().m_Filepath = m_Entries[i].m_TextureFP;
+		}
+		m_EntryFiles[i] = result.first->second;
+	}
+
+	if (workerCount == 0)
+		workerCount = std::max(1u, std::thread::hardware_concurrency());
+
+	//Texture files first (entries need their size for frame UVs), then entries
+	RunParallel(m_Files.size(), workerCount, [this](size_t i) { LoadFile(i); });
+	RunParallel(m_Entries.size(), workerCount, [this](size_t i) { LoadEntry(i); });
+
+	m_Report = Report();
+	m_Report.m_EntryCount = m_Entries.size();
+	m_Report.m_FileCount = m_Files.size();
+	m_Report.m_WorkerCount = workerCount;
+	m_Report.m_FileStageMS = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+	for (auto& tex : m_Textures)
+	{
+		if (!tex)
+			return false;
+	}
+	return true;
+}
+
+bool TextureLoadPipeline::CreateTextures(TextureCreator& creator, std::vector<std::unique_ptr<SpriteTexture>>& outTextures)
+{
+	auto start = Clock::now();
+
+	bool result = true;
+	for (size_t i = 0; i < m_Textures.size(); ++i)
+	{
+		if (!m_Textures[i])
+		{
+			DBOUT("CreateTextures(): Failed to load texture: " << m_Entries[i].m_Name);
+			result = false;
+			break;
+		}
+		if (!creator.CreateTexture(m_Files[m_EntryFiles[i]], *m_Textures[i]))
+		{
+			DBOUT("CreateTextures(): Failed to create texture: " << m_Entries[i].m_Name);
+			result = false;
+			break;
+		}
+
+		outTextures.push_back(std::move(m_Textures[i]));
+	}
+
+	//Release file data (already uploaded)
+	m_Files.clear();
+	m_EntryFiles.clear();
+	m_Textures.clear();
+
+	m_Report.m_CreateStageMS = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+	return result;
+}
+
+bool TextureLoadPipeline::ReadTextureFile(TextureFile& file)
+{
+	//View in place if in a mounted pack
+	AssetPack::View packed;
+	if (AssetPack::FindMounted(file.m_Filepath, packed))
+	{
+		file.m_Data = packed.m_Data;
+		file.m_Size = packed.m_Size;
+	}
+	else
+	{
+		//Read whole file (needed whole for creation, and header gives size for frame UVs), left empty on failure
+		std::ifstream stream(file.m_Filepath, std::ios::binary | std::ios::ate);
+		if (!stream.is_open())
+		{
+			DBOUT("ReadTextureFile(): Failed to open texture: " << file.m_Filepath);
+			return false;
+		}
+		file.m_Storage.resize(static_cast<size_t>(stream.tellg()));
+		stream.seekg(0, std::ios::beg);
+		if (!stream.read(reinterpret_cast<char*>(file.m_Storage.data()), file.m_Storage.size()))
+		{
+			DBOUT("ReadTextureFile(): Failed to read texture: " << file.m_Filepath);
+			ReleaseTextureFile(file);
+			return false;
+		}
+		file.m_Data = file.m_Storage.data();
+		file.m_Size = file.m_Storage.size();
+	}
+
+	if (!ReadDDSSize(file.m_Data, file.m_Size, file.m_Width, file.m_Height))
+	{
+		DBOUT("ReadTextureFile(): Failed to read texture: " << file.m_Filepath);
+		ReleaseTextureFile(file);
+		return false;
+	}
+
+	return true;
+}
+
+void TextureLoadPipeline::ReleaseTextureFile(TextureFile& file)
+{
+	file.m_Data = nullptr;
+	file.m_Size = 0;
+	file.m_Storage.clear();
+	file.m_Storage.shrink_to_fit();
+}
+
+bool TextureLoadPipeline::LoadMetaData(const Entry& entry, SpriteTexture& outTex)
+{
+	//Copied, as the manager takes non-const paths
+	std::string framesFP = entry.m_FramesFP;
+	std::string animFP = entry.m_AnimationsFP;
+	return Mgr_TextureResources::LoadMetaData(outTex, framesFP, animFP.empty() ? nullptr : &animFP);
+}
+
+void TextureLoadPipeline::LoadFile(size_t fileIndex)
+{
+	ReadTextureFile(m_Files[fileIndex]);
+}
+
+void TextureLoadPipeline::LoadEntry(size_t entryIndex)
+{
+	//Skip entries whose texture failed (left null)
+	const TextureFile& file = m_Files[m_EntryFiles[entryIndex]];
+	if (file.m_Size == 0)
+		return;
+
+	Entry& entry = m_Entries[entryIndex];
+	std::unique_ptr<SpriteTexture> tex = std::make_unique<SpriteTexture>();
+	tex->m_Name = entry.m_Name;
+	tex->m_TexSize = DirectX::XMUINT2(file.m_Width, file.m_Height);
+
+	if (!LoadMetaData(entry, *tex))
+		return;
+
+	m_Textures[entryIndex] = std::move(tex);
+}
+
+void TextureLoadPipeline::RunParallel(size_t count, unsigned workerCount, const std::function<void(size_t)>& job)
+{
+	//Workers take the next index until none are left
+	workerCount = static_cast<unsigned>(std::min<size_t>(workerCount, count));
+	std::atomic<size_t> next(0);
+	auto work = [count, &next, &job]()
+	{
+		for (size_t i = next++; i < count; i = next++)
+			job(i);
+	};
+
+	if (workerCount <= 1)
+	{
+		work();
+		return;
+	}
+
+	std::vector<std::thread> workers;
+	workers.reserve(workerCount);
+	for (unsigned i(0); i < workerCount; ++i)
+		workers.emplace_back(work);
+	for (auto& worker : workers)
+		worker.join();
+}
@@ -0,0 +1,158 @@
+//*********************************************************************************\\
+//
+// Staged texture manifest loading. Work that only touches files (reading texture
+// files and parsing their frame/animation data) runs for every entry at once on
+// worker threads, leaving only texture creation (resource, descriptor and heap
+// allocation) to run serially, in manifest order, through a TextureCreator.
+//
+// Nothing here touches the graphics API, so the pipeline can be run headless
+// with StubTextureCreator (see ManifestLoadBenchmark), and Mgr_TextureResources
+// supplies the creator that makes the real resources.
+//
+//*********************************************************************************\\
+
+#pragma once
+
+//Library Includes
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <functional>
+
+//Forward Declarations
+struct SpriteTexture;
+
+class TextureLoadPipeline
+{
+public:
+
+	//////////////////////////////
+	/// Enums, Types & Statics ///
+	//////////////////////////////
+
+	//Manifest entry to load (see Texture_Manifest_Example.json)
+	struct Entry
+	{
+		std::string m_Name;
+		std::string m_TextureFP;
+		std::string m_FramesFP;
+		//Optional (empty if none)
+		std::string m_AnimationsFP;
+	};
+
+	/*
+		Texture file read during the file stage (read once, however many entries use it). Data views either the files own
+		storage (loose files) or a mounted AssetPack entry (no copy), so move rather than copy files to keep the view valid.
+	*/
+	struct TextureFile
+	{
+		std::string m_Filepath;
+		const uint8_t* m_Data = nullptr;
+		size_t m_Size = 0;
+		std::vector<uint8_t> m_Storage;
+		//Top mip size, read from the files header
+		uint32_t m_Width = 0;
+		uint32_t m_Height = 0;
+	};
+
+	/*
+		Creates texture resources from files read by the pipeline. Called serially in manifest order, so creators can
+		allocate descriptors without locking.
+	*/
+	class TextureCreator
+	{
+	public:
+		virtual ~TextureCreator() { }
+
+		//Creates (or reuses) the resource for the file, setting the textures resource, heap, heap index and size
+		virtual bool CreateTexture(const TextureFile& file, SpriteTexture& outTex) = 0;
+	};
+
+	//Creator that makes no resources, just assigning sequential heap indexes per distinct file (for headless runs)
+	class StubTextureCreator : public TextureCreator
+	{
+	public:
+		bool CreateTexture(const TextureFile& file, SpriteTexture& outTex) override;
+
+	private:
+		std::vector<std::string> m_Files;
+	};
+
+	//Timings of the last load
+	struct Report
+	{
+		size_t m_EntryCount = 0;
+		size_t m_FileCount = 0;
+		unsigned m_WorkerCount = 0;
+		//Time spent in each stage (milliseconds)
+		double m_FileStageMS = 0.0;
+		double m_CreateStageMS = 0.0;
+	};
+
+	////////////////////
+	/// Constructors ///
+	////////////////////
+
+	TextureLoadPipeline();
+	~TextureLoadPipeline();
+
+	//////////////////
+	/// Operations ///
+	//////////////////
+
+	//Reads the entries of the manifest at the given index
+	static bool ReadManifest(const std::string& manifestFP, unsigned manifestIndex, std::vector<Entry>& outEntries);
+	//Reads a whole texture file (at the files path, from a mounted AssetPack if in one) and its size, leaving data empty and returning false on failure
+	static bool ReadTextureFile(TextureFile& file);
+	//Releases a files data (and storage)
+	static void ReleaseTextureFile(TextureFile& file);
+	//Parses an entries frame (and animation) data into the texture (texture size should be set from its file first)
+	static bool LoadMetaData(const Entry& entry, SpriteTexture& outTex);
+
+	/*
+		File stage: reads every distinct texture file, then parses every entries frame (and animation) data, spread over
+		the given number of worker threads (0 uses the hardware thread count, 1 runs on the calling thread). Returns
+		false if any entry failed, though entries before the first failure can still be created.
+	*/
+	bool LoadFiles(const std::vector<Entry>& entries, unsigned workerCount = 0);
+
+	/*
+		Create stage: creates each entries texture in manifest order, appending finished textures to the output.
+		Stops at the first entry that failed to load or create, returning false. Releases loaded file data.
+	*/
+	bool CreateTextures(TextureCreator& creator, std::vector<std::unique_ptr<SpriteTexture>>& outTextures);
+
+	/////////////////
+	/// Accessors ///
+	/////////////////
+
+	const Report& GetReport() { return m_Report; }
+
+private:
+
+	//////////////////
+	/// Operations ///
+	//////////////////
+
+	//Reads a texture file (run by workers)
+	void LoadFile(size_t fileIndex);
+	//Loads frame (and animation) data of an entry, once its texture file is read (run by workers)
+	void LoadEntry(size_t entryIndex);
+
+	//Runs job for each index in [0, count) across the given number of threads (on the calling thread if 1)
+	static void RunParallel(size_t count, unsigned workerCount, const std::function<void(size_t)>& job);
+
+	////////////
+	/// Data ///
+	////////////
+
+	std::vector<Entry> m_Entries;
+	//Distinct texture files
+	std::vector<TextureFile> m_Files;
+	//Per entry: file index, and loaded texture (nullptr if it failed)
+	std::vector<size_t> m_EntryFiles;
+	std::vector<std::unique_ptr<SpriteTexture>> m_Textures;
+
+	Report m_Report;
+};
@@ -0,0 +1,224 @@
+#include "TextureResidencyCache.h"
+
+//Library Includes
+#include <algorithm>
+#include <filesystem>
+
+//Utilities
+#include "Utils/Utils_Debug.h"
+
+//Engine Includes
+#include "IO/AssetPack.h"
+#include "Types/BE_SharedTypes.h"
+
+TextureResidencyCache::TextureResidencyCache(Loader& loader)
+	:m_Loader(loader)
+{
+}
+
+TextureResidencyCache::~TextureResidencyCache()
+{
+}
+
+void TextureResidencyCache::Track(SpriteTexture& texture, const TextureLoadPipeline::Entry& entry, bool pinned)
+{
+	//Retracking replaces the old record
+	Untrack(&texture);
+
+	Record record;
+	record.m_Texture = &texture;
+	record.m_Entry = entry;
+	record.m_Pinned = pinned;
+	//Counts as used now, so new textures aren't evicted before they get the chance to be drawn
+	record.m_LastUsedFrame = m_Frame;
+
+	//Files are sized once, from a mounted asset pack when the texture is in one
+	FileRecord& file = m_Files[entry.m_TextureFP];
+	if (file.m_TrackCount++ == 0)
+	{
+		AssetPack::View packed;
+		if (AssetPack::FindMounted(entry.m_TextureFP, packed))
+			file.m_Bytes = packed.m_Size;
+		else
+		{
+			std::error_code ec;
+			uintmax_t size = std::filesystem::file_size(entry.m_TextureFP, ec);
+			file.m_Bytes = ec ? 0 : static_cast<size_t>(size);
+		}
+	}
+	record.m_File = &file;
+
+	switch (m_Loader.GetState(texture))
+	{
+	case TextureStreamer::State::NONE:
+	case TextureStreamer::State::RESIDENT:
+		record.m_Residency = Residency::RESIDENT;
+		break;
+	case TextureStreamer::State::FAILED:
+		record.m_Residency = Residency::EVICTED;
+		record.m_Failed = true;
+		break;
+	case TextureStreamer::State::EVICTED:
+		record.m_Residency = Residency::EVICTED;
+		break;
+	default:
+		record.m_Residency = Residency::LOADING;
+		break;
+	}
+	if (record.m_Residency != Residency::EVICTED)
+		HoldFile(record);
+
+	m_Indexes[&texture] = m_Records.size();
+	m_Records.push_back(record);
+}
+
+void TextureResidencyCache::Untrack(const SpriteTexture* texture)
+{
+	auto it = m_Indexes.find(texture);
+	if (it == m_Indexes.end())
+		return;
+
+	size_t index = it->second;
+	Record& record = m_Records[index];
+	if (record.m_Residency != Residency::EVICTED)
+		ReleaseFile(record);
+	if (--record.m_File->m_TrackCount == 0)
+		m_Files.erase(record.m_Entry.m_TextureFP);
+
+	//Swap with last record
+	m_Indexes.erase(it);
+	if (index != m_Records.size() - 1)
+	{
+		m_Records[index] = m_Records.back();
+		m_Indexes[m_Records[index].m_Texture] = index;
+	}
+	m_Records.pop_back();
+}
+
+void TextureResidencyCache::Update()
+{
+	++m_Frame;
+
+	for (auto& record : m_Records)
+	{
+		//Check on loads
+		if (record.m_Residency == Residency::LOADING)
+		{
+			TextureStreamer::State state = m_Loader.GetState(*record.m_Texture);
+			if (state == TextureStreamer::State::NONE || state == TextureStreamer::State::RESIDENT)
+				record.m_Residency = Residency::RESIDENT;
+			else if (state == TextureStreamer::State::FAILED)
+			{
+				DBOUT("Update(): Failed to load texture, leaving evicted: " << record.m_Entry.m_Name);
+				record.m_Residency = Residency::EVICTED;
+				record.m_Failed = true;
+				ReleaseFile(record);
+				++m_Counters.m_FailedLoads;
+			}
+		}
+
+		//Gather use since the last update
+		if (!record.m_Texture->m_Used)
+			continue;
+		record.m_Texture->m_Used = false;
+		record.m_LastUsedFrame = m_Frame;
+
+		switch (record.m_Residency)
+		{
+		case Residency::RESIDENT:
+			++m_Counters.m_Hits;
+			break;
+
+		case Residency::LOADING:
+			++m_Counters.m_Misses;
+			break;
+
+		case Residency::EVICTED:
+			++m_Counters.m_Misses;
+			if (!record.m_Failed)
+			{
+				m_Loader.Reload(record.m_Entry, *record.m_Texture);
+				record.m_Residency = Residency::LOADING;
+				HoldFile(record);
+			}
+			break;
+		}
+	}
+
+	EvictToBudget();
+}
+
+TextureResidencyCache::Residency TextureResidencyCache::GetResidency(const SpriteTexture* texture)
+{
+	//Untracked textures are never evicted
+	auto it = m_Indexes.find(texture);
+	return it != m_Indexes.end() ? m_Records[it->second].m_Residency : Residency::RESIDENT;
+}
+
+void TextureResidencyCache::EvictToBudget()
+{
+	if (m_ResidentBytes <= m_Settings.m_BudgetBytes)
+		return;
+
+	//Evicting frees a file only once every texture holding it is evicted, so candidates are whole files
+	struct Candidate
+	{
+		std::vector<Record*> m_Records;
+		uint64_t m_LastUsedFrame = 0;
+		bool m_Blocked = false;
+	};
+	std::unordered_map<FileRecord*, Candidate> files;
+	for (auto& record : m_Records)
+	{
+		if (record.m_Residency == Residency::EVICTED)
+			continue;
+
+		Candidate& candidate = files[record.m_File];
+		candidate.m_Records.push_back(&record);
+		candidate.m_LastUsedFrame = std::max(candidate.m_LastUsedFrame, record.m_LastUsedFrame);
+		//Can't free files still loading, pinned or recently used
+		if (record.m_Residency != Residency::RESIDENT || record.m_Pinned || m_Frame - record.m_LastUsedFrame < m_Settings.m_MinUnusedFrames)
+			candidate.m_Blocked = true;
+	}
+
+	//Least recently used first
+	std::vector<Candidate*> candidates;
+	for (auto& file : files)
+	{
+		if (!file.second.m_Blocked)
+			candidates.push_back(&file.second);
+	}
+	std::sort(candidates.begin(), candidates.end(), [](const Candidate* a, const Candidate* b)
+	{
+		return a->m_LastUsedFrame < b->m_LastUsedFrame;
+	});
+
+	for (Candidate* candidate : candidates)
+	{
+		if (m_ResidentBytes <= m_Settings.m_BudgetBytes)
+			break;
+
+		for (Record* record : candidate->m_Records)
+		{
+			m_Loader.Evict(*record->m_Texture);
+			record->m_Residency = Residency::EVICTED;
+			m_Counters.m_BytesEvicted += ReleaseFile(*record);
+			++m_Counters.m_Evictions;
+		}
+	}
+}
+
+void TextureResidencyCache::HoldFile(Record& record)
+{
+	if (record.m_File->m_HoldCount++ == 0)
+		m_ResidentBytes += record.m_File->m_Bytes;
+}
+
+size_t TextureResidencyCache::ReleaseFile(Record& record)
+{
+	if (--record.m_File->m_HoldCount > 0)
+		return 0;
+
+	m_ResidentBytes -= record.m_File->m_Bytes;
+	return record.m_File->m_Bytes;
+}
@@ -0,0 +1,175 @@
+//*********************************************************************************\\
+//
+// Keeps texture memory within a budget. Tracks the last used frame of each
+// texture (sprites flag their texture as used when drawn, see
+// SpriteTexture::m_Used), and the byte size of each texture file (counted once
+// however many textures share it, e.g. atlas entries). Evicts the least recently
+// used textures whenever the resident total is over budget, and reloads evicted
+// textures asynchronously as soon as they are drawn again (drawing with the
+// placeholder until back).
+//
+// Eviction and reloading are done through a Loader, supplied by
+// Mgr_TextureResources (over TextureStreamer), so the cache itself can be run
+// headless.
+//
+//*********************************************************************************\\
+
+#pragma once
+
+//Library Includes
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+
+//Engine Includes
+#include "IO/TextureLoadPipeline.h"
+#include "IO/TextureStreamer.h"
+
+class TextureResidencyCache
+{
+public:
+
+	//////////////////////////////
+	/// Enums, Types & Statics ///
+	//////////////////////////////
+
+	/*
+		Evicts and reloads textures for the cache. Reloads are asynchronous, with GetState reporting their progress
+		(as TextureStreamer::State, with NONE or RESIDENT meaning the textures resource is in place).
+	*/
+	class Loader
+	{
+	public:
+		virtual ~Loader() { }
+
+		//Releases the textures resource (and heap slot), leaving it drawing with a placeholder
+		virtual void Evict(SpriteTexture& texture) = 0;
+		//Starts reloading an evicted textures resource from its entry
+		virtual void Reload(const TextureLoadPipeline::Entry& entry, SpriteTexture& texture) = 0;
+		virtual TextureStreamer::State GetState(const SpriteTexture& texture) = 0;
+	};
+
+	struct Settings
+	{
+		//Resident bytes to stay within (texture file sizes)
+		size_t m_BudgetBytes = 256 * 1024 * 1024;
+		//Frames a texture must go unused before it can be evicted (at least the frames in flight, so the GPU is done with it)
+		unsigned m_MinUnusedFrames = 3;
+	};
+
+	//Running totals, counted per texture per frame it is used (not per draw)
+	struct Counters
+	{
+		//Used while resident
+		size_t m_Hits = 0;
+		//Used while evicted (starting a reload), or still reloading
+		size_t m_Misses = 0;
+		size_t m_Evictions = 0;
+		size_t m_FailedLoads = 0;
+		size_t m_BytesEvicted = 0;
+	};
+
+	enum class Residency
+	{
+		RESIDENT,
+		EVICTED,
+		//Loading (initially, or after eviction)
+		LOADING
+	};
+
+	////////////////////
+	/// Constructors ///
+	////////////////////
+
+	TextureResidencyCache(Loader& loader);
+	~TextureResidencyCache();
+
+	//////////////////
+	/// Operations ///
+	//////////////////
+
+	/*
+		Starts tracking a texture (sized from its texture file, which counts once while any texture using it is resident).
+		Pinned textures are never evicted (e.g. the streaming placeholder). Texture must stay alive until untracked.
+	*/
+	void Track(SpriteTexture& texture, const TextureLoadPipeline::Entry& entry, bool pinned = false);
+	void Untrack(const SpriteTexture* texture);
+
+	/*
+		Call once per frame, before drawing. Gathers which textures were drawn since the last update (clearing their flag),
+		reloading any evicted ones, then evicts least recently used textures while over budget.
+	*/
+	void Update();
+
+	/////////////////
+	/// Accessors ///
+	/////////////////
+
+	Residency GetResidency(const SpriteTexture* texture);
+
+	void SetSettings(const Settings& settings) { m_Settings = settings; }
+	const Settings& GetSettings() { return m_Settings; }
+	const Counters& GetCounters() { return m_Counters; }
+	void ResetCounters() { m_Counters = Counters(); }
+
+	//Bytes of texture files held by resident (and loading) textures
+	size_t GetResidentBytes() { return m_ResidentBytes; }
+	size_t GetTrackedCount() { return m_Records.size(); }
+
+private:
+
+	//////////////////////////////
+	/// Enums, Types & Statics ///
+	//////////////////////////////
+
+	//Texture file shared by tracked textures (as textures using the same file share its resource)
+	struct FileRecord
+	{
+		size_t m_Bytes = 0;
+		//Tracked textures using the file, and those holding it (resident or loading)
+		unsigned m_TrackCount = 0;
+		unsigned m_HoldCount = 0;
+	};
+
+	struct Record
+	{
+		SpriteTexture* m_Texture = nullptr;
+		TextureLoadPipeline::Entry m_Entry;
+		FileRecord* m_File = nullptr;
+		uint64_t m_LastUsedFrame = 0;
+		Residency m_Residency = Residency::LOADING;
+		bool m_Pinned = false;
+		//Failed to load, so left evicted (drawing with the placeholder) rather than retried every frame it is drawn
+		bool m_Failed = false;
+	};
+
+	//////////////////
+	/// Operations ///
+	//////////////////
+
+	//Evicts least recently used files (all their textures unused long enough) until within budget
+	void EvictToBudget();
+
+	//Counts a texture as holding its file, adding the files bytes if it is the first
+	void HoldFile(Record& record);
+	//Stops a texture holding its file, returning the bytes freed (if it was the last)
+	size_t ReleaseFile(Record& record);
+
+	////////////
+	/// Data ///
+	////////////
+
+	Loader& m_Loader;
+	Settings m_Settings;
+	Counters m_Counters;
+
+	std::vector<Record> m_Records;
+	//Record index by texture
+	std::unordered_map<const SpriteTexture*, size_t> m_Indexes;
+	//Files by path (records point at these, which stay put as others are added)
+	std::unordered_map<std::string, FileRecord> m_Files;
+
+	size_t m_ResidentBytes = 0;
+	uint64_t m_Frame = 0;
+};
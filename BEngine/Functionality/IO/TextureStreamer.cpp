@@ -0,0 +1,328 @@
+#include "TextureStreamer.h"
+
+//Library Includes
+#include <chrono>
+#include <algorithm>
+
+//Utilities
+#include "Utils/Utils_Debug.h"
+
+//Engine Includes
+#include "Types/BE_SharedTypes.h"
+
+typedef std::chrono::high_resolution_clock Clock;
+
+static_assert(TextureStreamer::PLACEHOLDER_FRAME_COUNT >= SpriteTexture::MAX_FRAMES, "TextureStreamer: Placeholder must cover every frame index!");
+
+struct TextureStreamer::EvictedData
+{
+	ArrayView<SpriteFrame> m_Frames;
+	ArrayView<DirectX::XMFLOAT2> m_HullVertices;
+};
+
+bool TextureStreamer::StubUploadBackend::CreateTexture(const TextureLoadPipeline::TextureFile& file, SpriteTexture& outTex)
+{
+	return m_Creator.CreateTexture(file, outTex);
+}
+
+bool TextureStreamer::StubUploadBackend::LoadMetaData(const TextureLoadPipeline::Entry& entry, SpriteTexture& outTex)
+{
+	return TextureLoadPipeline::LoadMetaData(entry, outTex);
+}
+
+void TextureStreamer::StubUploadBackend::SwapIn(SpriteTexture& live, SpriteTexture& loaded, bool resourceOnly)
+{
+	live.m_TextureResource = std::move(loaded.m_TextureResource);
+	live.m_Heap = loaded.m_Heap;
+	live.m_HeapIndex = loaded.m_HeapIndex;
+	live.m_TexSize = loaded.m_TexSize;
+	if (resourceOnly)
+		return;
+
+	//Views stay valid when moving their storage (vector buffers move with them)
+	live.m_FrameStorage = std::move(loaded.m_FrameStorage);
+	live.m_HullVertexStorage = std::move(loaded.m_HullVertexStorage);
+	live.m_Frames = loaded.m_Frames;
+	live.m_HullVertices = loaded.m_HullVertices;
+	live.m_MetaFile = std::move(loaded.m_MetaFile);
+	live.m_Animations = std::move(loaded.m_Animations);
+}
+
+TextureStreamer::TextureStreamer(std::unique_ptr<UploadBackend> backend)
+	:m_Backend(std::move(backend))
+{
+	msg_assert(m_Backend != nullptr, "TextureStreamer(): No upload backend given!");
+	m_LoadThread = std::thread(&TextureStreamer::LoadLoop, this);
+}
+
+TextureStreamer::~TextureStreamer()
+{
+	//Stop background thread (abandoning anything it hasn't started)
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Stopping = true;
+	}
+	m_LoadSignal.notify_all();
+	m_LoadThread.join();
+}
+
+void TextureStreamer::SetPlaceholder(const SpriteTexture& source, unsigned frameIndex)
+{
+	msg_assert(frameIndex < source.m_Frames.size(), "SetPlaceholder(): Frame index OOR!");
+
+	m_Placeholder = std::make_unique<SpriteTexture>();
+	m_Placeholder->m_Name = source.m_Name;
+	m_Placeholder->m_TextureResource = source.m_TextureResource;
+	m_Placeholder->m_Heap = source.m_Heap;
+	m_Placeholder->m_HeapIndex = source.m_HeapIndex;
+	m_Placeholder->m_TexSize = source.m_TexSize;
+
+	//Frame copied (without any hull) so sprites on any frame index up to the count draw the placeholder
+	SpriteFrame frame = source.m_Frames[frameIndex];
+	frame.m_HullCount = 0;
+	frame.m_HullFirst = 0;
+	frame.m_HullCoverage = 1.f;
+	m_PlaceholderFrames.assign(PLACEHOLDER_FRAME_COUNT, frame);
+}
+
+void TextureStreamer::Request(const TextureLoadPipeline::Entry& entry, SpriteTexture& texture)
+{
+	msg_assert(m_Placeholder != nullptr, "Request(): No placeholder set!");
+
+	//Draw with placeholder until streamed in
+	texture.m_Name = entry.m_Name;
+	ApplyPlaceholder(texture);
+	texture.m_Frames = m_PlaceholderFrames;
+	texture.m_HullVertices = ArrayView<DirectX::XMFLOAT2>();
+
+	QueueRequest(entry, texture, false);
+}
+
+void TextureStreamer::Evict(SpriteTexture& texture)
+{
+	msg_assert(m_Placeholder != nullptr, "Evict(): No placeholder set!");
+
+	std::lock_guard<std::mutex> lock(m_Mutex);
+
+	//Keep views into the textures (still owned) data, then draw with the placeholder
+	std::unique_ptr<EvictedData>& evicted = m_Evicted[&texture];
+	evicted = std::make_unique<EvictedData>();
+	evicted->m_Frames = texture.m_Frames;
+	evicted->m_HullVertices = texture.m_HullVertices;
+
+	//Same number of frames as before, so sprites keep every frame they may be using
+	ApplyPlaceholder(texture);
+	texture.m_Frames = ArrayView<SpriteFrame>(m_PlaceholderFrames.data(), evicted->m_Frames.size());
+	texture.m_HullVertices = ArrayView<DirectX::XMFLOAT2>();
+
+	m_Finished[&texture] = State::EVICTED;
+	++m_Stats.m_Evicted;
+}
+
+void TextureStreamer::Reload(const TextureLoadPipeline::Entry& entry, SpriteTexture& texture)
+{
+	msg_assert(m_Evicted.count(&texture) > 0, "Reload(): Texture not evicted!");
+	QueueRequest(entry, texture, true);
+}
+
+void TextureStreamer::Update()
+{
+	auto start = Clock::now();
+	m_Stats.m_LastStarted = 0;
+	m_Stats.m_LastBytes = 0;
+
+	std::lock_guard<std::mutex> lock(m_Mutex);
+
+	//Swap in completed uploads (requests sharing a ticket are mostly together, so tickets are rarely checked twice)
+	uint64_t checkedTicket = 0;
+	bool ticketComplete = false;
+	for (auto& request : m_Requests)
+	{
+		if (request->m_State != State::UPLOADING)
+			continue;
+
+		if (request->m_Ticket != checkedTicket)
+		{
+			checkedTicket = request->m_Ticket;
+			ticketComplete = m_Backend->IsComplete(checkedTicket);
+		}
+		if (ticketComplete)
+		{
+			SwapIn(*request);
+			request->m_State = State::RESIDENT;
+			++m_Stats.m_Resident;
+		}
+	}
+
+	//Start uploads of loaded textures (in request order) until over budget
+	for (auto& request : m_Requests)
+	{
+		if (request->m_State != State::LOADED)
+			continue;
+
+		double elapsedMS = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+		if (m_Stats.m_LastStarted > 0 && (m_Stats.m_LastBytes + request->m_File.m_Size > m_Budget.m_Bytes || elapsedMS > m_Budget.m_Milliseconds))
+			break;
+
+		if (!m_Backend->CreateTexture(request->m_File, *request->m_Loaded))
+		{
+			DBOUT("Update(): Failed to create texture: " << request->m_Entry.m_Name);
+			request->m_State = State::FAILED;
+			++m_Stats.m_Failed;
+			continue;
+		}
+
+		m_Stats.m_LastBytes += request->m_File.m_Size;
+		++m_Stats.m_LastStarted;
+		request->m_State = State::UPLOADING;
+	}
+
+	//Send off this updates uploads together
+	if (m_Stats.m_LastStarted > 0)
+	{
+		uint64_t ticket = m_Backend->Submit();
+		for (auto& request : m_Requests)
+		{
+			if (request->m_State == State::UPLOADING && request->m_Ticket == 0)
+			{
+				request->m_Ticket = ticket;
+				//File data no longer needed once uploaded
+				TextureLoadPipeline::ReleaseTextureFile(request->m_File);
+			}
+		}
+	}
+	m_Stats.m_BytesUploaded += m_Stats.m_LastBytes;
+
+	//Retire finished requests
+	m_Requests.erase(std::remove_if(m_Requests.begin(), m_Requests.end(), [this](const std::unique_ptr<StreamRequest>& request)
+	{
+		if (request->m_State != State::RESIDENT && request->m_State != State::FAILED)
+			return false;
+		m_Finished[request->m_Texture] = request->m_State;
+		return true;
+	}), m_Requests.end());
+
+	m_Stats.m_LastMilliseconds = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+void TextureStreamer::Flush()
+{
+	while (!IsIdle())
+	{
+		Update();
+		std::this_thread::yield();
+	}
+}
+
+void TextureStreamer::Forget(const SpriteTexture* texture)
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	m_Finished.erase(texture);
+	m_Evicted.erase(texture);
+}
+
+TextureStreamer::State TextureStreamer::GetState(const SpriteTexture* texture)
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	for (auto& request : m_Requests)
+	{
+		if (request->m_Texture == texture)
+			return request->m_State;
+	}
+
+	auto it = m_Finished.find(texture);
+	return it != m_Finished.end() ? it->second : State::NONE;
+}
+
+bool TextureStreamer::IsIdle()
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	return m_Requests.empty();
+}
+
+void TextureStreamer::ApplyPlaceholder(SpriteTexture& texture)
+{
+	texture.m_TextureResource = m_Placeholder->m_TextureResource;
+	texture.m_Heap = m_Placeholder->m_Heap;
+	texture.m_HeapIndex = m_Placeholder->m_HeapIndex;
+	texture.m_TexSize = m_Placeholder->m_TexSize;
+}
+
+void TextureStreamer::QueueRequest(const TextureLoadPipeline::Entry& entry, SpriteTexture& texture, bool reload)
+{
+	std::unique_ptr<StreamRequest> request = std::make_unique<StreamRequest>();
+	request->m_Entry = entry;
+	request->m_Texture = &texture;
+	request->m_File.m_Filepath = entry.m_TextureFP;
+	request->m_Reload = reload;
+
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_LoadQueue.push_back(request.get());
+		m_Requests.push_back(std::move(request));
+		m_Finished.erase(&texture);
+	}
+	m_LoadSignal.notify_one();
+
+	++m_Stats.m_Requested;
+}
+
+void TextureStreamer::LoadLoop()
+{
+	while (true)
+	{
+		StreamRequest* request = nullptr;
+		{
+			std::unique_lock<std::mutex> lock(m_Mutex);
+			m_LoadSignal.wait(lock, [this]() { return m_Stopping || !m_LoadQueue.empty(); });
+			if (m_Stopping)
+				return;
+			request = m_LoadQueue.front();
+			m_LoadQueue.pop_front();
+		}
+
+		//Load outside the lock (request is only touched here until its state changes)
+		TextureLoadPipeline::TextureFile file;
+		file.m_Filepath = request->m_Entry.m_TextureFP;
+		std::unique_ptr<SpriteTexture> loaded = std::make_unique<SpriteTexture>();
+		loaded->m_Name = request->m_Entry.m_Name;
+
+		//Reloads only need the resource (frame and animation data was kept)
+		bool result = TextureLoadPipeline::ReadTextureFile(file);
+		if (result && !request->m_Reload)
+		{
+			loaded->m_TexSize = DirectX::XMUINT2(file.m_Width, file.m_Height);
+			result = m_Backend->LoadMetaData(request->m_Entry, *loaded);
+		}
+
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		if (result)
+		{
+			request->m_File = std::move(file);
+			request->m_Loaded = std::move(loaded);
+			request->m_State = State::LOADED;
+		}
+		else
+		{
+			DBOUT("LoadLoop(): Failed to load texture: " << request->m_Entry.m_Name);
+			request->m_State = State::FAILED;
+			++m_Stats.m_Failed;
+		}
+	}
+}
+
+void TextureStreamer::SwapIn(StreamRequest& request)
+{
+	SpriteTexture& live = *request.m_Texture;
+	m_Backend->SwapIn(live, *request.m_Loaded, request.m_Reload);
+	request.m_Loaded.reset();
+
+	//Reloads restore the data kept when evicted
+	if (request.m_Reload)
+	{
+		auto evicted = m_Evicted.find(&live);
+		live.m_Frames = evicted->second->m_Frames;
+		live.m_HullVertices = evicted->second->m_HullVertices;
+		m_Evicted.erase(evicted);
+	}
+}
@@ -0,0 +1,253 @@
+//*********************************************************************************\\
+//
+// Asynchronous texture streaming. Requested textures are handed out straight
+// away, drawing with a placeholder frame, while their files are read and parsed
+// on a background thread. Each frame (see Update), loaded textures are finalised
+// within a byte and time budget: their resources are created and uploaded
+// through an UploadBackend, and once the upload completes the textures data is
+// swapped for the real thing in place (so anything pointing at it picks it up).
+// Resident textures can also be evicted back to the placeholder, and reloaded
+// (see TextureResidencyCache).
+//
+// The streamer never touches the graphics API, or the storage of texture data,
+// itself. Both go through an UploadBackend: Mgr_TextureResources supplies a
+// D3D12 backend, and StubUploadBackend lets the whole state machine run
+// headless (see TextureStreamingBenchmark).
+//
+//*********************************************************************************\\
+
+#pragma once
+
+//Library Includes
+#include <string>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <unordered_map>
+
+//Engine Includes
+#include "IO/TextureLoadPipeline.h"
+
+//Forward Declarations
+struct SpriteTexture;
+struct SpriteFrame;
+
+class TextureStreamer
+{
+public:
+
+	//////////////////////////////
+	/// Enums, Types & Statics ///
+	//////////////////////////////
+
+	/*
+		Frames available to sprites using a texture that is yet to stream in (all the placeholder frame). Covers every
+		frame a texture can have (SpriteTexture::MAX_FRAMES), as the real frame count isn't known until it has loaded.
+	*/
+	static constexpr size_t PLACEHOLDER_FRAME_COUNT = 0xFFFF;
+
+	enum class State
+	{
+		//Not requested
+		NONE,
+		//Waiting for, or being loaded by, the background thread
+		LOADING,
+		//Loaded, waiting for budget to be created and uploaded
+		LOADED,
+		//Upload submitted, waiting for it to complete
+		UPLOADING,
+		//Real data in place
+		RESIDENT,
+		//Failed to load or create (keeps the placeholder)
+		FAILED,
+		//Resource released, drawing with the placeholder until reloaded (see Evict)
+		EVICTED
+	};
+
+	/*
+		Creates resources for streamed textures and uploads them, and owns how loaded data is moved into live textures.
+		Called on the thread calling Update, except for LoadMetaData. CreateTexture (see TextureLoadPipeline::TextureCreator)
+		should only queue uploads, which Submit then sends off together.
+	*/
+	class UploadBackend : public TextureLoadPipeline::TextureCreator
+	{
+	public:
+		//Submits uploads queued since the last submit, returning a ticket to check for their completion
+		virtual uint64_t Submit() = 0;
+		//Checks if uploads of the given ticket are complete (and their resources safe to use). Checked once per update.
+		virtual bool IsComplete(uint64_t ticket) = 0;
+
+		//Loads frame and animation data of the entry into the texture (size already set). Called on the background thread.
+		virtual bool LoadMetaData(const TextureLoadPipeline::Entry& entry, SpriteTexture& outTex) = 0;
+		/*
+			Moves the uploaded resource into the live texture, along with the loaded frame and animation data unless
+			only the resource was reloaded. Called once the uploads ticket completes.
+		*/
+		virtual void SwapIn(SpriteTexture& live, SpriteTexture& loaded, bool resourceOnly) = 0;
+	};
+
+	//Backend that makes no resources, with uploads completing after being checked the given number of updates (for headless runs)
+	class StubUploadBackend : public UploadBackend
+	{
+	public:
+		StubUploadBackend(unsigned latency = 1)
+			:m_Latency(latency)
+		{}
+
+		bool CreateTexture(const TextureLoadPipeline::TextureFile& file, SpriteTexture& outTex) override;
+		uint64_t Submit() override { m_Checks.push_back(0); return m_Checks.size(); }
+		bool IsComplete(uint64_t ticket) override { return ++m_Checks[ticket - 1] >= m_Latency; }
+		bool LoadMetaData(const TextureLoadPipeline::Entry& entry, SpriteTexture& outTex) override;
+		void SwapIn(SpriteTexture& live, SpriteTexture& loaded, bool resourceOnly) override;
+
+	private:
+		TextureLoadPipeline::StubTextureCreator m_Creator;
+		unsigned m_Latency = 1;
+		//Times each ticket has been checked
+		std::vector<unsigned> m_Checks;
+	};
+
+	//Limits on finalising per update (at least one texture is always started, so large textures still get through)
+	struct Budget
+	{
+		//Texture file bytes uploaded
+		size_t m_Bytes = 8 * 1024 * 1024;
+		//Time spent creating resources (milliseconds)
+		double m_Milliseconds = 2.0;
+	};
+
+	//Running totals (and last update figures)
+	struct Stats
+	{
+		unsigned m_Requested = 0;
+		unsigned m_Resident = 0;
+		unsigned m_Failed = 0;
+		unsigned m_Evicted = 0;
+		size_t m_BytesUploaded = 0;
+		//Last update
+		unsigned m_LastStarted = 0;
+		size_t m_LastBytes = 0;
+		double m_LastMilliseconds = 0.0;
+	};
+
+	////////////////////
+	/// Constructors ///
+	////////////////////
+
+	TextureStreamer(std::unique_ptr<UploadBackend> backend);
+	~TextureStreamer();
+
+	//////////////////
+	/// Operations ///
+	//////////////////
+
+	/*
+		Sets the placeholder drawn with until textures stream in (resource and a single frame of a loaded texture).
+		Must be set before requesting.
+	*/
+	void SetPlaceholder(const SpriteTexture& source, unsigned frameIndex);
+
+	/*
+		Starts streaming the entry into the given texture, which is set up to draw with the placeholder straight away.
+		Texture must stay alive (at the same address) until it is resident or failed.
+		Animations arrive with the rest of the data, so the texture has none until resident (animators should
+		wait for that, see GetState, as setting an animation before then fails).
+	*/
+	void Request(const TextureLoadPipeline::Entry& entry, SpriteTexture& texture);
+
+	/*
+		Swaps a resident textures resource for the placeholders, so its own can be released (the caller releases it, along
+		with its heap slot). Frames are viewed as the placeholder frame (as many as the texture has), while the frame and
+		animation data are kept, so pointers into them stay valid while evicted.
+	*/
+	void Evict(SpriteTexture& texture);
+	//Streams an evicted textures resource back in from the entry (only the texture file is read, as its data was kept)
+	void Reload(const TextureLoadPipeline::Entry& entry, SpriteTexture& texture);
+
+	//Finalises loaded textures within budget, and swaps in those whose uploads have completed. Call once per frame.
+	void Update();
+
+	//Updates until nothing is in flight (for shutdown, or where streaming must be waited on)
+	void Flush();
+	//Drops the recorded state of a texture no longer in flight (for when it is released, as its address may be reused)
+	void Forget(const SpriteTexture* texture);
+
+	/////////////////
+	/// Accessors ///
+	/////////////////
+
+	//State of a texture (NONE if it wasn't streamed)
+	State GetState(const SpriteTexture* texture);
+	//True if no requests are in flight
+	bool IsIdle();
+
+	void SetBudget(const Budget& budget) { m_Budget = budget; }
+	const Budget& GetBudget() { return m_Budget; }
+	const Stats& GetStats() { return m_Stats; }
+
+private:
+
+	//////////////////////////////
+	/// Enums, Types & Statics ///
+	//////////////////////////////
+
+	struct StreamRequest
+	{
+		TextureLoadPipeline::Entry m_Entry;
+		//Live texture (handed out), and the texture loaded into by the background thread
+		SpriteTexture* m_Texture = nullptr;
+		std::unique_ptr<SpriteTexture> m_Loaded;
+		TextureLoadPipeline::TextureFile m_File;
+		State m_State = State::LOADING;
+		uint64_t m_Ticket = 0;
+		//Reloading an evicted texture (resource only)
+		bool m_Reload = false;
+	};
+
+	//Views an evicted texture had in place of the placeholders, restored on reload (see TextureStreamer.cpp)
+	struct EvictedData;
+
+	//////////////////
+	/// Operations ///
+	//////////////////
+
+	//Sets the texture to draw with the placeholder
+	void ApplyPlaceholder(SpriteTexture& texture);
+	//Queues a request for the background thread
+	void QueueRequest(const TextureLoadPipeline::Entry& entry, SpriteTexture& texture, bool reload);
+
+	//Background thread loop, loading queued requests
+	void LoadLoop();
+	//Moves loaded data into the live texture (through the backend)
+	void SwapIn(StreamRequest& request);
+
+	////////////
+	/// Data ///
+	////////////
+
+	std::unique_ptr<UploadBackend> m_Backend;
+
+	//Placeholder texture (resource and frames copied into requested textures)
+	std::unique_ptr<SpriteTexture> m_Placeholder;
+	std::vector<SpriteFrame> m_PlaceholderFrames;
+
+	//Requests in flight (in request order), and those waiting for the background thread
+	std::vector<std::unique_ptr<StreamRequest>> m_Requests;
+	std::deque<StreamRequest*> m_LoadQueue;
+	//States of textures no longer in flight
+	std::unordered_map<const SpriteTexture*, State> m_Finished;
+	//Evicted textures data (kept until reloaded)
+	std::unordered_map<const SpriteTexture*, std::unique_ptr<EvictedData>> m_Evicted;
+
+	//Guards load queue and request states/loaded data shared with the background thread
+	std::mutex m_Mutex;
+	std::condition_variable m_LoadSignal;
+	std::thread m_LoadThread;
+	bool m_Stopping = false;
+
+	Budget m_Budget;
+	Stats m_Stats;
+};
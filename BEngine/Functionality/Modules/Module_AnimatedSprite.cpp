@@ -7,20 +7,34 @@
 #include "Game.h"							//Timer Access/Knowledge
 #include "Managers/Mgr_Box2DPhysics.h"
 #include "Includes/BE_All_Modules.h"
+#include "Types/BE_Snapshot.h"
+#include "Transforms/TransformHierarchy2D.h"
+
+Module_AnimatedSprite::~Module_AnimatedSprite()
+{
+	if (m_AnimSystem)
+		m_AnimSystem->RemoveAnimator(m_AnimSystemID);
+}
 
 void Module_AnimatedSprite::Update_Main(System& sys)
 {
-	m_Animator.Update(sys.m_GameTime->DeltaTime());
+	//Registered sprites are advanced by the animation system instead
+	if (!m_AnimSystem)
+		m_Animator.Update(sys.m_GameTime->DeltaTime());
 }
 
 void Module_AnimatedSprite::Render(System& sys)
 {
+	//Read bound transform (if any) before drawing
+	ReadWorldTransform();
 	//Use draw call from sprite data
 	m_SprData.Draw();
 }
 
 void Module_AnimatedSprite::Render(System& sys, DirectX::SpriteBatch* batch)
 {
+	//Read bound transform (if any) before drawing
+	ReadWorldTransform();
 	//Use given batch in draw
 	m_SprData.Draw(batch);
 }
@@ -82,3 +96,68 @@ void Module_AnimatedSprite::SyncModulePosition(Module_Interface* otherMod)
 		
 	}
 }
+
+bool Module_AnimatedSprite::UseAnimationSystem(SpriteAnimationSystem* system)
+{
+	if (!system || m_AnimSystem)
+	{
+		msg_assert(false, "UseAnimationSystem(): No system given, or already using one!");
+		return false;
+	}
+
+	m_AnimSystemID = system->AddAnimator(&m_SprData);
+	m_AnimSystem = system;
+
+	//Carry over the animators state (if it has an animation set)
+	const AnimationData* anim = m_Animator.GetCurrentAnimation();
+	if (!anim)
+		return true;
+
+	if (!system->SetAnimation(m_AnimSystemID, anim->m_ContainerIndex, false, true, m_Animator.GetLoopState(), m_Animator.GetReverse()))
+		return true;
+
+	system->SetAnimationSpeedMod(m_AnimSystemID, m_Animator.GetAnimationSpeedMod());
+	//System frames count from the start of the animation (GetRelativeCurrentFrame counts in the direction of play)
+	int relativeFrame = m_Animator.GetCurrentFrame();
+	if (anim->m_TypeID == AnimationData::AnimID::LINEAR_FRAMES)
+		relativeFrame -= anim->m_StartFrame;
+	system->SetRelativeFrame(m_AnimSystemID, relativeFrame);
+	system->SetPlay(m_AnimSystemID, m_Animator.GetPlayState());
+	if (m_Animator.GetAnimationLockState())
+		system->EnableAnimationLock(m_AnimSystemID);
+
+	return true;
+}
+
+void Module_AnimatedSprite::ReadWorldTransform()
+{
+	if (const Transform2D* transform = GetWorldTransform())
+	{
+		m_SprData.m_Position = transform->m_Position;
+		m_SprData.m_Rotation = transform->m_Rotation;
+	}
+}
+
+void Module_AnimatedSprite::SaveSnapshot(SnapshotWriter& writer)
+{
+	Module_Interface::SaveSnapshot(writer);
+	//Sprite first, as animator looks up animation via the sprites texture
+	m_SprData.SaveSnapshot(writer);
+	m_Animator.SaveSnapshot(writer);
+}
+
+bool Module_AnimatedSprite::LoadSnapshot(SnapshotReader& reader, bool apply)
+{
+	//Read sprite into a copy, as the animator may still fail after it (looking up animations via the unchanged texture)
+	Flags flags;
+	SpriteData sprData(m_SprData);
+	if (!reader.Read(flags) || !sprData.LoadSnapshot(reader, apply) || !m_Animator.LoadSnapshot(reader, apply))
+		return false;
+
+	if (apply)
+	{
+		m_Flags = flags;
+		m_SprData = sprData;
+	}
+	return true;
+}
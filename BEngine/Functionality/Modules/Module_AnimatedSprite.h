@@ -11,6 +11,7 @@
 #include "Module_Interface.h"
 
 #include "Types/BE_SharedTypes.h"		//Sprite+Animator
+#include "Animation/SpriteAnimationSystem.h"	//Optional batched animation
 
 //
 //Forward Declarations
@@ -43,6 +44,8 @@ public:
 		//Set texture
 		m_SprData.SetTexture(tex);
 	}
+	//Removes sprite from the animation system (if using it)
+	~Module_AnimatedSprite();
 
 
 	/////////////////
@@ -53,7 +56,7 @@ public:
 	//Main Update Cycles
 	//
 	
-	//Updates the animation timer
+	//Updates the animation timer (unless animated by an animation system)
 	void Update_Main(System& sys) override;
 	void Render(System& sys) override;
 	void Render(System& sys, DirectX::SpriteBatch* batch) override;
@@ -76,6 +79,28 @@ public:
 	void SyncWithRigidBody(Module_Box2D_RigidBody2D& rigidbody);
 
 	void SyncModulePosition(Module_Interface* otherMod) override;
+	//Reads position and rotation from the bound world transform (if bound)
+	void ReadWorldTransform() override;
+
+	//
+	//Animation System
+	//
+
+	/*
+		Hands animation of this sprite over to the given system, carrying over the current animation, frame, speed
+		modifier and playback state of the animator (speed is re-read from the animation). The system then advances
+		the sprite in its batched update, so Update_Main no longer updates the animator, and further control goes
+		through the system using GetAnimationSystemID(). The system is owned and updated by the caller, and must
+		outlive the module. Snapshots still cover the animator only.
+	*/
+	bool UseAnimationSystem(SpriteAnimationSystem* system);
+
+	//
+	//Snapshots
+	//
+
+	void SaveSnapshot(SnapshotWriter& writer) override;
+	bool LoadSnapshot(SnapshotReader& reader, bool apply) override;
 
 
 	/////////////////
@@ -84,13 +109,12 @@ public:
 
 	SpriteAnimator& GetAnimator() { return m_Animator; }
 	SpriteData& GetSpriteData() { return m_SprData; }
+	//Animation system this sprite is registered with (nullptr if animated by its own animator)
+	SpriteAnimationSystem* GetAnimationSystem() { return m_AnimSystem; }
+	SpriteAnimationSystem::AnimatorID GetAnimationSystemID() { return m_AnimSystemID; }
 
 private:
 
-	//////////////////
-	/// Operations ///
-	//////////////////
-
 	////////////
 	/// Data ///
 	////////////
@@ -99,4 +123,7 @@ private:
 	SpriteAnimator m_Animator;
 	//Core sprite data and behaviours
 	SpriteData m_SprData;
+	//Batched animation system and the sprites ID within it (if registered)
+	SpriteAnimationSystem* m_AnimSystem = nullptr;
+	SpriteAnimationSystem::AnimatorID m_AnimSystemID = SpriteAnimationSystem::INVALID_ID;
 };
\ No newline at end of file
@@ -0,0 +1,43 @@
+#include "Module_Arena.h"
+
+#include "Utils/Utils_Debug.h"
+
+ModuleArena::Counters ModuleArena::s_GlobalCounters;
+
+void* ModuleArena::Allocate(size_t size, size_t alignment)
+{
+	//Blocks are allocated with new[], so can't guarantee anything beyond this
+	msg_assert(alignment <= alignof(std::max_align_t), "Allocate(): Alignment not supported!");
+
+	//Align current position
+	size_t offset = (m_Offset + alignment - 1) & ~(alignment - 1);
+
+	//Not enough room (or no block yet), so start a new one
+	if (m_Blocks.empty() || offset + size > m_CurrentSize)
+	{
+		m_CurrentSize = size > m_BlockSize ? size : m_BlockSize;
+		m_Blocks.push_back(std::make_unique<unsigned char[]>(m_CurrentSize));
+		offset = 0;
+
+		++m_Counters.m_HeapAllocations;
+		++s_GlobalCounters.m_HeapAllocations;
+		m_Counters.m_BytesReserved += m_CurrentSize;
+		s_GlobalCounters.m_BytesReserved += m_CurrentSize;
+	}
+
+	void* ptr = m_Blocks.back().get() + offset;
+	m_Offset = offset + size;
+
+	++m_Counters.m_ModuleAllocations;
+	++s_GlobalCounters.m_ModuleAllocations;
+	m_Counters.m_BytesUsed += size;
+	s_GlobalCounters.m_BytesUsed += size;
+
+	return ptr;
+}
+
+void ModuleArena::RecordHeapAllocation()
+{
+	++s_GlobalCounters.m_ModuleAllocations;
+	++s_GlobalCounters.m_HeapAllocations;
+}
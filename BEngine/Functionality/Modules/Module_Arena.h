@@ -0,0 +1,127 @@
+//*********************************************************************************\\
+//
+// Monotonic arena for module allocations. Modules (and their shared_ptr control
+// blocks) added to an actor with an arena are packed next to each other in large
+// blocks, rather than each being a separate heap allocation.
+//
+// Memory is only released when the arena itself is. Allocators hold a reference
+// to the arena, so it lives as long as any module allocated from it (which keeps
+// copied actors that share modules safe). An arena can be given to a single actor
+// or shared across a pool of actors.
+//
+//*********************************************************************************\\
+
+#pragma once
+
+//Library Includes
+#include <vector>
+#include <memory>
+#include <cstddef>
+
+class ModuleArena
+{
+public:
+
+	//////////////////////////////
+	/// Enums, Types & Statics ///
+	//////////////////////////////
+
+	/*
+		Allocation counters, kept per arena and globally (for all module allocations, with or without an arena).
+	*/
+	struct Counters
+	{
+		//Number of modules allocated
+		size_t m_ModuleAllocations = 0;
+		//Number of allocations made from the heap (blocks for arenas, each module otherwise)
+		size_t m_HeapAllocations = 0;
+		//Bytes handed out to modules (arena allocations only)
+		size_t m_BytesUsed = 0;
+		//Bytes allocated for blocks (arena allocations only)
+		size_t m_BytesReserved = 0;
+	};
+
+	static constexpr size_t DEFAULT_BLOCK_SIZE = 1024;
+
+	////////////////////
+	/// Constructors ///
+	////////////////////
+
+	ModuleArena(size_t blockSize = DEFAULT_BLOCK_SIZE)
+		:m_BlockSize(blockSize)
+	{}
+	~ModuleArena() { }
+
+	ModuleArena(const ModuleArena&) = delete;
+	ModuleArena& operator=(const ModuleArena&) = delete;
+
+	//////////////////
+	/// Operations ///
+	//////////////////
+
+	/*
+		Returns aligned memory from the current block, starting a new block if there is not enough room.
+		Requests larger than the block size get their own block.
+	*/
+	void* Allocate(size_t size, size_t alignment);
+
+	//Records module allocated from the heap (for when no arena is used)
+	static void RecordHeapAllocation();
+
+	/////////////////
+	/// Accessors ///
+	/////////////////
+
+	const Counters& GetCounters() { return m_Counters; }
+	static const Counters& GetGlobalCounters() { return s_GlobalCounters; }
+	static void ResetGlobalCounters() { s_GlobalCounters = Counters(); }
+
+	size_t GetBlockCount() { return m_Blocks.size(); }
+
+private:
+
+	////////////
+	/// Data ///
+	////////////
+
+	std::vector<std::unique_ptr<unsigned char[]>> m_Blocks;
+
+	size_t m_BlockSize = DEFAULT_BLOCK_SIZE;
+	//Size of, and position within, the current block
+	size_t m_CurrentSize = 0;
+	size_t m_Offset = 0;
+
+	Counters m_Counters;
+	static Counters s_GlobalCounters;
+};
+
+/*
+	Standard allocator over an arena, for use with std::allocate_shared. Deallocation is a no-op,
+	with memory reclaimed when the arena is released.
+*/
+template<class T>
+class ModuleArenaAllocator
+{
+public:
+
+	typedef T value_type;
+
+	ModuleArenaAllocator(std::shared_ptr<ModuleArena> arena)
+		:m_Arena(std::move(arena))
+	{}
+	template<class U>
+	ModuleArenaAllocator(const ModuleArenaAllocator<U>& other)
+		:m_Arena(other.m_Arena)
+	{}
+
+	T* allocate(size_t count) { return static_cast<T*>(m_Arena->Allocate(count * sizeof(T), alignof(T))); }
+	void deallocate(T* ptr, size_t count) { }
+
+	template<class U>
+	bool operator==(const ModuleArenaAllocator<U>& other) const { return m_Arena == other.m_Arena; }
+	template<class U>
+	bool operator!=(const ModuleArenaAllocator<U>& other) const { return m_Arena != other.m_Arena; }
+
+	//Keeps the arena alive for as long as anything allocated from it
+	std::shared_ptr<ModuleArena> m_Arena;
+};
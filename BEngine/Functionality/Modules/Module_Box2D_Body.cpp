@@ -8,6 +8,7 @@
 //Engine Includes
 #include "Actors/Actor2D_Interface.h"
 #include "Managers/Mgr_Box2DPhysics.h"
+#include "Types/BE_Snapshot.h"
 
 //Modules
 #include "Module_Sprite.h"
@@ -126,3 +127,64 @@ Box2D_UserData_Interface* Module_Box2D_RigidBody2D::GetBodyUserData()
 	msg_assert(false, "GetBodyUserData(): Body not created, cannot return data!");
 	return nullptr;
 }
+
+void Module_Box2D_RigidBody2D::SaveSnapshot(SnapshotWriter& writer)
+{
+	Module_Interface::SaveSnapshot(writer);
+
+	//Store body state (or flag that no body was present)
+	bool hasBody = m_Body != nullptr;
+	writer.Write(hasBody);
+	if (!hasBody)
+		return;
+
+	writer.Write(m_Body->GetTransform());
+	writer.Write(m_Body->GetLinearVelocity());
+	writer.Write(m_Body->GetAngularVelocity());
+	writer.Write(m_Body->IsAwake());
+	writer.Write(m_Body->IsEnabled());
+}
+
+bool Module_Box2D_RigidBody2D::LoadSnapshot(SnapshotReader& reader, bool apply)
+{
+	Flags flags;
+	bool hasBody = false;
+	if (!reader.Read(flags) || !reader.Read(hasBody))
+		return false;
+
+	//Nothing else stored
+	if (!hasBody)
+	{
+		if (apply)
+			m_Flags = flags;
+		return true;
+	}
+
+	b2Transform transform;
+	b2Vec2 linearVel;
+	float angularVel = 0.f;
+	bool isAwake = false;
+	bool isEnabled = false;
+	if (!reader.Read(transform) || !reader.Read(linearVel) || !reader.Read(angularVel) ||
+		!reader.Read(isAwake) || !reader.Read(isEnabled))
+		return false;
+
+	//Body is a resource, so is expected to already exist
+	if (!m_Body)
+	{
+		msg_assert(false, "LoadSnapshot(): No body attached to restore onto!");
+		return false;
+	}
+
+	if (!apply)
+		return true;
+
+	m_Flags = flags;
+	m_Body->SetTransform(transform.p, transform.q.GetAngle());
+	m_Body->SetLinearVelocity(linearVel);
+	m_Body->SetAngularVelocity(angularVel);
+	m_Body->SetEnabled(isEnabled);
+	m_Body->SetAwake(isAwake);
+
+	return true;
+}
@@ -88,6 +88,13 @@ public:
 
 	void SyncModulePosition(Module_Interface* otherMod) override;
 
+	//
+	//Snapshots
+	//
+
+	void SaveSnapshot(SnapshotWriter& writer) override;
+	bool LoadSnapshot(SnapshotReader& reader, bool apply) override;
+
 	//////////////////
 	/// Operations ///
 	//////////////////
@@ -3,6 +3,8 @@
 #include "Utils/Utils_Debug.h"
 
 #include "Actors/Actor2D_Interface.h"
+#include "Transforms/TransformHierarchy2D.h"
+#include "Types/BE_Snapshot.h"
 
 void Module_Interface::ReSyncWithActor(Actor2D_Interface* actor)
 {
@@ -25,3 +27,41 @@ bool Module_Interface::BindActor(Actor2D_Interface* actor)
 	m_Actor = actor;
 	return true;
 }
+
+void Module_Interface::SaveSnapshot(SnapshotWriter& writer)
+{
+	writer.Write(m_Flags);
+}
+
+bool Module_Interface::LoadSnapshot(SnapshotReader& reader, bool apply)
+{
+	Flags flags;
+	if (!reader.Read(flags))
+		return false;
+
+	if (apply)
+		m_Flags = flags;
+	return true;
+}
+
+void Module_Interface::BindTransform(TransformHierarchy2D* hierarchy, unsigned transformID)
+{
+	msg_assert(hierarchy && hierarchy->IsValidID(transformID), "BindTransform(): Invalid hierarchy or transform ID!");
+
+	m_Transform.m_Hierarchy = hierarchy;
+	m_Transform.m_ID = transformID;
+}
+
+void Module_Interface::UnbindTransform()
+{
+	m_Transform.m_Hierarchy = nullptr;
+	m_Transform.m_ID = 0xFFFFFFFF;
+}
+
+const Transform2D* Module_Interface::GetWorldTransform()
+{
+	if (!m_Transform.m_Hierarchy)
+		return nullptr;
+
+	return &m_Transform.m_Hierarchy->GetWorldTransform(m_Transform.m_ID);
+}
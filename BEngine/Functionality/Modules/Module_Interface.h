@@ -15,6 +15,10 @@
 
 //Forward Declarations
 class Actor2D_Interface;
+class TransformHierarchy2D;
+struct Transform2D;
+class SnapshotWriter;
+class SnapshotReader;
 struct System;
 
 class Module_Interface
@@ -134,6 +138,21 @@ public:
 	*/
 	virtual void SyncModulePosition(Module_Interface* otherMod) {}
 
+	//
+	//Snapshots
+	//
+
+	/*
+		Writes the modules state into the snapshot (called by the owning actor within a section for this module).
+		Derived modules should call the parent version first, then append their own data. Resources (textures, 
+		batches, fonts etc) aren't stored, so loading is done onto modules that are already setup.
+		Loading reads into temporaries and only applies them once everything is read, so a failed load leaves
+		the module as it was. With apply false the data is only read and checked, letting a whole snapshot be
+		validated before anything in it is applied.
+	*/
+	virtual void SaveSnapshot(SnapshotWriter& writer);
+	virtual bool LoadSnapshot(SnapshotReader& reader, bool apply);
+
 	//////////////////
 	/// Operations ///
 	//////////////////
@@ -141,6 +160,16 @@ public:
 	//Binds an actor to this module (this should be the owning actor)
 	bool BindActor(Actor2D_Interface* actor);
 
+	/*
+		Binds the module to a transform within the given hierarchy. When bound, positional modules read their
+		position (and rotation where relevant) from the cached world transform instead of needing to be synced
+		with other modules manually (see SyncModulePosition).
+	*/
+	void BindTransform(TransformHierarchy2D* hierarchy, unsigned transformID);
+	void UnbindTransform();
+	//Reads the bound world transform into the modules own data (if bound). Done before drawing, or anything reading positions then.
+	virtual void ReadWorldTransform() { }
+
 	/////////////////
 	/// Accessors ///
 	/////////////////
@@ -149,6 +178,9 @@ public:
 	ModuleTypeID GetType() { return m_TypeID; }
 	Flags& GetFlags() { return m_Flags; }
 
+	bool HasTransform() { return m_Transform.m_Hierarchy != nullptr; }
+	unsigned GetTransformID() { return m_Transform.m_ID; }
+
 protected:
 
 	////////////////////
@@ -160,6 +192,13 @@ protected:
 		:m_Actor(actor), m_Name(name), m_TypeID(type)
 	{}
 
+	//////////////////
+	/// Operations ///
+	//////////////////
+
+	//Returns the bound world transform (updating the hierarchy if dirty), or nullptr if not bound
+	const Transform2D* GetWorldTransform();
+
 	////////////
 	/// Data ///
 	////////////
@@ -172,4 +211,11 @@ protected:
 	Actor2D_Interface* m_Actor = nullptr;
 	//Module flags
 	Flags m_Flags;
+
+	//Optionally bound transform (see BindTransform)
+	struct
+	{
+		TransformHierarchy2D* m_Hierarchy = nullptr;
+		unsigned m_ID = 0xFFFFFFFF;
+	} m_Transform;
 };
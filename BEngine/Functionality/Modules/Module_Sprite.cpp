@@ -6,6 +6,8 @@
 //Engine Includes
 #include "Managers/Mgr_Box2DPhysics.h"
 #include "Includes/BE_All_Modules.h"
+#include "Types/BE_Snapshot.h"
+#include "Transforms/TransformHierarchy2D.h"
 
 Module_Sprite::Module_Sprite(Actor2D_Interface* actor, std::string& moduleName, SpriteTexture* tex, DirectX::SpriteBatch* batch)
 	:Module_Interface(actor, moduleName, ModuleTypeID::SPRITE)
@@ -17,12 +19,16 @@ Module_Sprite::Module_Sprite(Actor2D_Interface* actor, std::string& moduleName,
 
 void Module_Sprite::Render(System& sys)
 {
+	//Read bound transform (if any) before drawing
+	ReadWorldTransform();
 	//Use draw call from sprite data
 	m_SprData.Draw();
 }
 
 void Module_Sprite::Render(System& sys, DirectX::SpriteBatch* batch)
 {
+	//Read bound transform (if any) before drawing
+	ReadWorldTransform();
 	//Use given batch in draw
 	m_SprData.Draw(batch);
 }
@@ -77,3 +83,30 @@ void Module_Sprite::SyncWithRigidBody(Module_Box2D_RigidBody2D& rigidbody)
 	//Update sprite new rotation (inverted due to coord system differences)
 	m_SprData.m_Rotation = -rigidbody.GetBody()->GetAngle();
 }
+
+void Module_Sprite::ReadWorldTransform()
+{
+	if (const Transform2D* transform = GetWorldTransform())
+	{
+		m_SprData.m_Position = transform->m_Position;
+		m_SprData.m_Rotation = transform->m_Rotation;
+	}
+}
+
+void Module_Sprite::SaveSnapshot(SnapshotWriter& writer)
+{
+	Module_Interface::SaveSnapshot(writer);
+	m_SprData.SaveSnapshot(writer);
+}
+
+bool Module_Sprite::LoadSnapshot(SnapshotReader& reader, bool apply)
+{
+	//Sprite data is applied only if fully read, so read it last
+	Flags flags;
+	if (!reader.Read(flags) || !m_SprData.LoadSnapshot(reader, apply))
+		return false;
+
+	if (apply)
+		m_Flags = flags;
+	return true;
+}
@@ -68,6 +68,15 @@ public:
 	//
 
 	void SyncModulePosition(Module_Interface* otherMod) override;
+	//Reads position and rotation from the bound world transform (if bound)
+	void ReadWorldTransform() override;
+
+	//
+	//Snapshots
+	//
+
+	void SaveSnapshot(SnapshotWriter& writer) override;
+	bool LoadSnapshot(SnapshotReader& reader, bool apply) override;
 
 	//////////////////
 	/// Operations ///
@@ -88,10 +97,6 @@ public:
 
 private:
 
-	//////////////////
-	/// Operations ///
-	//////////////////
-	
 	////////////
 	/// Data ///
 	////////////
@@ -7,12 +7,18 @@
 #include "Game.h"
 #include "Includes/BE_All_Managers.h"
 #include "Includes/BE_All_Modules.h"
+#include "Types/BE_Snapshot.h"
+#include "Transforms/TransformHierarchy2D.h"
 
 void Module_UI_MouseCollider::Update_Main(System& sys)
 {
 	//Store current hover status
 	m_WasHovered = m_IsHovering;
 
+	//If bound to a transform, take position from it before testing
+	if (const Transform2D* transform = GetWorldTransform())
+		SetPosition(transform->m_Position.x, transform->m_Position.y);
+
 	//Get the mouse position
 	Vec2 pos = sys.m_KBMMgr->GetMouseRelativePosition();
 
@@ -156,3 +162,85 @@ void Module_UI_MouseCollider::SetPosition(float x, float y)
 
 	}
 }
+
+void Module_UI_MouseCollider::SaveSnapshot(SnapshotWriter& writer)
+{
+	Module_Interface::SaveSnapshot(writer);
+
+	writer.Write(m_Type);
+	switch (m_Type)
+	{
+	case ColliderType::BOX:
+		writer.Write(std::get<DirectX::BoundingBox>(m_Collider));
+		break;
+
+	case ColliderType::CIRCLE:
+		writer.Write(std::get<DirectX::BoundingSphere>(m_Collider));
+		break;
+	}
+
+	writer.Write(m_DepthLevel);
+	writer.Write(m_HoverElapsed);
+	writer.Write(m_IsHovering);
+	writer.Write(m_WasHovered);
+	writer.Write(m_PairedObjectData.m_ObjectTypeID);
+	writer.Write(m_PairedObjectData.m_ObjectID);
+}
+
+bool Module_UI_MouseCollider::LoadSnapshot(SnapshotReader& reader, bool apply)
+{
+	Flags flags;
+	ColliderType type = ColliderType::UNDEFINED;
+	if (!reader.Read(flags) || !reader.Read(type))
+		return false;
+
+	//Read collider based on type
+	std::variant<DirectX::BoundingBox, DirectX::BoundingSphere> collider = m_Collider;
+	switch (type)
+	{
+	case ColliderType::BOX:
+	{
+		DirectX::BoundingBox box;
+		if (!reader.Read(box))
+			return false;
+		collider = box;
+	}
+	break;
+
+	case ColliderType::CIRCLE:
+	{
+		DirectX::BoundingSphere circle;
+		if (!reader.Read(circle))
+			return false;
+		collider = circle;
+	}
+	break;
+	}
+
+	float depthLevel = 0.f;
+	float hoverElapsed = 0.f;
+	bool isHovering = false;
+	bool wasHovered = false;
+	auto pairedData = m_PairedObjectData;
+	bool result = reader.Read(depthLevel) &&
+		reader.Read(hoverElapsed) &&
+		reader.Read(isHovering) &&
+		reader.Read(wasHovered) &&
+		reader.Read(pairedData.m_ObjectTypeID) &&
+		reader.Read(pairedData.m_ObjectID);
+	if (!result)
+		return false;
+	if (!apply)
+		return true;
+
+	m_Flags = flags;
+	m_Type = type;
+	m_Collider = collider;
+	m_DepthLevel = depthLevel;
+	m_HoverElapsed = hoverElapsed;
+	m_IsHovering = isHovering;
+	m_WasHovered = wasHovered;
+	m_PairedObjectData = pairedData;
+
+	return true;
+}
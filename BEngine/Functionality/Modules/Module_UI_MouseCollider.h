@@ -71,6 +71,13 @@ public:
 
 	void SyncModulePosition(Module_Interface* otherMod) override;
 
+	//
+	//Snapshots
+	//
+
+	void SaveSnapshot(SnapshotWriter& writer) override;
+	bool LoadSnapshot(SnapshotReader& reader, bool apply) override;
+
 	//////////////////
 	/// Operations ///
 	//////////////////
@@ -5,6 +5,8 @@
 
 //Engine Includes
 #include "Includes/BE_All_Modules.h"
+#include "Types/BE_Snapshot.h"
+#include "Transforms/TransformHierarchy2D.h"
 
 Module_UI_SFString::Module_UI_SFString(Actor2D_Interface* actor, DirectX::SpriteFont* font)
 	:Module_Interface(actor, std::string("Nameless SFString"), ModuleTypeID::UI_SF_STRING)
@@ -38,12 +40,16 @@ Module_UI_SFString::Module_UI_SFString(Actor2D_Interface* actor, std::string& na
 
 void Module_UI_SFString::Render(System& sys)
 {
+	//Read bound transform (if any) before drawing
+	ReadWorldTransform();
 	//Call string draw
 	m_StringData.Draw();
 }
 
 void Module_UI_SFString::Render(System& sys, DirectX::SpriteBatch* batch)
 {
+	//Read bound transform (if any) before drawing
+	ReadWorldTransform();
 	//Call string draw with given batch
 	m_StringData.Draw(batch);
 }
@@ -76,3 +82,51 @@ void Module_UI_SFString::SyncModulePosition(Module_Interface* otherMod)
 
 	}
 }
+
+void Module_UI_SFString::ReadWorldTransform()
+{
+	if (const Transform2D* transform = GetWorldTransform())
+		m_StringData.m_Position = transform->m_Position;
+}
+
+void Module_UI_SFString::SaveSnapshot(SnapshotWriter& writer)
+{
+	Module_Interface::SaveSnapshot(writer);
+
+	writer.WriteString(m_StringData.m_DefaultStr);
+	writer.WriteString(m_StringData.m_DrawableStr);
+	writer.Write(m_StringData.m_Position);
+	writer.Write(m_StringData.m_PositionOffset);
+	writer.Write(m_StringData.m_Origin);
+	writer.Write(m_StringData.m_Colour);
+	writer.Write(m_StringData.m_Rotation);
+	writer.Write(m_StringData.m_Scale);
+	writer.Write(m_StringData.m_LayerDepth);
+	writer.Write(m_StringData.m_Effect);
+}
+
+bool Module_UI_SFString::LoadSnapshot(SnapshotReader& reader, bool apply)
+{
+	//Read into a copy of the string data, applying it only if everything was read
+	Flags flags;
+	SFString stringData(m_StringData);
+	bool result = reader.Read(flags) &&
+		reader.ReadString(stringData.m_DefaultStr) &&
+		reader.ReadString(stringData.m_DrawableStr) &&
+		reader.Read(stringData.m_Position) &&
+		reader.Read(stringData.m_PositionOffset) &&
+		reader.Read(stringData.m_Origin) &&
+		reader.Read(stringData.m_Colour) &&
+		reader.Read(stringData.m_Rotation) &&
+		reader.Read(stringData.m_Scale) &&
+		reader.Read(stringData.m_LayerDepth) &&
+		reader.Read(stringData.m_Effect);
+	if (!result)
+		return false;
+	if (!apply)
+		return true;
+
+	m_Flags = flags;
+	m_StringData = std::move(stringData);
+	return true;
+}
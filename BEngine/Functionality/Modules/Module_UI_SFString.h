@@ -73,6 +73,15 @@ public:
 	//
 
 	void SyncModulePosition(Module_Interface* otherMod) override;
+	//Reads position from the bound world transform (if bound)
+	void ReadWorldTransform() override;
+
+	//
+	//Snapshots
+	//
+
+	void SaveSnapshot(SnapshotWriter& writer) override;
+	bool LoadSnapshot(SnapshotReader& reader, bool apply) override;
 
 	//////////////////
 	/// Operations ///
@@ -90,10 +99,6 @@ public:
 
 private:
 
-	//////////////////
-	/// Operations ///
-	//////////////////
-
 	////////////
 	/// Data ///
 	////////////
@@ -0,0 +1,405 @@
+#include "PrefabLibrary.h"
+
+//Library Includes
+#include <cstring>
+#include <cstddef>
+
+//Utilities
+#include "Utils/Utils_Debug.h"
+#include "Utils/Utils_General.h"
+#include "Utils/Utils_RapidJSON.h"
+
+//Engine Includes
+#include "Includes/BE_All_Managers.h"
+#include "Includes/BE_All_Modules.h"
+#include "Actors/Actor2D_Interface.h"
+
+//Sprite value state copied between prefab and instances (m_Position to m_FrameIndex, leaving the texture and batch handles)
+static constexpr size_t SPRITE_VALUE_STATE_SIZE = offsetof(SpriteData, m_FrameIndex) + sizeof(SpriteData::m_FrameIndex) - offsetof(SpriteData, m_Position);
+
+static inline void* GetSpriteValueState(SpriteData& sprData) { return &sprData.m_Position; }
+static inline const void* GetSpriteValueState(const SpriteData& sprData) { return &sprData.m_Position; }
+
+bool PrefabLibrary::LoadPrefabsFromManifest(const std::string& manifestFP, System& sys)
+{
+	//Load manifest document
+	rapidjson::Document manifestDoc;
+	std::string error;
+	if (!ParseNewJSONDocument(manifestDoc, manifestFP, &error))
+	{
+		DBOUT("LoadPrefabsFromManifest(): " << error);
+		return false;
+	}
+
+	if (!manifestDoc.HasMember("Prefabs") || !manifestDoc["Prefabs"].IsArray())
+	{
+		msg_assert(false, "LoadPrefabsFromManifest(): Prefabs array not found!");
+		return false;
+	}
+
+	const rapidjson::Value& arr = manifestDoc["Prefabs"];
+	m_Prefabs.reserve(m_Prefabs.size() + arr.Size());
+
+	for (unsigned i(0); i < arr.Size(); ++i)
+	{
+		//Skip existing prefabs
+		std::string name = arr[i]["Name"].GetString();
+		if (m_PrefabIDs.find(name) != m_PrefabIDs.end())
+		{
+			DBOUT("LoadPrefabsFromManifest(): Prefab already loaded, skipping: " << name);
+			continue;
+		}
+
+		PrefabArchetype archetype;
+		archetype.m_Name = name;
+		if (!CompilePrefab(arr[i], sys, archetype))
+		{
+			msg_assert(false, "LoadPrefabsFromManifest(): Failed to compile prefab!");
+			return false;
+		}
+
+		//Store and map name to ID
+		m_PrefabIDs[name] = static_cast<PrefabID>(m_Prefabs.size());
+		m_Prefabs.push_back(std::move(archetype));
+	}
+
+	return true;
+}
+
+void PrefabLibrary::Clear()
+{
+	m_Prefabs.clear();
+	m_PrefabIDs.clear();
+}
+
+bool PrefabLibrary::Instantiate(PrefabID id, Actor2D_Interface& actor, b2World* world, const Vec2& position)
+{
+	Actor2D_Interface* actors[1] = { &actor };
+	return InstantiateList(id, actors, &position, 1, world) == 1;
+}
+
+unsigned PrefabLibrary::InstantiateList(PrefabID id, Actor2D_Interface* const* actors, const Vec2* positions, size_t count, b2World* world)
+{
+	const PrefabArchetype* prefab = GetPrefab(id);
+	if (!prefab)
+	{
+		msg_assert(false, "InstantiateList(): Invalid prefab ID!");
+		return 0;
+	}
+
+	if (prefab->m_ShapeType != PrefabArchetype::ShapeType::NONE && !world)
+	{
+		msg_assert(false, "InstantiateList(): Prefab has a body, but no world given!");
+		return 0;
+	}
+
+	const size_t moduleCount = prefab->m_Modules.size();
+
+	//
+	//Layout
+	//
+
+	//Gather the modules of every instance (adding them where missing), skipping any that don't match
+	m_ScratchModules.resize(count * moduleCount);
+	m_ScratchData.resize(count * moduleCount);
+	m_ScratchInstances.clear();
+	m_ScratchInstances.reserve(count);
+	for (unsigned i(0); i < count; ++i)
+	{
+		if (SetupModuleLayout(*prefab, *actors[i], m_ScratchModules.data() + i * moduleCount, m_ScratchData.data() + i * moduleCount))
+			m_ScratchInstances.push_back(i);
+	}
+
+	//
+	//Copy
+	//
+
+	const PrefabArchetype::ActorBlock& actorBlock = prefab->m_Actor;
+	const unsigned char* moduleData = prefab->m_ModuleData.data();
+	for (unsigned i : m_ScratchInstances)
+	{
+		Actor2D_Interface& actor = *actors[i];
+		actor.m_CoreIDs.m_CategoryID = actorBlock.m_CategoryID;
+		actor.m_UtilityIDs.m_RenderGroupIndex = actorBlock.m_RenderGroupIndex;
+		actor.m_Flags = actorBlock.m_Flags;
+		actor.m_Signals = actorBlock.m_Signals;
+		actor.m_ActorDepth = actorBlock.m_ActorDepth;
+
+		Module_Interface** modules = m_ScratchModules.data() + i * moduleCount;
+		void** data = m_ScratchData.data() + i * moduleCount;
+		for (size_t m(0); m < moduleCount; ++m)
+		{
+			const PrefabArchetype::ModuleBlock& block = prefab->m_Modules[m];
+			modules[m]->GetFlags() = block.m_Flags;
+			if (block.m_DataSize)
+				std::memcpy(data[m], moduleData + block.m_DataOffset, block.m_DataSize);
+		}
+	}
+
+	//
+	//Fix-ups
+	//
+
+	for (unsigned i : m_ScratchInstances)
+	{
+		Actor2D_Interface& actor = *actors[i];
+		const Vec2& position = positions[i];
+		Module_Interface** modules = m_ScratchModules.data() + i * moduleCount;
+
+		for (size_t m(0); m < moduleCount; ++m)
+		{
+			//Point modules at the actor (in case it has moved since they were added)
+			modules[m]->ReSyncWithActor(&actor);
+
+			switch (prefab->m_Modules[m].m_Type)
+			{
+			case Module_Interface::ModuleTypeID::SPRITE:
+			{
+				SpriteData& sprData = recast_static(Module_Sprite*, modules[m])->GetSpriteData();
+				sprData.m_Position = position;
+
+				//Instances keep their own texture (and batch), so the copied frame must exist within it
+				if (!sprData.m_Texture)
+					sprData.m_Texture = prefab->m_SpriteTexture;
+				else if (sprData.m_FrameIndex >= sprData.m_Texture->m_Frames.size())
+					sprData.SetFrame(0);
+			}
+			break;
+
+			case Module_Interface::ModuleTypeID::BOX2D_RIGIDBODY:
+			{
+				Module_Box2D_RigidBody2D* body = recast_static(Module_Box2D_RigidBody2D*, modules[m]);
+
+				//Local copies, as the definitions are modified for each instance
+				b2BodyDef bodyDef = prefab->m_BodyDef;
+				bodyDef.position.Set(Mgr_Box2DPhysics::PixelsToMetres(position.x), -Mgr_Box2DPhysics::PixelsToMetres(position.y));
+				body->AttachNewBody(bodyDef, *world, Box2D_UserData_Interface());
+
+				b2FixtureDef fixDef = prefab->m_FixtureDef;
+				if (prefab->m_ShapeType == PrefabArchetype::ShapeType::BOX)
+					fixDef.shape = &prefab->m_PolygonShape;
+				else
+					fixDef.shape = &prefab->m_CircleShape;
+				body->AttachNewFixture(fixDef);
+			}
+			break;
+			}
+		}
+
+		//Mirror the copied flags
+		if (actor.GetFlagRegistry())
+			actor.GetFlagRegistry()->SyncActor(&actor);
+	}
+
+	return static_cast<unsigned>(m_ScratchInstances.size());
+}
+
+PrefabLibrary::PrefabID PrefabLibrary::FindPrefabID(const std::string& name)
+{
+	auto it = m_PrefabIDs.find(name);
+	if (it != m_PrefabIDs.end())
+		return it->second;
+
+	return INVALID_ID;
+}
+
+const PrefabArchetype* PrefabLibrary::GetPrefab(PrefabID id)
+{
+	if (id < m_Prefabs.size())
+		return &m_Prefabs[id];
+
+	return nullptr;
+}
+
+bool PrefabLibrary::CompilePrefab(const rapidjson::Value& prefab, System& sys, PrefabArchetype& archetype)
+{
+	/*
+		A template actor is setup as described by the prefab, then its actor and module data copied into
+		the blocks instances are copied from.
+	*/
+	Actor2D_Interface actor;
+
+	//Instances are fully setup, so shouldn't run their own init
+	actor.SetFlag(Actor2D_FlagRegistry::FlagID::CAN_RUN_ONCE_INIT, false);
+
+	if (prefab.HasMember("Category_ID"))
+		actor.SetCategoryID(prefab["Category_ID"].GetInt());
+	if (prefab.HasMember("Render_Group"))
+		actor.SetRenderGroupIndex(prefab["Render_Group"].GetUint());
+
+	//
+	//Sprite
+	//
+
+	if (prefab.HasMember("Sprite"))
+	{
+		const rapidjson::Value& sprDesc = prefab["Sprite"];
+
+		//Find texture for this prefab
+		std::string texName = sprDesc["Texture_Name"].GetString();
+		SpriteTexture* texture = sys.m_TexMgr->FindTextureData(texName);
+		if (!texture)
+		{
+			DBOUT("CompilePrefab(): Texture not found: " << texName);
+			return false;
+		}
+
+		std::string name = "Sprite";
+		Module_Sprite* spr = actor.AddNewModule<Module_Sprite>(name);
+		SpriteData& sprData = spr->GetSpriteData();
+
+		sprData.SetTexture(texture);
+		if (sprDesc.HasMember("Frame"))
+			sprData.SetFrame(sprDesc["Frame"].GetInt());
+		if (sprDesc.HasMember("Scale"))
+			sprData.m_Scale = { sprDesc["Scale"][0].GetFloat(), sprDesc["Scale"][1].GetFloat() };
+		if (sprDesc.HasMember("Layer_Depth"))
+			sprData.m_LayerDepth = sprDesc["Layer_Depth"].GetFloat();
+	}
+
+	//
+	//Physics
+	//
+
+	if (prefab.HasMember("RigidBody"))
+	{
+		const rapidjson::Value& bodyDesc = prefab["RigidBody"];
+
+		//Body definition
+		std::string bodyType = bodyDesc.HasMember("Body_Type") ? bodyDesc["Body_Type"].GetString() : "Dynamic";
+		if (bodyType == "Static")
+			archetype.m_BodyDef.type = b2_staticBody;
+		else if (bodyType == "Kinematic")
+			archetype.m_BodyDef.type = b2_kinematicBody;
+		else
+			archetype.m_BodyDef.type = b2_dynamicBody;
+
+		//Shape definition (sizes given in pixels)
+		std::string shape = bodyDesc["Shape"].GetString();
+		if (shape == "Box")
+		{
+			archetype.m_ShapeType = PrefabArchetype::ShapeType::BOX;
+			archetype.m_PolygonShape.SetAsBox(
+				Mgr_Box2DPhysics::PixelsToMetres(bodyDesc["Half_Size"][0].GetFloat()),
+				Mgr_Box2DPhysics::PixelsToMetres(bodyDesc["Half_Size"][1].GetFloat())
+			);
+		}
+		else if (shape == "Circle")
+		{
+			archetype.m_ShapeType = PrefabArchetype::ShapeType::CIRCLE;
+			archetype.m_CircleShape.m_p.Set(0.f, 0.f);
+			archetype.m_CircleShape.m_radius = Mgr_Box2DPhysics::PixelsToMetres(bodyDesc["Radius"].GetFloat());
+		}
+		else
+		{
+			DBOUT("CompilePrefab(): Unknown shape type: " << shape);
+			return false;
+		}
+
+		//Fixture definition
+		archetype.m_FixtureDef.density = bodyDesc.HasMember("Density") ? bodyDesc["Density"].GetFloat() : 1.f;
+		archetype.m_FixtureDef.friction = bodyDesc.HasMember("Friction") ? bodyDesc["Friction"].GetFloat() : 0.2f;
+		archetype.m_FixtureDef.restitution = bodyDesc.HasMember("Restitution") ? bodyDesc["Restitution"].GetFloat() : 0.f;
+
+		//Body itself is created per instance
+		std::string name = "RigidBody";
+		actor.AddNewModule<Module_Box2D_RigidBody2D>(name);
+	}
+
+	//Flatten template actor into the blocks
+	archetype.m_Actor.m_CategoryID = actor.m_CoreIDs.m_CategoryID;
+	archetype.m_Actor.m_RenderGroupIndex = actor.m_UtilityIDs.m_RenderGroupIndex;
+	archetype.m_Actor.m_Flags = actor.m_Flags;
+	archetype.m_Actor.m_Signals = actor.m_Signals;
+	archetype.m_Actor.m_ActorDepth = actor.m_ActorDepth;
+
+	for (unsigned i(0); i < actor.GetModuleCount(); ++i)
+		CompileModuleBlock(actor.GetModule(i), archetype);
+
+	return true;
+}
+
+void PrefabLibrary::CompileModuleBlock(Module_Interface* module, PrefabArchetype& archetype)
+{
+	PrefabArchetype::ModuleBlock block;
+	block.m_Type = module->GetType();
+	block.m_Flags = module->GetFlags();
+
+	//Plain value data copied as is (handles such as the texture are fixed up per instance)
+	const void* data = nullptr;
+	switch (block.m_Type)
+	{
+	case Module_Interface::ModuleTypeID::SPRITE:
+	{
+		static_assert(std::is_trivially_copyable<SpriteData>::value, "CompileModuleBlock(): SpriteData must be trivially copyable!");
+		const SpriteData& sprData = recast_static(Module_Sprite*, module)->GetSpriteData();
+		data = GetSpriteValueState(sprData);
+		block.m_DataSize = SPRITE_VALUE_STATE_SIZE;
+		archetype.m_SpriteTexture = sprData.m_Texture;
+	}
+	break;
+	}
+
+	if (data)
+	{
+		block.m_DataOffset = static_cast<uint32_t>(archetype.m_ModuleData.size());
+		const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data);
+		archetype.m_ModuleData.insert(archetype.m_ModuleData.end(), bytes, bytes + block.m_DataSize);
+	}
+
+	archetype.m_Modules.push_back(block);
+}
+
+bool PrefabLibrary::SetupModuleLayout(const PrefabArchetype& archetype, Actor2D_Interface& actor, Module_Interface** outModules, void** outData)
+{
+	//No modules, so add them per the layout
+	if (actor.GetModuleCount() == 0)
+	{
+		for (auto& block : archetype.m_Modules)
+		{
+			switch (block.m_Type)
+			{
+			case Module_Interface::ModuleTypeID::SPRITE:
+			{
+				std::string name = "Sprite";
+				actor.AddNewModule<Module_Sprite>(name);
+			}
+			break;
+
+			case Module_Interface::ModuleTypeID::BOX2D_RIGIDBODY:
+			{
+				std::string name = "RigidBody";
+				actor.AddNewModule<Module_Box2D_RigidBody2D>(name);
+			}
+			break;
+
+			default:
+				msg_assert(false, "SetupModuleLayout(): Unsupported module type in layout!");
+				return false;
+			}
+		}
+	}
+	//Otherwise existing modules must match the layout
+	else if (actor.GetModuleCount() < archetype.m_Modules.size())
+	{
+		msg_assert(false, "SetupModuleLayout(): Actor modules don't match prefab layout!");
+		return false;
+	}
+
+	for (unsigned i(0); i < archetype.m_Modules.size(); ++i)
+	{
+		Module_Interface* module = actor.GetModule(i);
+		if (module->GetType() != archetype.m_Modules[i].m_Type)
+		{
+			msg_assert(false, "SetupModuleLayout(): Actor modules don't match prefab layout!");
+			return false;
+		}
+
+		outModules[i] = module;
+		outData[i] = nullptr;
+		if (archetype.m_Modules[i].m_Type == Module_Interface::ModuleTypeID::SPRITE)
+			outData[i] = GetSpriteValueState(recast_static(Module_Sprite*, module)->GetSpriteData());
+	}
+
+	return true;
+}
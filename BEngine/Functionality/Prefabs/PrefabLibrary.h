@@ -0,0 +1,208 @@
+//*********************************************************************************\\
+//
+// JSON authored prefabs (module setup, sprite, physics definitions) compiled at
+// load time into flat archetypes. Each archetype holds a block of actor data and
+// a plain data block per module (e.g. the SpriteData value state), alongside the
+// handles and definitions that can't be stored flat (texture, Box2D defs).
+//
+// Instancing is done in passes over all instances: module layout (adding any
+// missing modules), a copy of the blocks into each instance, then a fix-up of
+// the handles (actor pointers, positions, textures, b2Body creation).
+//
+//*********************************************************************************\\
+
+#pragma once
+
+//Library Includes
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <type_traits>
+#include "box2d/b2_body.h"
+#include "box2d/b2_fixture.h"
+#include "box2d/b2_polygon_shape.h"
+#include "box2d/b2_circle_shape.h"
+#include "document.h"
+
+//Engine Includes
+#include "Actors/Actor2D_Interface.h"
+#include "Modules/Module_Interface.h"
+#include "Utils/Utils_D3D.h"
+
+//Forward Declarations
+struct System;
+struct SpriteTexture;
+class b2World;
+
+/*
+	Compiled prefab data, ready for instancing.
+*/
+struct PrefabArchetype
+{
+	//////////////////////////////
+	/// Enums, Types & Statics ///
+	//////////////////////////////
+
+	enum class ShapeType : unsigned
+	{
+		NONE,
+		BOX,
+		CIRCLE
+	};
+
+	//Actor data set by the prefab (IDs unique to each actor are left as they are)
+	struct ActorBlock
+	{
+		int m_CategoryID = -1;
+		unsigned m_RenderGroupIndex = 0;
+		Actor2D_Interface::Flags m_Flags;
+		Actor2D_Interface::ModuleSignals m_Signals;
+		float m_ActorDepth = 1.f;
+	};
+
+	//Module in the layout, with its plain data (if any) held in m_ModuleData
+	struct ModuleBlock
+	{
+		Module_Interface::ModuleTypeID m_Type;
+		Module_Interface::Flags m_Flags;
+		uint32_t m_DataOffset = 0;
+		uint32_t m_DataSize = 0;
+	};
+
+	////////////
+	/// Data ///
+	////////////
+
+	std::string m_Name = "NULL";
+	ActorBlock m_Actor;
+	//Modules (in order), instances are given the same layout
+	std::vector<ModuleBlock> m_Modules;
+	//Plain data of every module, copied straight over the matching module data of instances
+	std::vector<unsigned char> m_ModuleData;
+
+	//
+	//Fix-up Data (handles not stored in the blocks)
+	//
+
+	//Texture of the sprite module, given to instances that don't have one already
+	SpriteTexture* m_SpriteTexture = nullptr;
+
+	//Physics definitions (fixture shape pointer is fixed up on instancing)
+	b2BodyDef m_BodyDef;
+	b2FixtureDef m_FixtureDef;
+	ShapeType m_ShapeType = ShapeType::NONE;
+	b2PolygonShape m_PolygonShape;
+	b2CircleShape m_CircleShape;
+};
+
+class PrefabLibrary
+{
+public:
+
+	//////////////////////////////
+	/// Enums, Types & Statics ///
+	//////////////////////////////
+
+	typedef unsigned PrefabID;
+	static constexpr PrefabID INVALID_ID = 0xFFFFFFFF;
+
+	////////////////////
+	/// Constructors ///
+	////////////////////
+
+	PrefabLibrary() { }
+	~PrefabLibrary() { }
+
+	//////////////////
+	/// Operations ///
+	//////////////////
+
+	//
+	//Loading
+	//
+
+	/*
+		Loads and compiles all prefabs found in the manifest. Textures referenced must already be loaded.
+		Prefabs with a name already present in the library are skipped.
+	*/
+	bool LoadPrefabsFromManifest(const std::string& manifestFP, System& sys);
+	//Releases all prefabs
+	void Clear();
+
+	//
+	//Instancing
+	//
+
+	/*
+		Sets up the actor from the prefab. The actor should either have no modules (they are added as per the
+		prefab layout), or have a matching module layout (such as when re-using an actor). The physics body is
+		created in the given world (if the prefab has one, world can be nullptr otherwise).
+		Position is in pixels, and is applied to both sprite and body.
+	*/
+	bool Instantiate(PrefabID id, Actor2D_Interface& actor, b2World* world, const Vec2& position);
+
+	/*
+		Instantiates prefab onto each actor in the given range, with each position given. Returns the number
+		of actors successfully instanced.
+	*/
+	template<class ACTOR>
+	unsigned InstantiateBulk(PrefabID id, ACTOR* actors, const Vec2* positions, size_t count, b2World* world);
+	//As above, over a list of actors
+	unsigned InstantiateList(PrefabID id, Actor2D_Interface* const* actors, const Vec2* positions, size_t count, b2World* world);
+
+	/////////////////
+	/// Accessors ///
+	/////////////////
+
+	//Returns ID of prefab with matching name (INVALID_ID if not found)
+	PrefabID FindPrefabID(const std::string& name);
+	//Returns prefab via ID (nullptr if invalid ID)
+	const PrefabArchetype* GetPrefab(PrefabID id);
+
+	size_t GetPrefabCount() { return m_Prefabs.size(); }
+
+private:
+
+	//////////////////
+	/// Operations ///
+	//////////////////
+
+	//Builds archetype from the JSON object
+	bool CompilePrefab(const rapidjson::Value& prefab, System& sys, PrefabArchetype& archetype);
+	//Appends the plain data of the module to the archetype (if it has any)
+	void CompileModuleBlock(Module_Interface* module, PrefabArchetype& archetype);
+	/*
+		Adds modules to the actor matching the layout (or checks existing modules match it), giving the
+		module and the destination of its plain data for each module in the layout.
+	*/
+	bool SetupModuleLayout(const PrefabArchetype& archetype, Actor2D_Interface& actor, Module_Interface** outModules, void** outData);
+
+	////////////
+	/// Data ///
+	////////////
+
+	std::vector<PrefabArchetype> m_Prefabs;
+	std::unordered_map<std::string, PrefabID> m_PrefabIDs;
+
+	//Reusable instancing containers (actors, their modules + module data per layout slot, and those laid out)
+	std::vector<Actor2D_Interface*> m_ScratchActors;
+	std::vector<Module_Interface*> m_ScratchModules;
+	std::vector<void*> m_ScratchData;
+	std::vector<unsigned> m_ScratchInstances;
+};
+
+//
+//Template Funcs
+//
+
+template<class ACTOR>
+unsigned PrefabLibrary::InstantiateBulk(PrefabID id, ACTOR* actors, const Vec2* positions, size_t count, b2World* world)
+{
+	static_assert(std::is_base_of<Actor2D_Interface, ACTOR>::value, "InstantiateBulk(): Type must derive from Actor2D_Interface!");
+
+	m_ScratchActors.resize(count);
+	for (size_t i(0); i < count; ++i)
+		m_ScratchActors[i] = &actors[i];
+
+	return InstantiateList(id, m_ScratchActors.data(), positions, count, world);
+}
@@ -0,0 +1,161 @@
+#include "DescriptorAllocator.h"
+
+//Library Includes
+#include <iterator>
+
+//Utilities
+#include "Utils/Utils_Debug.h"
+
+DescriptorAllocator::DescriptorAllocator(unsigned capacity)
+{
+	Reset(capacity);
+}
+
+void DescriptorAllocator::Reset(unsigned capacity)
+{
+	m_Capacity = capacity;
+	m_UsedSlots = 0;
+	m_HighWaterMark = 0;
+
+	m_FreeRanges.clear();
+	m_Allocations.clear();
+	if (capacity > 0)
+		m_FreeRanges[0] = capacity;
+
+	m_TotalAllocations = 0;
+	m_TotalFrees = 0;
+	m_FailedAllocations = 0;
+}
+
+unsigned DescriptorAllocator::Allocate(unsigned count)
+{
+	msg_assert(count > 0, "Allocate(): Zero sized allocation!");
+
+	//Best fit (smallest free range that fits, earliest on ties), keeping larger ranges intact for larger requests
+	auto best = m_FreeRanges.end();
+	for (auto it = m_FreeRanges.begin(); it != m_FreeRanges.end(); ++it)
+	{
+		if (it->second >= count && (best == m_FreeRanges.end() || it->second < best->second))
+		{
+			best = it;
+			if (best->second == count)
+				break;
+		}
+	}
+
+	if (count == 0 || best == m_FreeRanges.end())
+	{
+		++m_FailedAllocations;
+		return INVALID_INDEX;
+	}
+
+	//Take from the front of the range, leaving any remainder free
+	unsigned start = best->first;
+	unsigned remaining = best->second - count;
+	m_FreeRanges.erase(best);
+	if (remaining > 0)
+		m_FreeRanges[start + count] = remaining;
+
+	m_Allocations[start] = count;
+	m_UsedSlots += count;
+	if (start + count > m_HighWaterMark)
+		m_HighWaterMark = start + count;
+	++m_TotalAllocations;
+
+	return start;
+}
+
+bool DescriptorAllocator::Free(unsigned start)
+{
+	auto alloc = m_Allocations.find(start);
+	if (alloc == m_Allocations.end())
+	{
+		msg_assert(false, "Free(): Slot is not the start of a live allocation!");
+		return false;
+	}
+
+	unsigned count = alloc->second;
+	m_Allocations.erase(alloc);
+	m_UsedSlots -= count;
+	++m_TotalFrees;
+
+	//Merge with the free ranges either side (if touching)
+	auto next = m_FreeRanges.lower_bound(start);
+	if (next != m_FreeRanges.end() && start + count == next->first)
+	{
+		count += next->second;
+		next = m_FreeRanges.erase(next);
+	}
+	if (next != m_FreeRanges.begin())
+	{
+		auto prev = std::prev(next);
+		if (prev->first + prev->second == start)
+		{
+			prev->second += count;
+			return true;
+		}
+	}
+
+	m_FreeRanges.emplace_hint(next, start, count);
+	return true;
+}
+
+DescriptorAllocator::Report DescriptorAllocator::BuildReport() const
+{
+	Report report;
+	report.m_Capacity = m_Capacity;
+	report.m_UsedSlots = m_UsedSlots;
+	report.m_FreeSlots = m_Capacity - m_UsedSlots;
+	report.m_HighWaterMark = m_HighWaterMark;
+	report.m_LiveAllocations = m_Allocations.size();
+	report.m_FreeRanges = m_FreeRanges.size();
+	report.m_TotalAllocations = m_TotalAllocations;
+	report.m_TotalFrees = m_TotalFrees;
+	report.m_FailedAllocations = m_FailedAllocations;
+
+	for (auto& range : m_FreeRanges)
+	{
+		if (range.second > report.m_LargestFreeRange)
+			report.m_LargestFreeRange = range.second;
+	}
+	if (report.m_FreeSlots > 0)
+		report.m_Fragmentation = 1.f - static_cast<float>(report.m_LargestFreeRange) / static_cast<float>(report.m_FreeSlots);
+
+	std::vector<Move> moves = PlanCompaction();
+	report.m_MovesToCompact = moves.size();
+	for (auto& move : moves)
+		report.m_SlotsToMove += move.m_Count;
+
+	return report;
+}
+
+std::vector<DescriptorAllocator::Move> DescriptorAllocator::PlanCompaction() const
+{
+	//Slide each live range down to the end of the one before it (only ranges after a gap move)
+	std::vector<Move> moves;
+	unsigned next = 0;
+	for (auto& alloc : m_Allocations)
+	{
+		if (alloc.first != next)
+		{
+			Move move;
+			move.m_From = alloc.first;
+			move.m_To = next;
+			move.m_Count = alloc.second;
+			moves.push_back(move);
+		}
+		next += alloc.second;
+	}
+
+	return moves;
+}
+
+bool DescriptorAllocator::IsAllocated(unsigned index) const
+{
+	//Last allocation starting at or before the index
+	auto it = m_Allocations.upper_bound(index);
+	if (it == m_Allocations.begin())
+		return false;
+	--it;
+	return index < it->first + it->second;
+}
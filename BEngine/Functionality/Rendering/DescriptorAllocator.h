@@ -0,0 +1,122 @@
+//*********************************************************************************\\
+//
+// Sub-allocator for the slots of a descriptor heap. Slots are handed out as
+// contiguous ranges (best fit from a free list kept sorted by position), and
+// freed ranges are returned to the list, merging with their free neighbours, so
+// unloaded textures and fonts give their slots back for reuse.
+//
+// Only does the bookkeeping (never touches the heap itself), so it can be run
+// headless against any capacity. See Mgr_TextureResources::SRVData for use.
+//
+//*********************************************************************************\\
+
+#pragma once
+
+//Library Includes
+#include <map>
+#include <vector>
+#include <cstddef>
+
+class DescriptorAllocator
+{
+public:
+
+	//////////////////////////////
+	/// Enums, Types & Statics ///
+	//////////////////////////////
+
+	//Returned when an allocation can't be made
+	static constexpr unsigned INVALID_INDEX = 0xFFFFFFFF;
+
+	//Contiguous run of slots
+	struct Range
+	{
+		unsigned m_Start = 0;
+		unsigned m_Count = 0;
+	};
+
+	//Planned relocation of a live range, to compact allocations to the front of the heap
+	struct Move
+	{
+		unsigned m_From = 0;
+		unsigned m_To = 0;
+		unsigned m_Count = 0;
+	};
+
+	/*
+		Usage and fragmentation snapshot (see BuildReport). Fragmentation is the share of free slots outside the
+		largest free range (0 when all free space is contiguous, approaching 1 when scattered in single slots).
+	*/
+	struct Report
+	{
+		unsigned m_Capacity = 0;
+		unsigned m_UsedSlots = 0;
+		unsigned m_FreeSlots = 0;
+		//Highest slot ever in use (+1), i.e. how much of the heap has been touched
+		unsigned m_HighWaterMark = 0;
+		size_t m_LiveAllocations = 0;
+		size_t m_FreeRanges = 0;
+		unsigned m_LargestFreeRange = 0;
+		float m_Fragmentation = 0.f;
+		//Moves (and slots moved) that compacting would take, leaving all free slots in one range at the end
+		size_t m_MovesToCompact = 0;
+		unsigned m_SlotsToMove = 0;
+		//Running totals
+		size_t m_TotalAllocations = 0;
+		size_t m_TotalFrees = 0;
+		size_t m_FailedAllocations = 0;
+	};
+
+	////////////////////
+	/// Constructors ///
+	////////////////////
+
+	DescriptorAllocator(unsigned capacity = 0);
+	~DescriptorAllocator() { }
+
+	//////////////////
+	/// Operations ///
+	//////////////////
+
+	//Clears all allocations and counters, managing the given number of slots
+	void Reset(unsigned capacity);
+
+	//Allocates a contiguous range of slots, returning its first slot (INVALID_INDEX if no free range is large enough)
+	unsigned Allocate(unsigned count = 1);
+	//Frees a range previously returned by Allocate (by its first slot), returning false if it isn't a live allocation
+	bool Free(unsigned start);
+
+	//Builds the usage and fragmentation report
+	Report BuildReport() const;
+	//Plans the moves that would compact every live range to the front, in order (applying them is up to the caller)
+	std::vector<Move> PlanCompaction() const;
+
+	/////////////////
+	/// Accessors ///
+	/////////////////
+
+	//Checks if the slot lies within a live allocation
+	bool IsAllocated(unsigned index) const;
+
+	unsigned GetCapacity() const { return m_Capacity; }
+	unsigned GetUsedSlots() const { return m_UsedSlots; }
+	unsigned GetFreeSlots() const { return m_Capacity - m_UsedSlots; }
+
+private:
+
+	////////////
+	/// Data ///
+	////////////
+
+	unsigned m_Capacity = 0;
+	unsigned m_UsedSlots = 0;
+	unsigned m_HighWaterMark = 0;
+
+	//Free ranges and live allocations, both by first slot to count (free ranges never touch, as they are merged)
+	std::map<unsigned, unsigned> m_FreeRanges;
+	std::map<unsigned, unsigned> m_Allocations;
+
+	size_t m_TotalAllocations = 0;
+	size_t m_TotalFrees = 0;
+	size_t m_FailedAllocations = 0;
+};
@@ -0,0 +1,268 @@
+#include "GlyphLayoutCache.h"
+
+//Library Includes
+#include <cwctype>
+#include <cstring>
+#include <algorithm>
+
+//Utilities
+#include "Utils/Utils_Debug.h"
+
+using namespace DirectX;
+
+//Byte following the first of a UTF-8 sequence
+static bool IsContinuation(const std::string& text, size_t index)
+{
+	return index < text.size() && (static_cast<unsigned char>(text[index]) & 0xC0) == 0x80;
+}
+
+/*
+	Decodes the UTF-8 sequence at index into UTF-16 units (as SpriteFont converts strings before looking
+	up glyphs), returning the number of bytes used. Invalid sequences decode to a replacement character.
+*/
+static size_t DecodeUTF8(const std::string& text, size_t index, wchar_t outUnits[2], unsigned& outUnitCount)
+{
+	const unsigned char lead = static_cast<unsigned char>(text[index]);
+	size_t length = lead < 0x80 ? 1 : (lead & 0xE0) == 0xC0 ? 2 : (lead & 0xF0) == 0xE0 ? 3 : (lead & 0xF8) == 0xF0 ? 4 : 0;
+	uint32_t codepoint = length == 1 ? lead : length == 2 ? lead & 0x1F : length == 3 ? lead & 0x0F : lead & 0x07;
+
+	bool valid = length != 0 && index + length <= text.size();
+	for (size_t i(1); valid && i < length; ++i)
+	{
+		valid = IsContinuation(text, index + i);
+		codepoint = (codepoint << 6) | (static_cast<unsigned char>(text[index + i]) & 0x3F);
+	}
+
+	//Reject overlong forms, surrogates and anything past the last codepoint
+	static const uint32_t minimums[5] = { 0, 0, 0x80, 0x800, 0x10000 };
+	valid = valid && codepoint >= minimums[length] && codepoint <= 0x10FFFF && (codepoint < 0xD800 || codepoint > 0xDFFF);
+	if (!valid)
+	{
+		outUnits[0] = 0xFFFD;
+		outUnitCount = 1;
+		return 1;
+	}
+
+	if (codepoint < 0x10000)
+	{
+		outUnits[0] = static_cast<wchar_t>(codepoint);
+		outUnitCount = 1;
+	}
+	else
+	{
+		codepoint -= 0x10000;
+		outUnits[0] = static_cast<wchar_t>(0xD800 + (codepoint >> 10));
+		outUnits[1] = static_cast<wchar_t>(0xDC00 + (codepoint & 0x3FF));
+		outUnitCount = 2;
+	}
+	return length;
+}
+
+GlyphLayoutCache& GlyphLayoutCache::GetShared()
+{
+	static GlyphLayoutCache cache;
+	return cache;
+}
+
+GlyphLayoutCache::LayoutPtr GlyphLayoutCache::Acquire(const DirectX::SpriteFont* font, const std::string& text, const Layout* previous)
+{
+	msg_assert(font, "Acquire(): No font given!");
+
+	Key key = { font, std::hash<std::string>()(text) };
+	auto found = m_Lookup.find(key);
+	if (found != m_Lookup.end())
+	{
+		if ((*found->second)->m_Text == text)
+		{
+			++m_Counters.m_Hits;
+			m_Layouts.splice(m_Layouts.begin(), m_Layouts, found->second);
+			return m_Layouts.front();
+		}
+
+		//Hash collision, so replace it
+		m_Layouts.erase(found->second);
+		m_Lookup.erase(found);
+	}
+	++m_Counters.m_Misses;
+
+	std::shared_ptr<Layout> layout = std::make_shared<Layout>();
+	layout->m_Font = font;
+	layout->m_Text = text;
+	layout->m_Hash = key.m_Hash;
+	LayoutText(*layout, previous);
+
+	m_Layouts.push_front(layout);
+	m_Lookup[key] = m_Layouts.begin();
+
+	//Evict least recently used (still valid for anything holding them)
+	while (m_Layouts.size() > std::max<size_t>(m_Settings.m_MaxLayouts, 1))
+	{
+		const Layout& last = *m_Layouts.back();
+		m_Lookup.erase({ last.m_Font, last.m_Hash });
+		m_Layouts.pop_back();
+		++m_Counters.m_Evictions;
+	}
+
+	return layout;
+}
+
+void GlyphLayoutCache::InvalidateFont(const DirectX::SpriteFont* font)
+{
+	for (auto it = m_Layouts.begin(); it != m_Layouts.end();)
+	{
+		if ((*it)->m_Font == font)
+		{
+			m_Lookup.erase({ font, (*it)->m_Hash });
+			it = m_Layouts.erase(it);
+		}
+		else
+			++it;
+	}
+}
+
+void GlyphLayoutCache::Clear()
+{
+	m_Lookup.clear();
+	m_Layouts.clear();
+}
+
+void XM_CALLCONV GlyphLayoutCache::Draw(const Layout& layout, DirectX::SpriteBatch* batch, const DirectX::XMFLOAT2& position, DirectX::FXMVECTOR colour,
+	float rotation, const DirectX::XMFLOAT2& origin, float scale, DirectX::SpriteEffects effects, float layerDepth)
+{
+	msg_assert(layout.m_Font && batch, "Draw(): No font and/or batch set!");
+
+	//Which way to move along each axis, and which axes are mirrored, per effect (as SpriteFont::DrawString)
+	static const XMVECTORF32 axisDirectionTable[4] =
+	{
+		{ { { -1, -1, 0, 0 } } },
+		{ { {  1, -1, 0, 0 } } },
+		{ { { -1,  1, 0, 0 } } },
+		{ { {  1,  1, 0, 0 } } },
+	};
+	static const XMVECTORF32 axisIsMirroredTable[4] =
+	{
+		{ { { 0, 0, 0, 0 } } },
+		{ { { 1, 0, 0, 0 } } },
+		{ { { 0, 1, 0, 0 } } },
+		{ { { 1, 1, 0, 0 } } },
+	};
+
+	//Mirrored strings start from the opposite side
+	XMVECTOR baseOffset = XMLoadFloat2(&origin);
+	if (effects)
+		baseOffset = XMVectorNegativeMultiplySubtract(XMLoadFloat2(&layout.m_Extents), axisIsMirroredTable[effects & 3], baseOffset);
+
+	const D3D12_GPU_DESCRIPTOR_HANDLE sheet = layout.m_Font->GetSpriteSheet();
+	const XMUINT2 sheetSize = layout.m_Font->GetSpriteSheetSize();
+	const XMVECTOR drawPosition = XMLoadFloat2(&position);
+	const XMVECTOR drawScale = XMVectorReplicate(scale);
+
+	for (auto& glyph : layout.m_Glyphs)
+	{
+		XMVECTOR offset = XMVectorMultiplyAdd(XMLoadFloat2(&glyph.m_Offset), axisDirectionTable[effects & 3], baseOffset);
+
+		//Mirrored glyphs are placed by their bottom and/or right
+		if (effects)
+		{
+			XMVECTOR glyphSize = XMVectorSet(
+				static_cast<float>(glyph.m_Subrect.right - glyph.m_Subrect.left),
+				static_cast<float>(glyph.m_Subrect.bottom - glyph.m_Subrect.top),
+				0.f, 0.f
+			);
+			offset = XMVectorMultiplyAdd(glyphSize, axisIsMirroredTable[effects & 3], offset);
+		}
+
+		batch->Draw(sheet, sheetSize, drawPosition, &glyph.m_Subrect, colour, rotation, offset, drawScale, effects, layerDepth);
+	}
+}
+
+void GlyphLayoutCache::LayoutText(Layout& layout, const Layout* previous)
+{
+	const std::string& text = layout.m_Text;
+	//Strings are drawn as C strings, so stop at any terminator
+	const size_t end = std::min(text.size(), std::strlen(text.c_str()));
+
+	layout.m_Pens.clear();
+	layout.m_Pens.reserve(text.size() + 1);
+	layout.m_Glyphs.clear();
+
+	//Resume from the prefix shared with the previous layout
+	Pen pen;
+	size_t start = 0;
+	if (previous && previous->m_Font == layout.m_Font)
+	{
+		const std::string& prevText = previous->m_Text;
+		size_t shared = std::min(end, std::strlen(prevText.c_str()));
+		shared = std::mismatch(text.begin(), text.begin() + shared, prevText.begin()).first - text.begin();
+
+		//Only resume at the start of a character in both
+		while (shared > 0 && (IsContinuation(text, shared) || IsContinuation(prevText, shared)))
+			--shared;
+
+		if (shared > 0)
+		{
+			pen = previous->m_Pens[shared];
+			layout.m_Pens.assign(previous->m_Pens.begin(), previous->m_Pens.begin() + shared);
+			layout.m_Glyphs.assign(previous->m_Glyphs.begin(), previous->m_Glyphs.begin() + pen.m_GlyphCount);
+			start = shared;
+
+			++m_Counters.m_IncrementalLayouts;
+			m_Counters.m_ReusedGlyphs += pen.m_GlyphCount;
+		}
+	}
+
+	//Lay out the rest, as SpriteFont::DrawString and MeasureString (ignoring whitespace)
+	const SpriteFont& font = *layout.m_Font;
+	const float lineSpacing = font.GetLineSpacing();
+	const uint32_t reused = pen.m_GlyphCount;
+
+	size_t index = start;
+	while (index < end)
+	{
+		wchar_t units[2];
+		unsigned unitCount = 0;
+		const size_t length = DecodeUTF8(text, index, units, unitCount);
+		for (size_t i(0); i < length; ++i)
+			layout.m_Pens.push_back(pen);
+		index += length;
+
+		for (unsigned u(0); u < unitCount; ++u)
+		{
+			const wchar_t character = units[u];
+			if (character == L'\r')
+				continue;
+			if (character == L'\n')
+			{
+				pen.m_X = 0.f;
+				pen.m_Y += lineSpacing;
+				continue;
+			}
+
+			const SpriteFont::Glyph* glyph = font.FindGlyph(character);
+			pen.m_X = std::max(pen.m_X + glyph->XOffset, 0.f);
+
+			const LONG width = glyph->Subrect.right - glyph->Subrect.left;
+			const LONG height = glyph->Subrect.bottom - glyph->Subrect.top;
+			if (!std::iswspace(character) || width > 1 || height > 1)
+			{
+				layout.m_Glyphs.push_back({ glyph->Subrect, { pen.m_X, pen.m_Y + glyph->YOffset } });
+				++pen.m_GlyphCount;
+
+				float measuredHeight = std::iswspace(static_cast<wint_t>(glyph->Character)) ?
+					lineSpacing :
+					std::max(static_cast<float>(height) + glyph->YOffset, lineSpacing);
+				pen.m_Width = std::max(pen.m_Width, pen.m_X + static_cast<float>(width));
+				pen.m_Height = std::max(pen.m_Height, pen.m_Y + measuredHeight);
+			}
+
+			pen.m_X += static_cast<float>(width) + glyph->XAdvance;
+		}
+	}
+
+	//Anything past a terminator is left with the end state
+	while (layout.m_Pens.size() < text.size() + 1)
+		layout.m_Pens.push_back(pen);
+
+	layout.m_Extents = { pen.m_Width, pen.m_Height };
+	m_Counters.m_LaidOutGlyphs += pen.m_GlyphCount - reused;
+}
@@ -0,0 +1,164 @@
+//*********************************************************************************\\
+//
+// Cache of laid out SpriteFont strings (glyph runs), keyed by font and string
+// hash. A layout holds the measured extents of the string (matching
+// SpriteFont::MeasureString) and the source rect and offset of every drawn
+// glyph (matching SpriteFont::DrawString), so a string is only laid out once
+// rather than every time it is measured for justification and again each draw.
+//
+// Strings that change a little at a time (scores, timers, debug text) are laid
+// out incrementally: when given the previous layout of the string, the pen
+// state is resumed from the end of the prefix both strings share, so only the
+// appended or replaced suffix is laid out again.
+//
+// Layouts are shared, so those still held (e.g. by an SFString) stay valid after
+// being evicted from the cache. Not thread safe, intended for use on the thread
+// updating and drawing UI.
+//
+//*********************************************************************************\\
+
+#pragma once
+
+//Library Includes
+#include <list>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+#include "SpriteFont.h"
+
+class GlyphLayoutCache
+{
+public:
+
+	//////////////////////////////
+	/// Enums, Types & Statics ///
+	//////////////////////////////
+
+	//Drawn glyph, with its offset from the start of the string (before origin and effects are applied)
+	struct PlacedGlyph
+	{
+		RECT m_Subrect;
+		DirectX::XMFLOAT2 m_Offset;
+	};
+
+	//Layout state at a point in the string, for resuming from
+	struct Pen
+	{
+		float m_X = 0.f;
+		float m_Y = 0.f;
+		//Extents of the glyphs before this point
+		float m_Width = 0.f;
+		float m_Height = 0.f;
+		uint32_t m_GlyphCount = 0;
+	};
+
+	struct Layout
+	{
+		const DirectX::SpriteFont* m_Font = nullptr;
+		std::string m_Text;
+		size_t m_Hash = 0;
+		std::vector<PlacedGlyph> m_Glyphs;
+		//Pen state before each byte of the text, plus one for the end
+		std::vector<Pen> m_Pens;
+		//Measured size, as returned by SpriteFont::MeasureString
+		DirectX::XMFLOAT2 m_Extents = { 0.f, 0.f };
+	};
+	typedef std::shared_ptr<const Layout> LayoutPtr;
+
+	struct Settings
+	{
+		//Layouts kept before evicting the least recently used
+		size_t m_MaxLayouts = 256;
+	};
+
+	struct Counters
+	{
+		uint64_t m_Hits = 0;
+		uint64_t m_Misses = 0;
+		//Misses laid out from a previous layout, and the glyphs reused + laid out between all misses
+		uint64_t m_IncrementalLayouts = 0;
+		uint64_t m_ReusedGlyphs = 0;
+		uint64_t m_LaidOutGlyphs = 0;
+		uint64_t m_Evictions = 0;
+	};
+
+	//Shared cache used by SFString
+	static GlyphLayoutCache& GetShared();
+
+	////////////////////
+	/// Constructors ///
+	////////////////////
+
+	GlyphLayoutCache() { }
+	~GlyphLayoutCache() { }
+
+	//////////////////
+	/// Operations ///
+	//////////////////
+
+	/*
+		Gets the layout of the text with the given font, laying it out if not cached. If given the previous
+		layout of a changed string (with the same font), the prefix shared with it is reused.
+	*/
+	LayoutPtr Acquire(const DirectX::SpriteFont* font, const std::string& text, const Layout* previous = nullptr);
+
+	//Drops every layout made with the font (call before a font is released, as its address may be reused)
+	void InvalidateFont(const DirectX::SpriteFont* font);
+	void Clear();
+
+	/*
+		Draws a layout to the batch, matching SpriteFont::DrawString with the same parameters (including
+		mirroring effects), but without converting, looking up or placing any glyphs.
+	*/
+	static void XM_CALLCONV Draw(const Layout& layout, DirectX::SpriteBatch* batch, const DirectX::XMFLOAT2& position, DirectX::FXMVECTOR colour,
+		float rotation, const DirectX::XMFLOAT2& origin, float scale, DirectX::SpriteEffects effects, float layerDepth);
+
+	/////////////////
+	/// Accessors ///
+	/////////////////
+
+	void SetSettings(const Settings& settings) { m_Settings = settings; }
+	const Settings& GetSettings() { return m_Settings; }
+	const Counters& GetCounters() { return m_Counters; }
+	void ResetCounters() { m_Counters = Counters(); }
+	size_t GetLayoutCount() { return m_Layouts.size(); }
+
+private:
+
+	//////////////////////////////
+	/// Enums, Types & Statics ///
+	//////////////////////////////
+
+	struct Key
+	{
+		const DirectX::SpriteFont* m_Font;
+		size_t m_Hash;
+
+		bool operator==(const Key& other) const { return m_Font == other.m_Font && m_Hash == other.m_Hash; }
+	};
+
+	struct KeyHasher
+	{
+		size_t operator()(const Key& key) const { return std::hash<const void*>()(key.m_Font) ^ (key.m_Hash * 0x9E3779B97F4A7C15ull); }
+	};
+
+	//////////////////
+	/// Operations ///
+	//////////////////
+
+	//Lays out the text, resuming from the shared prefix of the previous layout if given
+	void LayoutText(Layout& layout, const Layout* previous);
+
+	////////////
+	/// Data ///
+	////////////
+
+	Settings m_Settings;
+	Counters m_Counters;
+
+	//Most recently used first
+	std::list<std::shared_ptr<Layout>> m_Layouts;
+	std::unordered_map<Key, std::list<std::shared_ptr<Layout>>::iterator, KeyHasher> m_Lookup;
+};
@@ -0,0 +1,72 @@
+#include "RenderSortKey.h"
+
+//Library Includes
+#include <cstring>
+#include <algorithm>
+
+uint64_t RenderSortKey::Build(unsigned batch, float depth, uint32_t textureID, uint32_t order)
+{
+	return (static_cast<uint64_t>(std::min<uint32_t>(batch, BATCH_MASK)) << BATCH_SHIFT) |
+		(static_cast<uint64_t>(QuantiseDepth(depth)) << DEPTH_SHIFT) |
+		(static_cast<uint64_t>(std::min<uint32_t>(textureID, TEXTURE_MASK)) << TEXTURE_SHIFT) |
+		(static_cast<uint64_t>(std::min<uint32_t>(order, ORDER_MASK)) << ORDER_SHIFT);
+}
+
+void RenderSortKey::Sort(std::vector<Entry>& entries, std::vector<Entry>& scratch)
+{
+	const size_t count = entries.size();
+	if (count < 2)
+		return;
+
+	//Count every byte in one read of the keys
+	static constexpr unsigned FIRST_BYTE = TEXTURE_SHIFT / 8;
+	uint32_t histograms[8][256];
+	std::memset(histograms, 0, sizeof(histograms));
+	for (auto& entry : entries)
+	{
+		for (unsigned byte(FIRST_BYTE); byte < 8; ++byte)
+			++histograms[byte][(entry.m_Key >> (byte * 8)) & 0xFF];
+	}
+
+	scratch.resize(count);
+	std::vector<Entry>* src = &entries;
+	std::vector<Entry>* dst = &scratch;
+
+	for (unsigned byte(FIRST_BYTE); byte < 8; ++byte)
+	{
+		//Skip bytes every key shares (e.g. the batch, or texture ID in a single texture group)
+		uint32_t* histogram = histograms[byte];
+		if (histogram[(entries[0].m_Key >> (byte * 8)) & 0xFF] == count)
+			continue;
+
+		//Counts to offsets
+		uint32_t offset = 0;
+		for (unsigned i(0); i < 256; ++i)
+		{
+			uint32_t bucket = histogram[i];
+			histogram[i] = offset;
+			offset += bucket;
+		}
+
+		const unsigned shift = byte * 8;
+		for (auto& entry : *src)
+			(*dst)[histogram[(entry.m_Key >> shift) & 0xFF]++] = entry;
+
+		std::swap(src, dst);
+	}
+
+	//Odd number of passes leaves the result in the scratch
+	if (src != &entries)
+		entries.swap(scratch);
+}
+
+uint32_t RenderSortKey::QuantiseDepth(float depth)
+{
+	//Flip float bits so they order as unsigned (negatives reversed, positives above them)
+	uint32_t bits;
+	std::memcpy(&bits, &depth, sizeof(bits));
+	bits = (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+
+	//Keep the most significant bits, inverted for high to low
+	return ~(bits >> (32 - 24)) & DEPTH_MASK;
+}
@@ -0,0 +1,63 @@
+//*********************************************************************************\\
+//
+// Packed 64-bit sort keys for render group submissions, and an LSD radix sort
+// over them. Keys pack everything draw order depends on, highest bits first:
+//
+//	[63..56] Batch (render group index)
+//	[55..32] Depth, quantised and inverted so higher depths sort first (engine standard)
+//	[31..16] Texture ID, so equal depths are grouped by texture (fewer batch breaks)
+//	[15..0]  Submission order (saturating)
+//
+// Sorting ascending then gives depth order and texture coherence in one pass,
+// with keys compared as plain integers rather than through actor pointers.
+//
+//*********************************************************************************\\
+
+#pragma once
+
+//Library Includes
+#include <vector>
+#include <cstdint>
+
+class RenderSortKey
+{
+public:
+
+	//////////////////////////////
+	/// Enums, Types & Statics ///
+	//////////////////////////////
+
+	static constexpr unsigned ORDER_SHIFT = 0;
+	static constexpr unsigned TEXTURE_SHIFT = 16;
+	static constexpr unsigned DEPTH_SHIFT = 32;
+	static constexpr unsigned BATCH_SHIFT = 56;
+
+	static constexpr uint32_t ORDER_MASK = 0xFFFF;
+	static constexpr uint32_t TEXTURE_MASK = 0xFFFF;
+	static constexpr uint32_t DEPTH_MASK = 0xFFFFFF;
+	static constexpr uint32_t BATCH_MASK = 0xFF;
+
+	//Key with the index of what it was built for
+	struct Entry
+	{
+		uint64_t m_Key;
+		uint32_t m_Index;
+	};
+
+	//////////////////
+	/// Operations ///
+	//////////////////
+
+	//Builds a key (texture ID and order saturate to their field, so any ID past it sorts last)
+	static uint64_t Build(unsigned batch, float depth, uint32_t textureID, uint32_t order);
+
+	/*
+		Sorts the entries by key (ascending, stable), using the scratch for the passes. Passes are only run over key
+		bytes that differ between entries, and never over the order bytes, as entries are expected in submission
+		order already (which the stable passes preserve).
+	*/
+	static void Sort(std::vector<Entry>& entries, std::vector<Entry>& scratch);
+
+	//Maps a depth to an unsigned value in the same order (higher depths giving lower values), quantised to the depth field
+	static uint32_t QuantiseDepth(float depth);
+};
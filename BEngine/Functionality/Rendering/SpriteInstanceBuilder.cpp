@@ -0,0 +1,110 @@
+#include "SpriteInstanceBuilder.h"
+
+//Utilities
+#include "Utils/Utils_Debug.h"
+
+//Engine Includes
+#include "Types/BE_SharedTypes.h"
+
+using namespace DirectX;
+
+/*
+	Selection masks for flip effects (indexed by effect), picking swapped UV components from the fully flipped rect.
+*/
+static const XMVECTORU32 s_FlipMasks[4] =
+{
+	{ { { 0, 0, 0, 0 } } },										//None
+	{ { { 0xFFFFFFFF, 0, 0xFFFFFFFF, 0 } } },					//Flip Horizontally
+	{ { { 0, 0xFFFFFFFF, 0, 0xFFFFFFFF } } },					//Flip Vertically
+	{ { { 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF } } }	//Flip Both
+};
+
+size_t SpriteInstanceBuilder::Build(const SpriteData* const* sprites, size_t count, SpriteInstance* outInstances, size_t capacity)
+{
+	return BuildInternal(count, [sprites](size_t i) { return sprites[i]; }, outInstances, capacity);
+}
+
+size_t SpriteInstanceBuilder::Build(const SpriteData* sprites, size_t count, SpriteInstance* outInstances, size_t capacity)
+{
+	return BuildInternal(count, [sprites](size_t i) { return &sprites[i]; }, outInstances, capacity);
+}
+
+void SpriteInstanceBuilder::WriteInstance(const SpriteData& sprite, SpriteInstance& outInstance)
+{
+	const SpriteFrame& frame = sprite.m_Texture->m_Frames[sprite.m_FrameIndex];
+
+	XMVECTOR scale = XMLoadFloat2(&sprite.m_Scale);
+	float rotation = sprite.m_Rotation + sprite.m_RotationOffset;
+	unsigned effect = static_cast<unsigned>(sprite.m_SprEffect) & 3;
+
+	//Rotated frames are drawn rotated back, with scale and flips swapped to texture space (as SpriteData::Draw)
+	if (frame.m_Rotated)
+	{
+		scale = XMVectorSwizzle<1, 0, 2, 3>(scale);
+		rotation -= XM_PIDIV2;
+		effect = ((effect & 1) << 1) | ((effect & 2) >> 1);
+	}
+
+	//UVs, swapping edges for any flips (done as a select so there is no branching per effect)
+	XMVECTOR uv = XMLoadFloat4(&frame.m_UV);
+	XMVECTOR flipped = XMVectorSwizzle<2, 3, 0, 1>(uv);
+	uv = XMVectorSelect(uv, flipped, s_FlipMasks[effect]);
+
+	//Size and origin (xy only, zw unused). Trimmed frames only cover their trimmed area.
+	XMVECTOR frameSize = XMLoadFloat2(&frame.m_Size);
+	XMVECTOR size = XMVectorMultiply(frameSize, scale);
+	XMVECTOR origin = XMVectorDivide(XMLoadFloat2(&frame.m_Origin), frameSize);
+
+	XMVECTOR position = XMVectorAdd(XMLoadFloat2(&sprite.m_Position), XMLoadFloat2(&sprite.m_PositionOffset));
+
+	XMStoreFloat4(&outInstance.m_UV, uv);
+	XMStoreFloat4(&outInstance.m_Colour, sprite.m_Colour);
+	XMStoreFloat2(&outInstance.m_Position, position);
+	XMStoreFloat2(&outInstance.m_Size, size);
+	XMStoreFloat2(&outInstance.m_Origin, origin);
+	outInstance.m_Rotation = rotation;
+	outInstance.m_Depth = sprite.m_LayerDepth;
+}
+
+template<class GetSprite>
+size_t SpriteInstanceBuilder::BuildInternal(size_t count, GetSprite getSprite, SpriteInstance* outInstances, size_t capacity)
+{
+	m_Batches.clear();
+	m_SkippedCount = 0;
+
+	size_t written = 0;
+	for (size_t i = 0; i < count; ++i)
+	{
+		const SpriteData* spr = getSprite(i);
+
+		//Nothing to draw with
+		if (!spr->m_Texture)
+		{
+			++m_SkippedCount;
+			continue;
+		}
+
+		if (written >= capacity)
+		{
+			msg_assert(false, "Build(): Instance buffer is full!");
+			m_SkippedCount += count - i;
+			break;
+		}
+
+		WriteInstance(*spr, outInstances[written]);
+
+		//Start a new batch on texture change
+		if (m_Batches.empty() || m_Batches.back().m_Texture != spr->m_Texture)
+		{
+			Batch batch;
+			batch.m_Texture = spr->m_Texture;
+			batch.m_First = written;
+			m_Batches.push_back(batch);
+		}
+		++m_Batches.back().m_Count;
+
+		++written;
+	}
+
+	return written;
+}
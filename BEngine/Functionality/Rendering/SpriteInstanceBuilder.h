@@ -0,0 +1,112 @@
+//*********************************************************************************\\
+//
+// Builds packed per-sprite instance records from SpriteData, for renderers that
+// draw sprites as instanced quads (one upload + draw per texture) rather than
+// going through SpriteBatch one sprite at a time.
+//
+// Records are written into a caller-provided buffer (e.g. a mapped upload buffer)
+// using DirectXMath vector operations, with UVs taken from the textures baked
+// frame table. The builder has no knowledge of the graphics API, so it can be
+// used (and tested) without a device.
+//
+//*********************************************************************************\\
+
+#pragma once
+
+//Library Includes
+#include <DirectXMath.h>
+#include <vector>
+#include <cstddef>
+
+//Forward Declarations
+class SpriteData;
+struct SpriteTexture;
+
+/*
+	Packed instance record (64 bytes, 16 byte aligned). The quad is expected to be expanded from a unit quad,
+	offset by the origin, scaled by the size, rotated and then moved into position.
+*/
+struct alignas(16) SpriteInstance
+{
+	//Normalised texture rect (left, top, right, bottom), with flip effects applied
+	DirectX::XMFLOAT4 m_UV;
+	DirectX::XMFLOAT4 m_Colour;
+	//Position with offset applied
+	DirectX::XMFLOAT2 m_Position;
+	//Size of the quad in pixels (frame size multiplied by scale)
+	DirectX::XMFLOAT2 m_Size;
+	//Origin normalised to the frame (e.g. 0.5, 0.5 for a centred origin)
+	DirectX::XMFLOAT2 m_Origin;
+	//Rotation in radians, with offset applied
+	float m_Rotation;
+	float m_Depth;
+};
+
+static_assert(sizeof(SpriteInstance) == 64, "SpriteInstance should stay packed to 64 bytes!");
+
+class SpriteInstanceBuilder
+{
+public:
+
+	//////////////////////////////
+	/// Enums, Types & Statics ///
+	//////////////////////////////
+
+	/*
+		Run of consecutive instances sharing a texture (i.e. a single instanced draw). Sort sprites by texture
+		before building to keep the number of batches down.
+	*/
+	struct Batch
+	{
+		const SpriteTexture* m_Texture = nullptr;
+		size_t m_First = 0;
+		size_t m_Count = 0;
+	};
+
+	////////////////////
+	/// Constructors ///
+	////////////////////
+
+	SpriteInstanceBuilder() { }
+	~SpriteInstanceBuilder() { }
+
+	//////////////////
+	/// Operations ///
+	//////////////////
+
+	/*
+		Writes instance records for each sprite into the given buffer, returning the number written. Sprites
+		without a texture are skipped, and building stops if the buffer is full.
+	*/
+	size_t Build(const SpriteData* const* sprites, size_t count, SpriteInstance* outInstances, size_t capacity);
+	//Contiguous sprite array version
+	size_t Build(const SpriteData* sprites, size_t count, SpriteInstance* outInstances, size_t capacity);
+
+	//Writes single instance record (sprite must have a texture set)
+	static void WriteInstance(const SpriteData& sprite, SpriteInstance& outInstance);
+
+	/////////////////
+	/// Accessors ///
+	/////////////////
+
+	//Batches from the last build
+	const std::vector<Batch>& GetBatches() { return m_Batches; }
+	//Number of sprites skipped (no texture or no room) in the last build
+	size_t GetSkippedCount() { return m_SkippedCount; }
+
+private:
+
+	//////////////////
+	/// Operations ///
+	//////////////////
+
+	template<class GetSprite>
+	size_t BuildInternal(size_t count, GetSprite getSprite, SpriteInstance* outInstances, size_t capacity);
+
+	////////////
+	/// Data ///
+	////////////
+
+	std::vector<Batch> m_Batches;
+	size_t m_SkippedCount = 0;
+};
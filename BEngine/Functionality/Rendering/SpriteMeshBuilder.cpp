@@ -0,0 +1,140 @@
+#include "SpriteMeshBuilder.h"
+
+//Library Includes
+#include <utility>
+
+//Utilities
+#include "Utils/Utils_Debug.h"
+
+//Engine Includes
+#include "Types/BE_SharedTypes.h"
+
+using namespace DirectX;
+
+//Corners used for frames without a hull
+static const XMFLOAT2 s_QuadCorners[4] = { { 0.f, 0.f }, { 1.f, 0.f }, { 1.f, 1.f }, { 0.f, 1.f } };
+
+size_t SpriteMeshBuilder::Build(const SpriteData* const* sprites, size_t count, Vertex* outVertices, size_t vertexCapacity, Index* outIndices, size_t indexCapacity)
+{
+	m_Batches.clear();
+	m_VertexCount = 0;
+	m_IndexCount = 0;
+	m_SkippedCount = 0;
+
+	size_t written = 0;
+	for (size_t i = 0; i < count; ++i)
+	{
+		const SpriteData* spr = sprites[i];
+
+		//Nothing to draw with
+		if (!spr->m_Texture)
+		{
+			++m_SkippedCount;
+			continue;
+		}
+
+		//Drawn as a triangle fan, as a list
+		unsigned vertCount = GetVertexCount(*spr);
+		unsigned indexCount = (vertCount - 2) * 3;
+		if (m_VertexCount + vertCount > vertexCapacity || m_IndexCount + indexCount > indexCapacity)
+		{
+			msg_assert(false, "Build(): Mesh buffers are full!");
+			m_SkippedCount += count - i;
+			break;
+		}
+
+		WriteVertices(*spr, outVertices + m_VertexCount);
+
+		Index base = static_cast<Index>(m_VertexCount);
+		Index* indices = outIndices + m_IndexCount;
+		for (unsigned v(1); v + 1 < vertCount; ++v)
+		{
+			*indices++ = base;
+			*indices++ = base + v;
+			*indices++ = base + v + 1;
+		}
+
+		//Start a new batch on texture change
+		if (m_Batches.empty() || m_Batches.back().m_Texture != spr->m_Texture)
+		{
+			Batch batch;
+			batch.m_Texture = spr->m_Texture;
+			batch.m_FirstIndex = m_IndexCount;
+			m_Batches.push_back(batch);
+		}
+		m_Batches.back().m_IndexCount += indexCount;
+
+		m_VertexCount += vertCount;
+		m_IndexCount += indexCount;
+		++written;
+	}
+
+	return written;
+}
+
+unsigned SpriteMeshBuilder::GetVertexCount(const SpriteData& sprite)
+{
+	const SpriteFrame& frame = sprite.m_Texture->m_Frames[sprite.m_FrameIndex];
+	return frame.m_HullCount ? frame.m_HullCount : 4;
+}
+
+void SpriteMeshBuilder::WriteVertices(const SpriteData& sprite, Vertex* outVertices)
+{
+	const SpriteFrame& frame = sprite.m_Texture->m_Frames[sprite.m_FrameIndex];
+
+	XMFLOAT2 scale = sprite.m_Scale;
+	float rotation = sprite.m_Rotation + sprite.m_RotationOffset;
+	unsigned effect = static_cast<unsigned>(sprite.m_SprEffect) & 3;
+
+	//Rotated frames are drawn rotated back, with scale and flips swapped to texture space (as SpriteData::Draw)
+	if (frame.m_Rotated)
+	{
+		std::swap(scale.x, scale.y);
+		rotation -= XM_PIDIV2;
+		effect = ((effect & 1) << 1) | ((effect & 2) >> 1);
+	}
+
+	//Frame is placed around its origin unflipped (flips only change where the texture is sampled)
+	float sizeX = frame.m_Size.x * scale.x;
+	float sizeY = frame.m_Size.y * scale.y;
+	float originX = frame.m_Origin.x / frame.m_Size.x;
+	float originY = frame.m_Origin.y / frame.m_Size.y;
+	const bool flipX = (effect & 1) != 0;
+	const bool flipY = (effect & 2) != 0;
+
+	float sin, cos;
+	XMScalarSinCos(&sin, &cos, rotation);
+
+	float posX = sprite.m_Position.x + sprite.m_PositionOffset.x;
+	float posY = sprite.m_Position.y + sprite.m_PositionOffset.y;
+
+	XMFLOAT4 colour;
+	XMStoreFloat4(&colour, sprite.m_Colour);
+
+	const XMFLOAT2* corners = frame.m_HullCount ? &sprite.m_Texture->m_HullVertices[frame.m_HullFirst] : s_QuadCorners;
+	const unsigned count = frame.m_HullCount ? frame.m_HullCount : 4;
+	for (unsigned i(0); i < count; ++i)
+	{
+		const XMFLOAT2& t = corners[i];
+
+		/*
+			Flipped sprites sample the mirrored texture coordinate at each quad corner (as SpriteBatch, texcoord =
+			cornerOffsets[i ^ mirrorBits]). So a point of the texture lands at its mirror on the quad, which keeps
+			hulls over the pixels they were built around.
+		*/
+		float cornerX = flipX ? 1.f - t.x : t.x;
+		float cornerY = flipY ? 1.f - t.y : t.y;
+
+		//Frame local position, then scaled, rotated and moved into place
+		float x = (cornerX - originX) * sizeX;
+		float y = (cornerY - originY) * sizeY;
+
+		Vertex& vert = outVertices[i];
+		vert.position = XMFLOAT3(posX + x * cos - y * sin, posY + x * sin + y * cos, sprite.m_LayerDepth);
+		vert.color = colour;
+		vert.textureCoordinate = XMFLOAT2(
+			frame.m_UV.x + (frame.m_UV.z - frame.m_UV.x) * t.x,
+			frame.m_UV.y + (frame.m_UV.w - frame.m_UV.y) * t.y
+		);
+	}
+}
@@ -0,0 +1,94 @@
+//*********************************************************************************\\
+//
+// Builds triangle meshes from SpriteData, using each frames polygon hull where it
+// has one (see SpriteHullBuilder) and a quad where it doesn't. Hulls hug the
+// visible pixels, so mostly transparent sprites shade far fewer pixels than when
+// drawn as quads (at the cost of a few more vertices).
+//
+// Like SpriteInstanceBuilder, vertices and indices are written into caller
+// provided buffers and the builder has no knowledge of the graphics API.
+// Transforms match SpriteBatch (origin, flips, scale, rotation), so sprites look
+// the same whichever path draws them.
+//
+//*********************************************************************************\\
+
+#pragma once
+
+//Library Includes
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include "VertexTypes.h"
+
+//Forward Declarations
+class SpriteData;
+struct SpriteTexture;
+
+class SpriteMeshBuilder
+{
+public:
+
+	//////////////////////////////
+	/// Enums, Types & Statics ///
+	//////////////////////////////
+
+	typedef DirectX::VertexPositionColorTexture Vertex;
+	typedef uint32_t Index;
+
+	//Run of consecutive indices sharing a texture (i.e. a single indexed draw)
+	struct Batch
+	{
+		const SpriteTexture* m_Texture = nullptr;
+		size_t m_FirstIndex = 0;
+		size_t m_IndexCount = 0;
+	};
+
+	////////////////////
+	/// Constructors ///
+	////////////////////
+
+	SpriteMeshBuilder() { }
+	~SpriteMeshBuilder() { }
+
+	//////////////////
+	/// Operations ///
+	//////////////////
+
+	/*
+		Writes vertices and (triangle list) indices for each sprite into the given buffers, returning the number of
+		sprites written. Sprites without a texture are skipped, and building stops if either buffer is full.
+	*/
+	size_t Build(const SpriteData* const* sprites, size_t count, Vertex* outVertices, size_t vertexCapacity, Index* outIndices, size_t indexCapacity);
+
+	//Gets the number of vertices the sprites current frame is drawn with (sprite must have a texture set)
+	static unsigned GetVertexCount(const SpriteData& sprite);
+
+	/////////////////
+	/// Accessors ///
+	/////////////////
+
+	//Batches from the last build
+	const std::vector<Batch>& GetBatches() { return m_Batches; }
+	size_t GetVertexCount() { return m_VertexCount; }
+	size_t GetIndexCount() { return m_IndexCount; }
+	//Number of sprites skipped (no texture or no room) in the last build
+	size_t GetSkippedCount() { return m_SkippedCount; }
+
+private:
+
+	//////////////////
+	/// Operations ///
+	//////////////////
+
+	//Writes vertices for a sprite (count from GetVertexCount)
+	static void WriteVertices(const SpriteData& sprite, Vertex* outVertices);
+
+	////////////
+	/// Data ///
+	////////////
+
+	std::vector<Batch> m_Batches;
+	size_t m_VertexCount = 0;
+	size_t m_IndexCount = 0;
+	size_t m_SkippedCount = 0;
+};
@@ -0,0 +1,112 @@
+#include "ViewportCuller.h"
+
+//Library Includes
+#include <cmath>
+#include <cfloat>
+#include <algorithm>
+
+//Utilities
+#include "Utils/Utils_Debug.h"
+
+//Engine Includes
+#include "Types/BE_SharedTypes.h"
+
+using namespace DirectX;
+
+bool ViewportCuller::BuildVisibleRect(float viewportWidth, float viewportHeight, const DirectX::XMMATRIX* transform, DirectX::XMFLOAT4& outRect)
+{
+	if (!transform)
+	{
+		outRect = { 0.f, 0.f, viewportWidth, viewportHeight };
+		return true;
+	}
+
+	//Map the viewport corners back through the transform
+	XMVECTOR det;
+	XMMATRIX inverse = XMMatrixInverse(&det, *transform);
+	if (std::fabs(XMVectorGetX(det)) < FLT_EPSILON)
+		return false;
+
+	XMVECTOR corners[4] =
+	{
+		XMVector2TransformCoord(XMVectorSet(0.f, 0.f, 0.f, 0.f), inverse),
+		XMVector2TransformCoord(XMVectorSet(viewportWidth, 0.f, 0.f, 0.f), inverse),
+		XMVector2TransformCoord(XMVectorSet(0.f, viewportHeight, 0.f, 0.f), inverse),
+		XMVector2TransformCoord(XMVectorSet(viewportWidth, viewportHeight, 0.f, 0.f), inverse)
+	};
+
+	XMVECTOR min = XMVectorMin(XMVectorMin(corners[0], corners[1]), XMVectorMin(corners[2], corners[3]));
+	XMVECTOR max = XMVectorMax(XMVectorMax(corners[0], corners[1]), XMVectorMax(corners[2], corners[3]));
+	outRect = { XMVectorGetX(min), XMVectorGetY(min), XMVectorGetX(max), XMVectorGetY(max) };
+	return true;
+}
+
+void ViewportCuller::Reset()
+{
+	m_X.clear();
+	m_Y.clear();
+	m_Radius.clear();
+	m_Count = 0;
+}
+
+uint32_t ViewportCuller::AddSprite(const SpriteData& sprite)
+{
+	msg_assert(sprite.m_Texture, "AddSprite(): Sprite has no texture!");
+	const SpriteFrame& frame = sprite.m_Texture->m_Frames[sprite.m_FrameIndex];
+
+	//Furthest corner from the origin (either side, for flips), at the largest scale (rotated frames swap scale axes)
+	float extentX = std::max(std::fabs(frame.m_Origin.x), std::fabs(frame.m_Size.x - frame.m_Origin.x));
+	float extentY = std::max(std::fabs(frame.m_Origin.y), std::fabs(frame.m_Size.y - frame.m_Origin.y));
+	float scale = std::max(std::fabs(sprite.m_Scale.x), std::fabs(sprite.m_Scale.y));
+
+	return AddBounds(
+		sprite.m_Position.x + sprite.m_PositionOffset.x,
+		sprite.m_Position.y + sprite.m_PositionOffset.y,
+		std::sqrt(extentX * extentX + extentY * extentY) * scale
+	);
+}
+
+uint32_t ViewportCuller::AddBounds(float x, float y, float radius)
+{
+	m_X.push_back(x);
+	m_Y.push_back(y);
+	m_Radius.push_back(radius);
+	return m_Count++;
+}
+
+uint32_t ViewportCuller::Cull(const DirectX::XMFLOAT4& visibleRect)
+{
+	//Pad to whole vectors with bounds that are never visible
+	const size_t padded = (static_cast<size_t>(m_Count) + 3) & ~static_cast<size_t>(3);
+	m_X.resize(padded, 0.f);
+	m_Y.resize(padded, 0.f);
+	m_Radius.resize(padded, -FLT_MAX);
+	m_Visible.resize(padded);
+
+	//Bounds overlap the rect if within the rects half size (plus radius) of its centre on both axes
+	const XMVECTOR centreX = XMVectorReplicate((visibleRect.x + visibleRect.z) * 0.5f);
+	const XMVECTOR centreY = XMVectorReplicate((visibleRect.y + visibleRect.w) * 0.5f);
+	const XMVECTOR halfX = XMVectorReplicate((visibleRect.z - visibleRect.x) * 0.5f);
+	const XMVECTOR halfY = XMVectorReplicate((visibleRect.w - visibleRect.y) * 0.5f);
+
+	for (size_t i(0); i < padded; i += 4)
+	{
+		XMVECTOR x = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&m_X[i]));
+		XMVECTOR y = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&m_Y[i]));
+		XMVECTOR radius = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&m_Radius[i]));
+
+		XMVECTOR inX = XMVectorLessOrEqual(XMVectorAbs(XMVectorSubtract(x, centreX)), XMVectorAdd(halfX, radius));
+		XMVECTOR inY = XMVectorLessOrEqual(XMVectorAbs(XMVectorSubtract(y, centreY)), XMVectorAdd(halfY, radius));
+		XMStoreInt4(&m_Visible[i], XMVectorAndInt(inX, inY));
+	}
+
+	//Drop the padding again, so more bounds can be added after
+	m_X.resize(m_Count);
+	m_Y.resize(m_Count);
+	m_Radius.resize(m_Count);
+
+	uint32_t visibleCount = 0;
+	for (uint32_t i(0); i < m_Count; ++i)
+		visibleCount += m_Visible[i] != 0;
+	return visibleCount;
+}
@@ -0,0 +1,77 @@
+//*********************************************************************************\\
+//
+// Culls sprite bounds against the visible area of a batch in bulk. Bounds are
+// gathered into flat arrays (position + radius per sprite), then tested four at
+// a time using DirectXMath vector operations against the visible rect.
+//
+// Sprite bounds are circles around the sprites position, large enough to hold
+// its scaled frame at any rotation, origin or flip, so they never cull a sprite
+// that could be seen. The visible rect is the viewport mapped back through the
+// batches transform (see SceneTransform), as the box around the (possibly
+// rotated) area, so culling is also conservative for rotated cameras.
+//
+//*********************************************************************************\\
+
+#pragma once
+
+//Library Includes
+#include <DirectXMath.h>
+#include <vector>
+#include <cstdint>
+
+//Forward Declarations
+class SpriteData;
+
+class ViewportCuller
+{
+public:
+
+	////////////////////
+	/// Constructors ///
+	////////////////////
+
+	ViewportCuller() { }
+	~ViewportCuller() { }
+
+	//////////////////
+	/// Operations ///
+	//////////////////
+
+	/*
+		Builds the visible rect (left, top, right, bottom) of a viewport in the space sprites are submitted in, through
+		the batch transform if given. Returns false if the transform can't be inverted (e.g. zero zoom).
+	*/
+	static bool BuildVisibleRect(float viewportWidth, float viewportHeight, const DirectX::XMMATRIX* transform, DirectX::XMFLOAT4& outRect);
+
+	//Clears all bounds
+	void Reset();
+	//Adds the bounds of a sprite (which must have a texture set), returning its index
+	uint32_t AddSprite(const SpriteData& sprite);
+	//Adds bounds directly, returning its index
+	uint32_t AddBounds(float x, float y, float radius);
+
+	//Tests every bound against the rect, returning the number visible (see IsVisible)
+	uint32_t Cull(const DirectX::XMFLOAT4& visibleRect);
+
+	/////////////////
+	/// Accessors ///
+	/////////////////
+
+	//Visibility of a bound from the last cull
+	bool IsVisible(uint32_t index) const { return m_Visible[index] != 0; }
+	uint32_t GetBoundsCount() const { return m_Count; }
+
+private:
+
+	////////////
+	/// Data ///
+	////////////
+
+	//Bounds by component (padded to a multiple of 4 for the vector tests)
+	std::vector<float> m_X;
+	std::vector<float> m_Y;
+	std::vector<float> m_Radius;
+	//Vector test masks (all bits set if visible)
+	std::vector<uint32_t> m_Visible;
+	uint32_t m_Count = 0;
+};
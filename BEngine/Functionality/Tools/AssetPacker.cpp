@@ -0,0 +1,229 @@
+#include "AssetPacker.h"
+
+//Library Includes
+#include <chrono>
+#include <fstream>
+#include <algorithm>
+
+//Utilities
+#include "Utils/Utils_Debug.h"
+#include "Utils/Utils_RapidJSON.h"
+
+//Engine Includes
+#include "IO/AssetPack.h"
+#include "IO/BlockCompressor.h"
+
+typedef std::chrono::high_resolution_clock Clock;
+
+//Reads a whole file, returning false if it couldn't be read
+static bool ReadWholeFile(const std::string& fp, std::vector<uint8_t>& outData)
+{
+	std::ifstream stream(fp, std::ios::binary | std::ios::ate);
+	if (!stream.is_open())
+		return false;
+
+	outData.resize(static_cast<size_t>(stream.tellg()));
+	stream.seekg(0, std::ios::beg);
+	return static_cast<bool>(stream.read(reinterpret_cast<char*>(outData.data()), outData.size()));
+}
+
+void AssetPacker::AddFile(const std::string& fp)
+{
+	File file;
+	file.m_Filepath = fp;
+	file.m_PackPath = AssetPack::NormalisePath(fp);
+
+	for (auto& added : m_Files)
+	{
+		if (added.m_PackPath == file.m_PackPath)
+			return;
+	}
+	m_Files.push_back(file);
+}
+
+bool AssetPacker::AddTextureManifest(const std::string& manifestFP)
+{
+	rapidjson::Document manifestDoc;
+	std::string error;
+	if (!ParseNewJSONDocument(manifestDoc, manifestFP, &error))
+	{
+		DBOUT("AddTextureManifest(): " << error);
+		return false;
+	}
+	if (!manifestDoc.HasMember("Manifests"))
+	{
+		msg_assert(false, "AddTextureManifest(): Manifest not found!");
+		return false;
+	}
+
+	AddFile(manifestFP);
+	for (auto& manifest : manifestDoc["Manifests"].GetArray())
+	{
+		for (auto& texture : manifest["Textures"].GetArray())
+		{
+			AddFile(texture["Texture_Filepath"].GetString());
+			AddFile(texture["Frames_Filepath"].GetString());
+			if (texture.HasMember("Animations_Filepath"))
+				AddFile(texture["Animations_Filepath"].GetString());
+		}
+	}
+
+	return true;
+}
+
+bool AssetPacker::AddFontManifest(const std::string& manifestFP)
+{
+	rapidjson::Document manifestDoc;
+	std::string error;
+	if (!ParseNewJSONDocument(manifestDoc, manifestFP, &error))
+	{
+		DBOUT("AddFontManifest(): " << error);
+		return false;
+	}
+	if (!manifestDoc.HasMember("Manifests"))
+	{
+		msg_assert(false, "AddFontManifest(): Manifest not found!");
+		return false;
+	}
+
+	AddFile(manifestFP);
+	for (auto& manifest : manifestDoc["Manifests"].GetArray())
+	{
+		for (auto& font : manifest["Fonts"].GetArray())
+			AddFile(font["Font Filepath"].GetString());
+	}
+
+	return true;
+}
+
+bool AssetPacker::Write(const std::string& packFP, const Settings& settings)
+{
+	auto start = Clock::now();
+	m_Report = Report();
+
+	msg_assert(settings.m_Alignment >= 8 && (settings.m_Alignment & (settings.m_Alignment - 1)) == 0, "Write(): Alignment must be a power of 2 (8 or more)!");
+	const uint64_t alignMask = settings.m_Alignment - 1;
+	auto align = [alignMask](uint64_t offset) { return (offset + alignMask) & ~alignMask; };
+
+	//
+	//Read (and compress) every file
+	//
+
+	struct PackedFile
+	{
+		const File* m_File = nullptr;
+		std::vector<uint8_t> m_Data;
+		uint64_t m_Size = 0;
+		bool m_Compressed = false;
+	};
+
+	std::vector<PackedFile> packed;
+	packed.reserve(m_Files.size());
+	for (auto& file : m_Files)
+	{
+		PackedFile entry;
+		entry.m_File = &file;
+		if (!ReadWholeFile(file.m_Filepath, entry.m_Data))
+		{
+			DBOUT("Write(): Skipping file that couldn't be read: " << file.m_Filepath);
+			++m_Report.m_MissingCount;
+			continue;
+		}
+		entry.m_Size = entry.m_Data.size();
+		m_Report.m_SourceBytes += entry.m_Size;
+
+		//Only keep compressed data if it saves enough to be worth losing zero-copy access
+		if (settings.m_Compress && !entry.m_Data.empty())
+		{
+			std::vector<uint8_t> compressed;
+			BlockCompressor::Compress(entry.m_Data.data(), entry.m_Data.size(), compressed);
+			if (compressed.size() <= static_cast<size_t>(entry.m_Size * (1.0 - settings.m_MinSaving)))
+			{
+				entry.m_Data = std::move(compressed);
+				entry.m_Compressed = true;
+				++m_Report.m_CompressedCount;
+			}
+		}
+
+		packed.push_back(std::move(entry));
+	}
+
+	//Index is searched by path, so sort to match
+	std::sort(packed.begin(), packed.end(), [](const PackedFile& a, const PackedFile& b)
+	{
+		return a.m_File->m_PackPath < b.m_File->m_PackPath;
+	});
+
+	//
+	//Layout
+	//
+
+	AssetPack::Header header = {};
+	header.m_Magic = AssetPack::MAGIC;
+	header.m_Version = AssetPack::VERSION;
+	header.m_EntryCount = static_cast<uint32_t>(packed.size());
+	header.m_Alignment = settings.m_Alignment;
+	header.m_IndexOffset = sizeof(AssetPack::Header);
+	header.m_PathsOffset = header.m_IndexOffset + packed.size() * sizeof(AssetPack::IndexRecord);
+
+	std::vector<AssetPack::IndexRecord> index(packed.size());
+	std::string paths;
+	for (size_t i = 0; i < packed.size(); ++i)
+	{
+		const std::string& path = packed[i].m_File->m_PackPath;
+		index[i] = {};
+		index[i].m_PathOffset = static_cast<uint32_t>(paths.size());
+		index[i].m_PathLength = static_cast<uint32_t>(path.size());
+		paths += path;
+	}
+	header.m_PathsSize = paths.size();
+
+	uint64_t offset = align(header.m_PathsOffset + header.m_PathsSize);
+	for (size_t i = 0; i < packed.size(); ++i)
+	{
+		index[i].m_DataOffset = offset;
+		index[i].m_StoredSize = packed[i].m_Data.size();
+		index[i].m_Size = packed[i].m_Size;
+		index[i].m_Flags = packed[i].m_Compressed ? AssetPack::COMPRESSED : 0;
+		offset = align(offset + index[i].m_StoredSize);
+	}
+
+	//
+	//Write
+	//
+
+	std::ofstream file(packFP, std::ios::binary | std::ios::trunc);
+	if (!file.is_open())
+	{
+		DBOUT("Write(): Failed to open for writing: " << packFP);
+		return false;
+	}
+
+	file.write(reinterpret_cast<const char*>(&header), sizeof(AssetPack::Header));
+	file.write(reinterpret_cast<const char*>(index.data()), index.size() * sizeof(AssetPack::IndexRecord));
+	file.write(paths.data(), paths.size());
+
+	//Pad up to each entry
+	uint64_t written = header.m_PathsOffset + header.m_PathsSize;
+	const std::vector<char> padding(settings.m_Alignment, 0);
+	for (size_t i = 0; i < packed.size(); ++i)
+	{
+		file.write(padding.data(), index[i].m_DataOffset - written);
+		file.write(reinterpret_cast<const char*>(packed[i].m_Data.data()), packed[i].m_Data.size());
+		written = index[i].m_DataOffset + packed[i].m_Data.size();
+	}
+	if (!file)
+	{
+		DBOUT("Write(): Failed to write: " << packFP);
+		return false;
+	}
+
+	m_Report.m_EntryCount = header.m_EntryCount;
+	m_Report.m_PackBytes = written;
+	m_Report.m_Milliseconds = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+	DBOUT("Write(): Packed " << m_Report.m_EntryCount << " files (" << m_Report.m_CompressedCount << " compressed, " << m_Report.m_MissingCount << " missing), "
+		<< m_Report.m_SourceBytes << " bytes into " << m_Report.m_PackBytes << " in " << m_Report.m_Milliseconds << "ms: " << packFP);
+
+	return true;
+}
@@ -0,0 +1,96 @@
+//*********************************************************************************\\
+//
+// Offline asset pack builder. Gathers loose files (directly, or every file a
+// texture/font manifest references, along with the manifest itself) and writes
+// them into a single AssetPack, with an index sorted by path and each entry
+// aligned, optionally compressing entries that compress well enough (see
+// BlockCompressor). Files are stored under the paths they were added with, so
+// the manifests load unchanged once the pack is mounted.
+//
+//*********************************************************************************\\
+
+#pragma once
+
+//Library Includes
+#include <string>
+#include <vector>
+#include <cstdint>
+
+class AssetPacker
+{
+public:
+
+	//////////////////////////////
+	/// Enums, Types & Statics ///
+	//////////////////////////////
+
+	struct Settings
+	{
+		//Entry data alignment (power of 2)
+		unsigned m_Alignment = 16;
+		bool m_Compress = true;
+		//Share of an entries size compression must save for it to be stored compressed (otherwise left raw for zero-copy use)
+		float m_MinSaving = 0.1f;
+	};
+
+	//Summary of the last write
+	struct Report
+	{
+		unsigned m_EntryCount = 0;
+		unsigned m_CompressedCount = 0;
+		//Files added that couldn't be read (left out)
+		unsigned m_MissingCount = 0;
+		uint64_t m_SourceBytes = 0;
+		uint64_t m_PackBytes = 0;
+		double m_Milliseconds = 0.0;
+	};
+
+	////////////////////
+	/// Constructors ///
+	////////////////////
+
+	AssetPacker() { }
+	~AssetPacker() { }
+
+	//////////////////
+	/// Operations ///
+	//////////////////
+
+	//Adds a file (by the path it will be loaded with, duplicates are ignored)
+	void AddFile(const std::string& fp);
+	//Adds the manifest and each texture, frame and animation file of every manifest in it
+	bool AddTextureManifest(const std::string& manifestFP);
+	//Adds the manifest and each font file of every manifest in it
+	bool AddFontManifest(const std::string& manifestFP);
+
+	//Reads every added file and writes the pack, returning false if it couldn't be written
+	bool Write(const std::string& packFP, const Settings& settings);
+
+	/////////////////
+	/// Accessors ///
+	/////////////////
+
+	size_t GetFileCount() { return m_Files.size(); }
+	const Report& GetReport() { return m_Report; }
+
+private:
+
+	//////////////////////////////
+	/// Enums, Types & Statics ///
+	//////////////////////////////
+
+	struct File
+	{
+		//Path as added (read from), and as stored (normalised, see AssetPack::NormalisePath)
+		std::string m_Filepath;
+		std::string m_PackPath;
+	};
+
+	////////////
+	/// Data ///
+	////////////
+
+	std::vector<File> m_Files;
+
+	Report m_Report;
+};
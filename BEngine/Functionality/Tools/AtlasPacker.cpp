@@ -0,0 +1,399 @@
+#include "AtlasPacker.h"
+
+//Library Includes
+#include <memory>
+#include <cstring>
+#include <algorithm>
+#include <filesystem>
+
+//Utilities
+#include "Utils/Utils_Debug.h"
+#include "Utils/Utils_RapidJSON.h"
+
+//Engine Includes
+#include "Tools/MaxRectsBin.h"
+#include "Tools/DDSImage.h"
+
+//================================================================================\\
+// Packing Data
+//================================================================================\\
+
+//Frame region in the source sheet (in blocks), and where it was placed in the atlas
+struct SourceRegion
+{
+	int m_X = 0;
+	int m_Y = 0;
+	int m_W = 0;
+	int m_H = 0;
+	MaxRectsBin::Rect m_Placed;
+};
+
+struct SourceSheet
+{
+	//Index of the texture in the source manifest
+	unsigned m_EntryIndex = 0;
+	std::string m_Name;
+	rapidjson::Document m_FrameDoc;
+
+	DDSImage m_Image;
+
+	std::vector<SourceRegion> m_Regions;
+	//Region for each frame (frames sharing a rect share a region)
+	std::vector<unsigned> m_FrameRegions;
+	long long m_RegionArea = 0;
+
+	unsigned m_Atlas = 0;
+};
+
+struct Atlas
+{
+	MaxRectsBin m_Bin;
+	//Sheets packed into this atlas (first sheet also provides the format)
+	std::vector<SourceSheet*> m_Sheets;
+};
+
+//================================================================================\\
+// Helpers
+//================================================================================\\
+
+//Loads DDS and frame data, and works out the block aligned region for each frame
+static bool LoadSheet(SourceSheet& sheet, const std::string& textureFP, const std::string& framesFP)
+{
+	//
+	//Texture
+	//
+
+	if (!sheet.m_Image.Load(textureFP))
+		return false;
+
+	const int blockDim = sheet.m_Image.GetBlockDim();
+
+	//
+	//Frames
+	//
+
+	std::string error;
+	if (!ParseNewJSONDocument(sheet.m_FrameDoc, framesFP, &error) || !sheet.m_FrameDoc.HasMember("frames") || !sheet.m_FrameDoc["frames"].IsArray())
+	{
+		DBOUT("LoadSheet(): Failed to load frames: " << (error.empty() ? framesFP : error));
+		return false;
+	}
+
+	const rapidjson::Value& frames = sheet.m_FrameDoc["frames"];
+	sheet.m_FrameRegions.reserve(frames.Size());
+	for (unsigned i(0); i < frames.Size(); ++i)
+	{
+		const rapidjson::Value& frame = frames[i]["frame"];
+		int x = frame["x"].GetInt();
+		int y = frame["y"].GetInt();
+		int w = frame["w"].GetInt();
+		int h = frame["h"].GetInt();
+
+		//Rotated frames are stored in the sheet with their dims swapped
+		if (frames[i].HasMember("rotated") && frames[i]["rotated"].GetBool())
+			std::swap(w, h);
+
+		//Expand out to whole blocks
+		SourceRegion region;
+		region.m_X = x / blockDim;
+		region.m_Y = y / blockDim;
+		region.m_W = ((x + w + blockDim - 1) / blockDim) - region.m_X;
+		region.m_H = ((y + h + blockDim - 1) / blockDim) - region.m_Y;
+
+		if (region.m_X < 0 || region.m_Y < 0 || region.m_X + region.m_W > sheet.m_Image.GetBlocksWide() || region.m_Y + region.m_H > sheet.m_Image.GetBlocksHigh())
+		{
+			DBOUT("LoadSheet(): Frame outside of texture: " << framesFP);
+			return false;
+		}
+
+		//Reuse identical regions (e.g. duplicate frames)
+		unsigned regionIndex = static_cast<unsigned>(sheet.m_Regions.size());
+		for (unsigned j(0); j < sheet.m_Regions.size(); ++j)
+		{
+			const SourceRegion& other = sheet.m_Regions[j];
+			if (other.m_X == region.m_X && other.m_Y == region.m_Y && other.m_W == region.m_W && other.m_H == region.m_H)
+			{
+				regionIndex = j;
+				break;
+			}
+		}
+		if (regionIndex == sheet.m_Regions.size())
+		{
+			sheet.m_Regions.push_back(region);
+			sheet.m_RegionArea += static_cast<long long>(region.m_W) * region.m_H;
+		}
+
+		sheet.m_FrameRegions.push_back(regionIndex);
+	}
+
+	return true;
+}
+
+//Attempts to place all regions of a sheet in the bin, leaving the bin untouched if they don't all fit
+static bool PackSheet(SourceSheet& sheet, MaxRectsBin& bin, int paddingBlocks)
+{
+	//Place larger regions first
+	std::vector<unsigned> order(sheet.m_Regions.size());
+	for (unsigned i(0); i < order.size(); ++i)
+		order[i] = i;
+	std::sort(order.begin(), order.end(), [&sheet](unsigned a, unsigned b)
+	{
+		const SourceRegion& ra = sheet.m_Regions[a];
+		const SourceRegion& rb = sheet.m_Regions[b];
+		return std::max(ra.m_W, ra.m_H) > std::max(rb.m_W, rb.m_H);
+	});
+
+	MaxRectsBin trial = bin;
+	for (auto i : order)
+	{
+		SourceRegion& region = sheet.m_Regions[i];
+		if (!trial.Insert(region.m_W + paddingBlocks, region.m_H + paddingBlocks, region.m_Placed))
+			return false;
+	}
+
+	bin = trial;
+	return true;
+}
+
+static bool WriteAtlas(const Atlas& atlas, const std::string& fp, int& outWidth, int& outHeight)
+{
+	const DDSImage& format = atlas.m_Sheets.front()->m_Image;
+	const int blockDim = format.GetBlockDim();
+	const int blockBytes = format.GetBlockBytes();
+
+	//Crop to used area
+	MaxRectsBin bin = atlas.m_Bin;
+	int blocksWide = std::max(bin.GetUsedWidth(), 1);
+	int blocksHigh = std::max(bin.GetUsedHeight(), 1);
+	outWidth = blocksWide * blockDim;
+	outHeight = blocksHigh * blockDim;
+
+	//Copy regions in, row by row
+	std::vector<unsigned char> data(static_cast<size_t>(blocksWide) * blocksHigh * blockBytes, 0);
+	for (auto& sheet : atlas.m_Sheets)
+	{
+		const unsigned char* src = sheet->m_Image.GetData();
+		for (auto& region : sheet->m_Regions)
+		{
+			for (int row(0); row < region.m_H; ++row)
+			{
+				size_t srcOffset = (static_cast<size_t>(region.m_Y + row) * sheet->m_Image.GetBlocksWide() + region.m_X) * blockBytes;
+				size_t dstOffset = (static_cast<size_t>(region.m_Placed.m_Y + row) * blocksWide + region.m_Placed.m_X) * blockBytes;
+				std::memcpy(data.data() + dstOffset, src + srcOffset, static_cast<size_t>(region.m_W) * blockBytes);
+			}
+		}
+	}
+
+	return DDSImage::Write(fp, format, outWidth, outHeight, data);
+}
+
+//================================================================================\\
+// AtlasPacker
+//================================================================================\\
+
+bool AtlasPacker::PackManifest(const std::string& manifestFP, unsigned manifestIndex, const std::string& outputManifestFP, const Settings& settings)
+{
+	m_Report = Report();
+
+	//Load manifest document
+	rapidjson::Document manifestDoc;
+	std::string error;
+	if (!ParseNewJSONDocument(manifestDoc, manifestFP, &error))
+	{
+		DBOUT("PackManifest(): " << error);
+		return false;
+	}
+
+	if (!manifestDoc.HasMember("Manifests") || manifestIndex >= manifestDoc["Manifests"].Size())
+	{
+		msg_assert(false, "PackManifest(): Manifest not found!");
+		return false;
+	}
+
+	const rapidjson::Value& manifest = manifestDoc["Manifests"][manifestIndex];
+	const rapidjson::Value& textures = manifest["Textures"];
+	m_Report.m_SourceTextureCount = textures.Size();
+
+	//
+	//Load Sheets
+	//
+
+	std::vector<std::unique_ptr<SourceSheet>> sheets;
+	for (unsigned i(0); i < textures.Size(); ++i)
+	{
+		std::unique_ptr<SourceSheet> sheet = std::make_unique<SourceSheet>();
+		sheet->m_EntryIndex = i;
+		sheet->m_Name = textures[i]["Texture_Name"].GetString();
+
+		//Sheets that can't be packed are passed through as they are
+		if (LoadSheet(*sheet, textures[i]["Texture_Filepath"].GetString(), textures[i]["Frames_Filepath"].GetString()))
+			sheets.push_back(std::move(sheet));
+		else
+			DBOUT("PackManifest(): Passing through texture unpacked: " << textures[i]["Texture_Name"].GetString());
+	}
+
+	//
+	//Pack
+	//
+
+	//Largest sheets first
+	std::sort(sheets.begin(), sheets.end(), [](const std::unique_ptr<SourceSheet>& a, const std::unique_ptr<SourceSheet>& b)
+	{
+		return a->m_RegionArea > b->m_RegionArea;
+	});
+
+	std::vector<Atlas> atlases;
+	std::vector<SourceSheet*> packedSheets;
+	for (auto& sheet : sheets)
+	{
+		int paddingBlocks = (settings.m_Padding + sheet->m_Image.GetBlockDim() - 1) / sheet->m_Image.GetBlockDim();
+		int binSize = settings.m_MaxAtlasSize / sheet->m_Image.GetBlockDim();
+
+		//Try existing atlases of the same format first
+		bool packed = false;
+		for (unsigned i(0); i < atlases.size() && !packed; ++i)
+		{
+			if (!atlases[i].m_Sheets.front()->m_Image.IsSameFormat(sheet->m_Image))
+				continue;
+
+			if (PackSheet(*sheet, atlases[i].m_Bin, paddingBlocks))
+			{
+				sheet->m_Atlas = i;
+				atlases[i].m_Sheets.push_back(sheet.get());
+				packed = true;
+			}
+		}
+
+		//Otherwise start a new atlas
+		if (!packed)
+		{
+			Atlas atlas;
+			atlas.m_Bin.Init(binSize, binSize);
+			if (PackSheet(*sheet, atlas.m_Bin, paddingBlocks))
+			{
+				sheet->m_Atlas = static_cast<unsigned>(atlases.size());
+				atlas.m_Sheets.push_back(sheet.get());
+				atlases.push_back(std::move(atlas));
+				packed = true;
+			}
+			else
+				DBOUT("PackManifest(): Texture doesn't fit in an atlas, passing through unpacked: " << sheet->m_Name);
+		}
+
+		if (packed)
+		{
+			packedSheets.push_back(sheet.get());
+			m_Report.m_RegionCount += static_cast<unsigned>(sheet->m_Regions.size());
+		}
+	}
+
+	//
+	//Write Atlases & Frame Data
+	//
+
+	std::error_code ec;
+	std::filesystem::create_directories(settings.m_OutputDirectory, ec);
+
+	std::vector<std::string> atlasFPs(atlases.size());
+	std::vector<std::pair<int, int>> atlasSizes(atlases.size());
+	for (unsigned i(0); i < atlases.size(); ++i)
+	{
+		atlasFPs[i] = settings.m_OutputDirectory + settings.m_AtlasName + std::to_string(i) + ".dds";
+		if (!WriteAtlas(atlases[i], atlasFPs[i], atlasSizes[i].first, atlasSizes[i].second))
+		{
+			DBOUT("PackManifest(): Failed to write atlas: " << atlasFPs[i]);
+			return false;
+		}
+
+		m_Report.m_AtlasOccupancy.push_back(atlases[i].m_Bin.GetOccupancy());
+	}
+
+	//Frames keep their order, with only their position (and the sheet info) changed
+	std::vector<std::string> framesFPs(textures.Size());
+	for (auto& sheet : packedSheets)
+	{
+		rapidjson::Document& doc = sheet->m_FrameDoc;
+		rapidjson::Value& frames = doc["frames"];
+		const int blockDim = sheet->m_Image.GetBlockDim();
+
+		for (unsigned i(0); i < frames.Size(); ++i)
+		{
+			rapidjson::Value& frame = frames[i]["frame"];
+			const SourceRegion& region = sheet->m_Regions[sheet->m_FrameRegions[i]];
+
+			//Keep offset of the frame within its (block aligned) region
+			int offsetX = frame["x"].GetInt() - region.m_X * blockDim;
+			int offsetY = frame["y"].GetInt() - region.m_Y * blockDim;
+			frame["x"].SetInt(region.m_Placed.m_X * blockDim + offsetX);
+			frame["y"].SetInt(region.m_Placed.m_Y * blockDim + offsetY);
+		}
+
+		if (doc.HasMember("meta") && doc["meta"].IsObject())
+		{
+			rapidjson::Value& meta = doc["meta"];
+			std::string image = settings.m_AtlasName + std::to_string(sheet->m_Atlas) + ".dds";
+			if (meta.HasMember("image"))
+				meta["image"].SetString(image.c_str(), static_cast<rapidjson::SizeType>(image.size()), doc.GetAllocator());
+			if (meta.HasMember("size"))
+			{
+				meta["size"]["w"].SetInt(atlasSizes[sheet->m_Atlas].first);
+				meta["size"]["h"].SetInt(atlasSizes[sheet->m_Atlas].second);
+			}
+		}
+
+		framesFPs[sheet->m_EntryIndex] = settings.m_OutputDirectory + sheet->m_Name + ".json";
+		if (!WriteJSONDocument(doc, framesFPs[sheet->m_EntryIndex]))
+		{
+			DBOUT("PackManifest(): Failed to write frames: " << framesFPs[sheet->m_EntryIndex]);
+			return false;
+		}
+	}
+
+	//
+	//Write Manifest
+	//
+
+	rapidjson::Document outDoc;
+	outDoc.SetObject();
+	rapidjson::Document::AllocatorType& alloc = outDoc.GetAllocator();
+
+	//Copy of the source manifest, with packed textures pointed at their atlas and frames
+	rapidjson::Value outManifest(manifest, alloc);
+	rapidjson::Value& outTextures = outManifest["Textures"];
+	for (auto& sheet : packedSheets)
+	{
+		rapidjson::Value& entry = outTextures[sheet->m_EntryIndex];
+		const std::string& texFP = atlasFPs[sheet->m_Atlas];
+		const std::string& framesFP = framesFPs[sheet->m_EntryIndex];
+		entry["Texture_Filepath"].SetString(texFP.c_str(), static_cast<rapidjson::SizeType>(texFP.size()), alloc);
+		entry["Frames_Filepath"].SetString(framesFP.c_str(), static_cast<rapidjson::SizeType>(framesFP.size()), alloc);
+	}
+
+	rapidjson::Value manifests(rapidjson::kArrayType);
+	manifests.PushBack(outManifest, alloc);
+	outDoc.AddMember("Manifests", manifests, alloc);
+
+	if (!WriteJSONDocument(outDoc, outputManifestFP))
+	{
+		DBOUT("PackManifest(): Failed to write manifest: " << outputManifestFP);
+		return false;
+	}
+
+	//
+	//Report
+	//
+
+	m_Report.m_PackedTextureCount = static_cast<unsigned>(packedSheets.size());
+	m_Report.m_AtlasCount = static_cast<unsigned>(atlases.size());
+
+	DBOUT("PackManifest(): Packed " << m_Report.m_PackedTextureCount << "/" << m_Report.m_SourceTextureCount << " textures ("
+		<< m_Report.m_RegionCount << " regions) into " << m_Report.m_AtlasCount << " atlases. Distinct textures: "
+		<< m_Report.m_SourceTextureCount << " -> " << m_Report.GetDistinctTextureCount());
+	for (unsigned i(0); i < m_Report.m_AtlasOccupancy.size(); ++i)
+	{
+		DBOUT("PackManifest(): " << atlasFPs[i] << " (" << atlasSizes[i].first << "x" << atlasSizes[i].second << ") occupancy: "
+			<< m_Report.m_AtlasOccupancy[i] * 100.f << "%");
+	}
+
+	return true;
+}
@@ -0,0 +1,93 @@
+//*********************************************************************************\\
+//
+// Offline texture atlas packer. Reads a texture manifest (and the TexturePacker
+// frame data for each texture), packs the frames of several source sheets into
+// fewer, larger atlases, then writes the atlases, rewritten frame data and a new
+// manifest that loads from them.
+//
+// Frames are copied as raw blocks (4x4 for block compressed formats), so
+// compressed sheets are packed without being re-encoded. Sheets are only packed
+// with sheets of the same format, and each sheet keeps its own manifest entry
+// (frames keep their order, so animation data is still valid as is). Entries
+// sharing an atlas also share the loaded resource and SRV (see
+// Mgr_TextureResources), so sprites using them can batch together.
+//
+// Supports single mip 2D DDS files in BC1-5/BC7 or 32-bit formats. Anything else
+// is passed through to the new manifest unchanged.
+//
+//*********************************************************************************\\
+
+#pragma once
+
+//Library Includes
+#include <string>
+#include <vector>
+
+class AtlasPacker
+{
+public:
+
+	//////////////////////////////
+	/// Enums, Types & Statics ///
+	//////////////////////////////
+
+	struct Settings
+	{
+		//Maximum atlas dimensions (in pixels)
+		int m_MaxAtlasSize = 4096;
+		//Space left between frames (in pixels, rounded up to whole blocks)
+		int m_Padding = 2;
+		//Where atlases and frame data are written (relative to the executable, like manifest paths)
+		std::string m_OutputDirectory = "../../BEngine/Resources/Textures/Atlases/";
+		//Atlas file names are this followed by the atlas number
+		std::string m_AtlasName = "Atlas_";
+	};
+
+	//Summary of the last pack
+	struct Report
+	{
+		//Textures in the source manifest
+		unsigned m_SourceTextureCount = 0;
+		//Textures packed into atlases (the rest were passed through)
+		unsigned m_PackedTextureCount = 0;
+		unsigned m_AtlasCount = 0;
+		//Unique frame regions copied
+		unsigned m_RegionCount = 0;
+		//Used area relative to each atlases size
+		std::vector<float> m_AtlasOccupancy;
+
+		//Distinct textures after packing (atlases plus passed through textures)
+		unsigned GetDistinctTextureCount() const { return m_AtlasCount + (m_SourceTextureCount - m_PackedTextureCount); }
+	};
+
+	////////////////////
+	/// Constructors ///
+	////////////////////
+
+	AtlasPacker() { }
+	~AtlasPacker() { }
+
+	//////////////////
+	/// Operations ///
+	//////////////////
+
+	/*
+		Packs the textures of the manifest at the given index, writing atlases and frame data to the output directory,
+		and a new manifest (holding a single manifest, at index 0) to the output filepath.
+	*/
+	bool PackManifest(const std::string& manifestFP, unsigned manifestIndex, const std::string& outputManifestFP, const Settings& settings);
+
+	/////////////////
+	/// Accessors ///
+	/////////////////
+
+	const Report& GetReport() { return m_Report; }
+
+private:
+
+	////////////
+	/// Data ///
+	////////////
+
+	Report m_Report;
+};
@@ -0,0 +1,367 @@
+#include "DDSImage.h"
+
+//Library Includes
+#include <fstream>
+#include <cstring>
+
+//Utilities
+#include "Utils/Utils_Debug.h"
+
+static constexpr uint32_t DDS_MAGIC = 0x20534444;	//"DDS "
+
+static constexpr uint32_t DDSD_PITCH = 0x8;
+static constexpr uint32_t DDSD_MIPMAPCOUNT = 0x20000;
+static constexpr uint32_t DDSD_LINEARSIZE = 0x80000;
+static constexpr uint32_t DDSD_DEPTH = 0x800000;
+static constexpr uint32_t DDPF_ALPHAPIXELS = 0x1;
+static constexpr uint32_t DDPF_FOURCC = 0x4;
+static constexpr uint32_t DDPF_RGB = 0x40;
+static constexpr uint32_t DDSCAPS_COMPLEX = 0x8;
+static constexpr uint32_t DDSCAPS_MIPMAP = 0x400000;
+static constexpr uint32_t DDSCAPS2_CUBEMAP = 0x200;
+static constexpr uint32_t DDS_DIMENSION_TEXTURE2D = 3;
+
+static_assert(sizeof(DDSImage::Header) == 124, "DDS header size mismatch!");
+static_assert(sizeof(DDSImage::HeaderDX10) == 20, "DDS DX10 header size mismatch!");
+
+static constexpr uint32_t MakeFourCC(char a, char b, char c, char d)
+{
+	return static_cast<uint32_t>(a) | (static_cast<uint32_t>(b) << 8) | (static_cast<uint32_t>(c) << 16) | (static_cast<uint32_t>(d) << 24);
+}
+
+//
+//Alpha Block Decoding (writes a 4x4 block of alpha values, row by row)
+//
+
+//BC1: Alpha is only 0 where colour index 3 is used in 3 colour mode
+static void DecodeAlphaBC1(const unsigned char* block, uint8_t out[16])
+{
+	uint16_t c0 = static_cast<uint16_t>(block[0] | (block[1] << 8));
+	uint16_t c1 = static_cast<uint16_t>(block[2] | (block[3] << 8));
+	uint32_t indices = block[4] | (block[5] << 8) | (block[6] << 16) | (static_cast<uint32_t>(block[7]) << 24);
+
+	for (unsigned i(0); i < 16; ++i)
+		out[i] = (c0 <= c1 && ((indices >> (i * 2)) & 3) == 3) ? 0 : 255;
+}
+
+//BC2: Explicit 4-bit alpha
+static void DecodeAlphaBC2(const unsigned char* block, uint8_t out[16])
+{
+	for (unsigned i(0); i < 16; ++i)
+	{
+		uint8_t a = (block[i / 2] >> ((i & 1) * 4)) & 0xF;
+		out[i] = static_cast<uint8_t>(a * 17);
+	}
+}
+
+//BC3: Two endpoints with 3-bit interpolation indices
+static void DecodeAlphaBC3(const unsigned char* block, uint8_t out[16])
+{
+	uint8_t palette[8];
+	palette[0] = block[0];
+	palette[1] = block[1];
+	if (palette[0] > palette[1])
+	{
+		for (unsigned i(1); i < 7; ++i)
+			palette[i + 1] = static_cast<uint8_t>(((7 - i) * palette[0] + i * palette[1]) / 7);
+	}
+	else
+	{
+		for (unsigned i(1); i < 5; ++i)
+			palette[i + 1] = static_cast<uint8_t>(((5 - i) * palette[0] + i * palette[1]) / 5);
+		palette[6] = 0;
+		palette[7] = 255;
+	}
+
+	uint64_t indices = 0;
+	for (unsigned i(0); i < 6; ++i)
+		indices |= static_cast<uint64_t>(block[2 + i]) << (i * 8);
+
+	for (unsigned i(0); i < 16; ++i)
+		out[i] = palette[(indices >> (i * 3)) & 7];
+}
+
+bool DDSImage::Load(const std::string& fp)
+{
+	m_File.clear();
+	m_HasDX10 = false;
+
+	//Read whole file
+	std::ifstream file(fp, std::ios::binary | std::ios::ate);
+	if (!file.is_open())
+	{
+		DBOUT("Load(): Failed to read texture: " << fp);
+		return false;
+	}
+	std::streamsize size = file.tellg();
+	file.seekg(0, std::ios::beg);
+	m_File.resize(static_cast<size_t>(size));
+	if (size < static_cast<std::streamsize>(sizeof(uint32_t) + sizeof(Header)) || !file.read(reinterpret_cast<char*>(m_File.data()), size))
+	{
+		DBOUT("Load(): Failed to read texture: " << fp);
+		return false;
+	}
+
+	uint32_t magic = 0;
+	std::memcpy(&magic, m_File.data(), sizeof(uint32_t));
+	std::memcpy(&m_Header, m_File.data() + sizeof(uint32_t), sizeof(Header));
+	m_DataOffset = sizeof(uint32_t) + sizeof(Header);
+
+	if (magic != DDS_MAGIC || m_Header.m_Size != sizeof(Header))
+	{
+		DBOUT("Load(): Not a DDS file: " << fp);
+		return false;
+	}
+
+	const PixelFormat& pf = m_Header.m_PixelFormat;
+	if ((pf.m_Flags & DDPF_FOURCC) && pf.m_FourCC == MakeFourCC('D', 'X', '1', '0'))
+	{
+		if (m_File.size() < m_DataOffset + sizeof(HeaderDX10))
+			return false;
+
+		std::memcpy(&m_HeaderDX10, m_File.data() + m_DataOffset, sizeof(HeaderDX10));
+		m_DataOffset += sizeof(HeaderDX10);
+		m_HasDX10 = true;
+
+		if (m_HeaderDX10.m_ResourceDimension != DDS_DIMENSION_TEXTURE2D || m_HeaderDX10.m_ArraySize > 1)
+		{
+			DBOUT("Load(): Only single 2D textures supported: " << fp);
+			return false;
+		}
+	}
+
+	if ((m_Header.m_Caps2 & DDSCAPS2_CUBEMAP) || ((m_Header.m_Flags & DDSD_DEPTH) && m_Header.m_Depth > 1))
+	{
+		DBOUT("Load(): Only single 2D textures supported: " << fp);
+		return false;
+	}
+
+	if (!ResolveBlockFormat())
+	{
+		DBOUT("Load(): Unsupported texture format: " << fp);
+		return false;
+	}
+
+	m_BlocksWide = (GetWidth() + m_BlockDim - 1) / m_BlockDim;
+	m_BlocksHigh = (GetHeight() + m_BlockDim - 1) / m_BlockDim;
+
+	//Only the top mip is used
+	size_t topMipSize = static_cast<size_t>(m_BlocksWide) * m_BlocksHigh * m_BlockBytes;
+	if (m_File.size() < m_DataOffset + topMipSize)
+	{
+		DBOUT("Load(): Texture data truncated: " << fp);
+		return false;
+	}
+
+	return true;
+}
+
+bool DDSImage::DecodeAlpha(std::vector<uint8_t>& out) const
+{
+	const int width = GetWidth();
+	const int height = GetHeight();
+	out.assign(static_cast<size_t>(width) * height, 255);
+
+	//
+	//Uncompressed
+	//
+
+	if (m_BlockDim == 1)
+	{
+		uint32_t aMask = 0;
+		if (m_HasDX10)
+		{
+			switch (m_HeaderDX10.m_DXGIFormat)
+			{
+			//RGB10A2
+			case 24: case 25:
+				aMask = 0xC0000000;
+				break;
+			//RGBA8/BGRA8
+			case 27: case 28: case 29:
+			case 87: case 90: case 91:
+				aMask = 0xFF000000;
+				break;
+			}
+		}
+		else if (m_Header.m_PixelFormat.m_Flags & DDPF_ALPHAPIXELS)
+			aMask = m_Header.m_PixelFormat.m_AMask;
+
+		//No alpha, so fully opaque
+		if (!aMask)
+			return true;
+
+		unsigned shift = 0;
+		while (!((aMask >> shift) & 1))
+			++shift;
+		uint32_t max = aMask >> shift;
+
+		const unsigned char* data = GetData();
+		for (int i(0); i < width * height; ++i)
+		{
+			uint32_t pixel;
+			std::memcpy(&pixel, data + static_cast<size_t>(i) * 4, sizeof(uint32_t));
+			out[i] = static_cast<uint8_t>((((pixel & aMask) >> shift) * 255) / max);
+		}
+		return true;
+	}
+
+	//
+	//Block Compressed
+	//
+
+	//Work out which decoder to use (and where the alpha block sits)
+	void (*decode)(const unsigned char*, uint8_t*) = nullptr;
+	bool opaque = false;
+	if (m_HasDX10)
+	{
+		switch (m_HeaderDX10.m_DXGIFormat)
+		{
+		case 70: case 71: case 72: decode = DecodeAlphaBC1; break;
+		case 73: case 74: case 75: decode = DecodeAlphaBC2; break;
+		case 76: case 77: case 78: decode = DecodeAlphaBC3; break;
+		//BC4/5 and BC6H have no alpha
+		case 79: case 80: case 81:
+		case 82: case 83: case 84:
+		case 94: case 95: case 96: opaque = true; break;
+		}
+	}
+	else
+	{
+		switch (m_Header.m_PixelFormat.m_FourCC)
+		{
+		case MakeFourCC('D', 'X', 'T', '1'): decode = DecodeAlphaBC1; break;
+		case MakeFourCC('D', 'X', 'T', '2'):
+		case MakeFourCC('D', 'X', 'T', '3'): decode = DecodeAlphaBC2; break;
+		case MakeFourCC('D', 'X', 'T', '4'):
+		case MakeFourCC('D', 'X', 'T', '5'): decode = DecodeAlphaBC3; break;
+		default: opaque = true; break;
+		}
+	}
+
+	if (opaque)
+		return true;
+	if (!decode)
+		return false;
+
+	const unsigned char* data = GetData();
+	uint8_t block[16];
+	for (int by(0); by < m_BlocksHigh; ++by)
+	{
+		for (int bx(0); bx < m_BlocksWide; ++bx)
+		{
+			decode(data + (static_cast<size_t>(by) * m_BlocksWide + bx) * m_BlockBytes, block);
+
+			//Copy out, clipping blocks that overhang the texture
+			for (int py(0); py < 4 && by * 4 + py < height; ++py)
+				for (int px(0); px < 4 && bx * 4 + px < width; ++px)
+					out[static_cast<size_t>(by * 4 + py) * width + (bx * 4 + px)] = block[py * 4 + px];
+		}
+	}
+
+	return true;
+}
+
+bool DDSImage::Write(const std::string& fp, const DDSImage& format, int width, int height, const std::vector<unsigned char>& data)
+{
+	//Header from the source format, adjusted for the new size (single mip)
+	Header header = format.m_Header;
+	header.m_Width = static_cast<uint32_t>(width);
+	header.m_Height = static_cast<uint32_t>(height);
+	header.m_MipMapCount = 1;
+	header.m_Flags &= ~(DDSD_MIPMAPCOUNT | DDSD_PITCH | DDSD_LINEARSIZE);
+	header.m_Caps &= ~(DDSCAPS_MIPMAP | DDSCAPS_COMPLEX);
+	if (format.m_BlockDim > 1)
+	{
+		header.m_Flags |= DDSD_LINEARSIZE;
+		header.m_PitchOrLinearSize = static_cast<uint32_t>(data.size());
+	}
+	else
+	{
+		header.m_Flags |= DDSD_PITCH;
+		header.m_PitchOrLinearSize = static_cast<uint32_t>(width * format.m_BlockBytes);
+	}
+
+	std::ofstream file(fp, std::ios::binary);
+	if (!file.is_open())
+		return false;
+
+	file.write(reinterpret_cast<const char*>(&DDS_MAGIC), sizeof(DDS_MAGIC));
+	file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+	if (format.m_HasDX10)
+		file.write(reinterpret_cast<const char*>(&format.m_HeaderDX10), sizeof(HeaderDX10));
+	file.write(reinterpret_cast<const char*>(data.data()), data.size());
+
+	return static_cast<bool>(file);
+}
+
+bool DDSImage::IsSameFormat(const DDSImage& other) const
+{
+	if (m_HasDX10 != other.m_HasDX10)
+		return false;
+	if (m_HasDX10)
+		return m_HeaderDX10.m_DXGIFormat == other.m_HeaderDX10.m_DXGIFormat;
+
+	return std::memcmp(&m_Header.m_PixelFormat, &other.m_Header.m_PixelFormat, sizeof(PixelFormat)) == 0;
+}
+
+bool DDSImage::ResolveBlockFormat()
+{
+	const PixelFormat& pf = m_Header.m_PixelFormat;
+
+	if (m_HasDX10)
+	{
+		switch (m_HeaderDX10.m_DXGIFormat)
+		{
+		//BC1, BC4
+		case 70: case 71: case 72:
+		case 79: case 80: case 81:
+			m_BlockDim = 4; m_BlockBytes = 8;
+			return true;
+		//BC2, BC3, BC5, BC6H, BC7
+		case 73: case 74: case 75:
+		case 76: case 77: case 78:
+		case 82: case 83: case 84:
+		case 94: case 95: case 96:
+		case 97: case 98: case 99:
+			m_BlockDim = 4; m_BlockBytes = 16;
+			return true;
+		//32-bit RGBA/BGRA/RGB10A2
+		case 24: case 25:
+		case 27: case 28: case 29:
+		case 87: case 88: case 90: case 91:
+			m_BlockDim = 1; m_BlockBytes = 4;
+			return true;
+		}
+		return false;
+	}
+
+	if (pf.m_Flags & DDPF_FOURCC)
+	{
+		switch (pf.m_FourCC)
+		{
+		case MakeFourCC('D', 'X', 'T', '1'):
+		case MakeFourCC('A', 'T', 'I', '1'):
+		case MakeFourCC('B', 'C', '4', 'U'):
+			m_BlockDim = 4; m_BlockBytes = 8;
+			return true;
+		case MakeFourCC('D', 'X', 'T', '2'):
+		case MakeFourCC('D', 'X', 'T', '3'):
+		case MakeFourCC('D', 'X', 'T', '4'):
+		case MakeFourCC('D', 'X', 'T', '5'):
+		case MakeFourCC('A', 'T', 'I', '2'):
+		case MakeFourCC('B', 'C', '5', 'U'):
+			m_BlockDim = 4; m_BlockBytes = 16;
+			return true;
+		}
+		return false;
+	}
+
+	if ((pf.m_Flags & DDPF_RGB) && pf.m_RGBBitCount == 32)
+	{
+		m_BlockDim = 1; m_BlockBytes = 4;
+		return true;
+	}
+
+	return false;
+}
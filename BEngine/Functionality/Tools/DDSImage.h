@@ -0,0 +1,133 @@
+//*********************************************************************************\\
+//
+// Minimal CPU side DDS file reader/writer for offline tools (see AtlasPacker and
+// SpriteHullBuilder). Reads the top mip of single 2D textures as raw blocks (4x4
+// for block compressed formats), and can decode the alpha channel of the common
+// sprite formats. Not used for runtime loading (see DDSTextureLoader).
+//
+//*********************************************************************************\\
+
+#pragma once
+
+//Library Includes
+#include <string>
+#include <vector>
+#include <cstdint>
+
+class DDSImage
+{
+public:
+
+	//////////////////////////////
+	/// Enums, Types & Statics ///
+	//////////////////////////////
+
+	struct PixelFormat
+	{
+		uint32_t m_Size;
+		uint32_t m_Flags;
+		uint32_t m_FourCC;
+		uint32_t m_RGBBitCount;
+		uint32_t m_RMask;
+		uint32_t m_GMask;
+		uint32_t m_BMask;
+		uint32_t m_AMask;
+	};
+
+	struct Header
+	{
+		uint32_t m_Size;
+		uint32_t m_Flags;
+		uint32_t m_Height;
+		uint32_t m_Width;
+		uint32_t m_PitchOrLinearSize;
+		uint32_t m_Depth;
+		uint32_t m_MipMapCount;
+		uint32_t m_Reserved1[11];
+		PixelFormat m_PixelFormat;
+		uint32_t m_Caps;
+		uint32_t m_Caps2;
+		uint32_t m_Caps3;
+		uint32_t m_Caps4;
+		uint32_t m_Reserved2;
+	};
+
+	struct HeaderDX10
+	{
+		uint32_t m_DXGIFormat;
+		uint32_t m_ResourceDimension;
+		uint32_t m_MiscFlag;
+		uint32_t m_ArraySize;
+		uint32_t m_MiscFlags2;
+	};
+
+	////////////////////
+	/// Constructors ///
+	////////////////////
+
+	DDSImage() { }
+	~DDSImage() { }
+
+	//////////////////
+	/// Operations ///
+	//////////////////
+
+	//Loads file, returning false if it isn't a DDS, or isn't a single 2D texture in a supported format
+	bool Load(const std::string& fp);
+
+	/*
+		Decodes the alpha of the top mip into one byte per pixel (width * height). Formats without alpha decode as
+		fully opaque. Returns false if alpha can't be decoded for the format (e.g. BC7).
+	*/
+	bool DecodeAlpha(std::vector<uint8_t>& out) const;
+
+	/*
+		Writes a single mip texture in the same format as the given image, using the given data (in blocks, tightly
+		packed rows) and size (in pixels).
+	*/
+	static bool Write(const std::string& fp, const DDSImage& format, int width, int height, const std::vector<unsigned char>& data);
+
+	/////////////////
+	/// Accessors ///
+	/////////////////
+
+	//True if both images have their data in the same format
+	bool IsSameFormat(const DDSImage& other) const;
+
+	int GetWidth() const				{ return static_cast<int>(m_Header.m_Width); }
+	int GetHeight() const				{ return static_cast<int>(m_Header.m_Height); }
+	//Block dims in pixels (1 for uncompressed formats) and size in bytes
+	int GetBlockDim() const				{ return m_BlockDim; }
+	int GetBlockBytes() const			{ return m_BlockBytes; }
+	//Top mip size in blocks
+	int GetBlocksWide() const			{ return m_BlocksWide; }
+	int GetBlocksHigh() const			{ return m_BlocksHigh; }
+	//Top mip data (rows of blocks, tightly packed)
+	const unsigned char* GetData() const	{ return m_File.data() + m_DataOffset; }
+
+private:
+
+	//////////////////
+	/// Operations ///
+	//////////////////
+
+	//Sets block dims and bytes for the format, returning false if unsupported
+	bool ResolveBlockFormat();
+
+	////////////
+	/// Data ///
+	////////////
+
+	//Whole file, with the offset to the top mip
+	std::vector<unsigned char> m_File;
+	size_t m_DataOffset = 0;
+
+	Header m_Header = {};
+	HeaderDX10 m_HeaderDX10 = {};
+	bool m_HasDX10 = false;
+
+	int m_BlockDim = 1;
+	int m_BlockBytes = 4;
+	int m_BlocksWide = 0;
+	int m_BlocksHigh = 0;
+};
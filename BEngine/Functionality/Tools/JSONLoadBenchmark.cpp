@@ -0,0 +1,102 @@
+#include "JSONLoadBenchmark.h"
+
+//Library Includes
+#include <chrono>
+#include <fstream>
+#include <sstream>
+
+//Utilities
+#include "Utils/Utils_Debug.h"
+#include "Utils/Utils_RapidJSON.h"
+
+//The loading path ParseNewJSONDocument replaced, kept for comparison
+static bool LegacyParseJSONDocument(rapidjson::Document& doc, const std::string& filePath)
+{
+	std::stringstream jsonDocBuffer;
+	std::string inputLine;
+	std::ifstream inputStream(filePath);
+	if (!inputStream.is_open())
+		return false;
+
+	while (std::getline(inputStream, inputLine))
+		jsonDocBuffer << inputLine << "\n";
+
+	inputStream.close();
+	doc.Parse(jsonDocBuffer.str().c_str());
+	return !doc.HasParseError() && doc.IsObject();
+}
+
+void JSONLoadBenchmark::Run(const std::vector<std::string>& files, unsigned iterations)
+{
+	typedef std::chrono::high_resolution_clock Clock;
+
+	m_Results.clear();
+	m_Results.reserve(files.size());
+	iterations = iterations ? iterations : 1;
+
+	double legacyTotal = 0.0;
+	double insituTotal = 0.0;
+	for (auto& fp : files)
+	{
+		//Check the file loads at all before timing it
+		rapidjson::Document check;
+		std::string error;
+		if (!ParseNewJSONDocument(check, fp, &error))
+		{
+			DBOUT("Run(): Skipping file: " << error);
+			continue;
+		}
+
+		Result result;
+		result.m_Filepath = fp;
+		std::ifstream sizeStream(fp, std::ios::binary | std::ios::ate);
+		result.m_FileSize = static_cast<size_t>(sizeStream.tellg());
+
+		auto start = Clock::now();
+		for (unsigned i(0); i < iterations; ++i)
+		{
+			rapidjson::Document doc;
+			LegacyParseJSONDocument(doc, fp);
+		}
+		result.m_LegacyMS = std::chrono::duration<double, std::milli>(Clock::now() - start).count() / iterations;
+
+		start = Clock::now();
+		for (unsigned i(0); i < iterations; ++i)
+		{
+			rapidjson::Document doc;
+			ParseNewJSONDocument(doc, fp);
+		}
+		result.m_InsituMS = std::chrono::duration<double, std::milli>(Clock::now() - start).count() / iterations;
+
+		DBOUT("Run(): " << fp << " (" << result.m_FileSize << " bytes): Legacy: " << result.m_LegacyMS << "ms, In-situ: "
+			<< result.m_InsituMS << "ms (x" << (result.m_InsituMS > 0.0 ? result.m_LegacyMS / result.m_InsituMS : 0.0) << ")");
+
+		legacyTotal += result.m_LegacyMS;
+		insituTotal += result.m_InsituMS;
+		m_Results.push_back(result);
+	}
+
+	DBOUT("Run(): " << m_Results.size() << " files, " << iterations << " iterations. Total per pass: Legacy: " << legacyTotal
+		<< "ms, In-situ: " << insituTotal << "ms");
+}
+
+void JSONLoadBenchmark::GatherTextureFiles(const std::string& manifestFP, unsigned manifestIndex, std::vector<std::string>& outFiles)
+{
+	rapidjson::Document manifestDoc;
+	std::string error;
+	if (!ParseNewJSONDocument(manifestDoc, manifestFP, &error))
+	{
+		DBOUT("GatherTextureFiles(): " << error);
+		return;
+	}
+	if (!manifestDoc.HasMember("Manifests") || manifestIndex >= manifestDoc["Manifests"].Size())
+		return;
+
+	const rapidjson::Value& textures = manifestDoc["Manifests"][manifestIndex]["Textures"];
+	for (unsigned i(0); i < textures.Size(); ++i)
+	{
+		outFiles.push_back(textures[i]["Frames_Filepath"].GetString());
+		if (textures[i].HasMember("Animations_Filepath"))
+			outFiles.push_back(textures[i]["Animations_Filepath"].GetString());
+	}
+}
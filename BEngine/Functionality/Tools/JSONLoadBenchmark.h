@@ -0,0 +1,66 @@
+//*********************************************************************************\\
+//
+// Benchmark comparing the old JSON loading path (line by line reads through a
+// stringstream, copied to a string and parsed with a copying DOM) against
+// ParseNewJSONDocument (single read into the documents pool, parsed in place).
+// Each file is loaded a number of times with each method, with timings output
+// via DBOUT.
+//
+//*********************************************************************************\\
+
+#pragma once
+
+//Library Includes
+#include <string>
+#include <vector>
+
+class JSONLoadBenchmark
+{
+public:
+
+	//////////////////////////////
+	/// Enums, Types & Statics ///
+	//////////////////////////////
+
+	//Results for a single file
+	struct Result
+	{
+		std::string m_Filepath;
+		size_t m_FileSize = 0;
+		//Average time per load (milliseconds)
+		double m_LegacyMS = 0.0;
+		double m_InsituMS = 0.0;
+	};
+
+	////////////////////
+	/// Constructors ///
+	////////////////////
+
+	JSONLoadBenchmark() { }
+	~JSONLoadBenchmark() { }
+
+	//////////////////
+	/// Operations ///
+	//////////////////
+
+	//Loads each file the given number of times with each method (files that fail to load are skipped)
+	void Run(const std::vector<std::string>& files, unsigned iterations);
+
+	//Appends the frame and animation filepaths of every texture in the manifest at the given index
+	static void GatherTextureFiles(const std::string& manifestFP, unsigned manifestIndex, std::vector<std::string>& outFiles);
+
+	/////////////////
+	/// Accessors ///
+	/////////////////
+
+	//Results from the last run
+	const std::vector<Result>& GetResults() { return m_Results; }
+
+private:
+
+	////////////
+	/// Data ///
+	////////////
+
+	std::vector<Result> m_Results;
+};
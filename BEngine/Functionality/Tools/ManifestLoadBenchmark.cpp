@@ -0,0 +1,62 @@
+#include "ManifestLoadBenchmark.h"
+
+//Library Includes
+#include <memory>
+
+//Utilities
+#include "Utils/Utils_Debug.h"
+
+//Engine Includes
+#include "IO/TextureLoadPipeline.h"
+#include "Types/BE_SharedTypes.h"
+
+//Loads entries headless, returning the total time taken across both stages
+static double TimeLoad(const std::vector<TextureLoadPipeline::Entry>& entries, unsigned workerCount, unsigned& outWorkerCount)
+{
+	TextureLoadPipeline pipeline;
+	TextureLoadPipeline::StubTextureCreator creator;
+	std::vector<std::unique_ptr<SpriteTexture>> textures;
+
+	if (!pipeline.LoadFiles(entries, workerCount) || !pipeline.CreateTextures(creator, textures))
+		DBOUT("TimeLoad(): Some entries failed to load");
+
+	outWorkerCount = pipeline.GetReport().m_WorkerCount;
+	return pipeline.GetReport().m_FileStageMS + pipeline.GetReport().m_CreateStageMS;
+}
+
+void ManifestLoadBenchmark::Run(const std::string& manifestFP, unsigned manifestIndex, unsigned maxRepeat, unsigned workerCount)
+{
+	m_Results.clear();
+
+	std::vector<TextureLoadPipeline::Entry> baseEntries;
+	if (!TextureLoadPipeline::ReadManifest(manifestFP, manifestIndex, baseEntries) || baseEntries.empty())
+		return;
+
+	//Warm up (so the first timing isn't paying for cold file reads)
+	unsigned unused = 0;
+	TimeLoad(baseEntries, 1, unused);
+
+	for (unsigned repeat(1); repeat <= maxRepeat; repeat *= 2)
+	{
+		//Repeated entries get their own names, but share files (so texture files are still only read once)
+		std::vector<TextureLoadPipeline::Entry> entries;
+		entries.reserve(baseEntries.size() * repeat);
+		for (unsigned r(0); r < repeat; ++r)
+		{
+			for (auto entry : baseEntries)
+			{
+				entry.m_Name += "_" + std::to_string(r);
+				entries.push_back(entry);
+			}
+		}
+
+		Result result;
+		result.m_EntryCount = entries.size();
+		result.m_SerialMS = TimeLoad(entries, 1, unused);
+		result.m_ParallelMS = TimeLoad(entries, workerCount, result.m_WorkerCount);
+		m_Results.push_back(result);
+
+		DBOUT("Run(): " << result.m_EntryCount << " entries: Serial: " << result.m_SerialMS << "ms, " << result.m_WorkerCount
+			<< " workers: " << result.m_ParallelMS << "ms (x" << (result.m_ParallelMS > 0.0 ? result.m_SerialMS / result.m_ParallelMS : 0.0) << ")");
+	}
+}
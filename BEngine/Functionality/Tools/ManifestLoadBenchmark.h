@@ -0,0 +1,65 @@
+//*********************************************************************************\\
+//
+// Benchmark for staged manifest loading (see TextureLoadPipeline). Repeats the
+// entries of a texture manifest to grow the entry count, and times loading each
+// count headless (with StubTextureCreator) on a single thread and across worker
+// threads, outputting startup time against entry count via DBOUT.
+//
+//*********************************************************************************\\
+
+#pragma once
+
+//Library Includes
+#include <string>
+#include <vector>
+
+class ManifestLoadBenchmark
+{
+public:
+
+	//////////////////////////////
+	/// Enums, Types & Statics ///
+	//////////////////////////////
+
+	//Results for a single entry count
+	struct Result
+	{
+		size_t m_EntryCount = 0;
+		unsigned m_WorkerCount = 0;
+		//Total load time (milliseconds)
+		double m_SerialMS = 0.0;
+		double m_ParallelMS = 0.0;
+	};
+
+	////////////////////
+	/// Constructors ///
+	////////////////////
+
+	ManifestLoadBenchmark() { }
+	~ManifestLoadBenchmark() { }
+
+	//////////////////
+	/// Operations ///
+	//////////////////
+
+	/*
+		Loads the manifest at the given index with its entries repeated 1, 2, 4... up to the max repeat times, serially
+		and with the given number of workers (0 uses the hardware thread count).
+	*/
+	void Run(const std::string& manifestFP, unsigned manifestIndex, unsigned maxRepeat, unsigned workerCount = 0);
+
+	/////////////////
+	/// Accessors ///
+	/////////////////
+
+	//Results from the last run
+	const std::vector<Result>& GetResults() { return m_Results; }
+
+private:
+
+	////////////
+	/// Data ///
+	////////////
+
+	std::vector<Result> m_Results;
+};
@@ -0,0 +1,175 @@
+#include "MaxRectsBin.h"
+
+#include <climits>
+#include <algorithm>
+
+//Returns true if a is fully inside b
+static inline bool IsContainedIn(const MaxRectsBin::Rect& a, const MaxRectsBin::Rect& b)
+{
+	return a.m_X >= b.m_X && a.m_Y >= b.m_Y && a.m_X + a.m_W <= b.m_X + b.m_W && a.m_Y + a.m_H <= b.m_Y + b.m_H;
+}
+
+void MaxRectsBin::Init(int width, int height)
+{
+	m_Width = width;
+	m_Height = height;
+	m_UsedWidth = 0;
+	m_UsedHeight = 0;
+	m_UsedArea = 0;
+
+	//Whole bin is free to start with
+	m_FreeRects.clear();
+	m_NewFreeRects.clear();
+	Rect bin;
+	bin.m_W = width;
+	bin.m_H = height;
+	m_FreeRects.push_back(bin);
+}
+
+bool MaxRectsBin::Insert(int width, int height, Rect& outRect)
+{
+	if (width <= 0 || height <= 0)
+		return false;
+
+	//Find free rect leaving the smallest short side (tie broken by long side)
+	int bestShort = INT_MAX;
+	int bestLong = INT_MAX;
+	int bestIndex = -1;
+	for (unsigned i(0); i < m_FreeRects.size(); ++i)
+	{
+		const Rect& fr = m_FreeRects[i];
+		if (width > fr.m_W || height > fr.m_H)
+			continue;
+
+		int leftoverX = fr.m_W - width;
+		int leftoverY = fr.m_H - height;
+		int shortSide = std::min(leftoverX, leftoverY);
+		int longSide = std::max(leftoverX, leftoverY);
+
+		if (shortSide < bestShort || (shortSide == bestShort && longSide < bestLong))
+		{
+			bestShort = shortSide;
+			bestLong = longSide;
+			bestIndex = static_cast<int>(i);
+		}
+	}
+
+	if (bestIndex < 0)
+		return false;
+
+	Rect placed;
+	placed.m_X = m_FreeRects[bestIndex].m_X;
+	placed.m_Y = m_FreeRects[bestIndex].m_Y;
+	placed.m_W = width;
+	placed.m_H = height;
+
+	//Split every free rect the placed rect overlaps (swap removing them as we go)
+	for (size_t i = 0; i < m_FreeRects.size();)
+	{
+		if (SplitFreeRect(m_FreeRects[i], placed))
+		{
+			m_FreeRects[i] = m_FreeRects.back();
+			m_FreeRects.pop_back();
+		}
+		else
+			++i;
+	}
+
+	PruneFreeRects();
+
+	m_UsedWidth = std::max(m_UsedWidth, placed.m_X + placed.m_W);
+	m_UsedHeight = std::max(m_UsedHeight, placed.m_Y + placed.m_H);
+	m_UsedArea += static_cast<long long>(width) * height;
+
+	outRect = placed;
+	return true;
+}
+
+float MaxRectsBin::GetOccupancy()
+{
+	long long bounds = static_cast<long long>(m_UsedWidth) * m_UsedHeight;
+	return bounds > 0 ? static_cast<float>(m_UsedArea) / static_cast<float>(bounds) : 0.f;
+}
+
+bool MaxRectsBin::SplitFreeRect(const Rect& freeRect, const Rect& placed)
+{
+	//No overlap, so nothing to split
+	if (placed.m_X >= freeRect.m_X + freeRect.m_W || placed.m_X + placed.m_W <= freeRect.m_X ||
+		placed.m_Y >= freeRect.m_Y + freeRect.m_H || placed.m_Y + placed.m_H <= freeRect.m_Y)
+		return false;
+
+	//Keep the (maximal) space left on each side of the placed rect
+	if (placed.m_X > freeRect.m_X)
+	{
+		Rect left = freeRect;
+		left.m_W = placed.m_X - freeRect.m_X;
+		m_NewFreeRects.push_back(left);
+	}
+	if (placed.m_X + placed.m_W < freeRect.m_X + freeRect.m_W)
+	{
+		Rect right = freeRect;
+		right.m_X = placed.m_X + placed.m_W;
+		right.m_W = (freeRect.m_X + freeRect.m_W) - right.m_X;
+		m_NewFreeRects.push_back(right);
+	}
+	if (placed.m_Y > freeRect.m_Y)
+	{
+		Rect top = freeRect;
+		top.m_H = placed.m_Y - freeRect.m_Y;
+		m_NewFreeRects.push_back(top);
+	}
+	if (placed.m_Y + placed.m_H < freeRect.m_Y + freeRect.m_H)
+	{
+		Rect bottom = freeRect;
+		bottom.m_Y = placed.m_Y + placed.m_H;
+		bottom.m_H = (freeRect.m_Y + freeRect.m_H) - bottom.m_Y;
+		m_NewFreeRects.push_back(bottom);
+	}
+
+	return true;
+}
+
+void MaxRectsBin::PruneFreeRects()
+{
+	/*
+		Only the newly split rects can be contained by (or be duplicates of) others, as existing free rects were already
+		maximal. So check new rects against each other, then against the existing rects.
+	*/
+	for (size_t i = 0; i < m_NewFreeRects.size(); ++i)
+	{
+		bool contained = false;
+		for (size_t j = 0; j < m_NewFreeRects.size() && !contained; ++j)
+		{
+			if (i == j)
+				continue;
+
+			//Keep one of any identical pair
+			const Rect& a = m_NewFreeRects[i];
+			const Rect& b = m_NewFreeRects[j];
+			bool identical = a.m_X == b.m_X && a.m_Y == b.m_Y && a.m_W == b.m_W && a.m_H == b.m_H;
+			contained = identical ? j < i : IsContainedIn(a, b);
+		}
+		for (size_t j = 0; j < m_FreeRects.size() && !contained; ++j)
+			contained = IsContainedIn(m_NewFreeRects[i], m_FreeRects[j]);
+
+		if (!contained)
+			m_FreeRects.push_back(m_NewFreeRects[i]);
+	}
+	m_NewFreeRects.clear();
+
+	//Existing rects may now be inside new ones
+	for (size_t i = 0; i < m_FreeRects.size();)
+	{
+		bool contained = false;
+		for (size_t j = 0; j < m_FreeRects.size() && !contained; ++j)
+			contained = i != j && IsContainedIn(m_FreeRects[i], m_FreeRects[j]);
+
+		if (contained)
+		{
+			m_FreeRects[i] = m_FreeRects.back();
+			m_FreeRects.pop_back();
+		}
+		else
+			++i;
+	}
+}
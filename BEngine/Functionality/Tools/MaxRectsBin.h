@@ -0,0 +1,88 @@
+//*********************************************************************************\\
+//
+// MaxRects rectangle bin packer (Best Short Side Fit). Tracks the maximal free
+// rectangles left in the bin, placing each new rectangle in the free space that
+// leaves the smallest leftover on its shortest side.
+//
+// Used by AtlasPacker, but has no dependencies so is usable for any 2D packing.
+//
+//*********************************************************************************\\
+
+#pragma once
+
+//Library Includes
+#include <vector>
+
+class MaxRectsBin
+{
+public:
+
+	//////////////////////////////
+	/// Enums, Types & Statics ///
+	//////////////////////////////
+
+	struct Rect
+	{
+		int m_X = 0;
+		int m_Y = 0;
+		int m_W = 0;
+		int m_H = 0;
+	};
+
+	////////////////////
+	/// Constructors ///
+	////////////////////
+
+	MaxRectsBin() { }
+	MaxRectsBin(int width, int height) { Init(width, height); }
+	~MaxRectsBin() { }
+
+	//////////////////
+	/// Operations ///
+	//////////////////
+
+	//Resets bin to an empty bin of the given size
+	void Init(int width, int height);
+
+	//Attempts to place a rectangle, returning false if there is no room
+	bool Insert(int width, int height, Rect& outRect);
+
+	/////////////////
+	/// Accessors ///
+	/////////////////
+
+	int GetWidth()						{ return m_Width; }
+	int GetHeight()						{ return m_Height; }
+	//Area used by placed rectangles
+	long long GetUsedArea()				{ return m_UsedArea; }
+	//Bounds of all placed rectangles (from the origin)
+	int GetUsedWidth()					{ return m_UsedWidth; }
+	int GetUsedHeight()					{ return m_UsedHeight; }
+	//Used area, relative to the used bounds
+	float GetOccupancy();
+
+private:
+
+	//////////////////
+	/// Operations ///
+	//////////////////
+
+	//Splits free rect around placed rect, returning true if they overlapped (and the free rect should be removed)
+	bool SplitFreeRect(const Rect& freeRect, const Rect& placed);
+	//Removes free rects fully contained by others
+	void PruneFreeRects();
+
+	////////////
+	/// Data ///
+	////////////
+
+	std::vector<Rect> m_FreeRects;
+	//Rects created when splitting (merged into free rects after each insert)
+	std::vector<Rect> m_NewFreeRects;
+
+	int m_Width = 0;
+	int m_Height = 0;
+	int m_UsedWidth = 0;
+	int m_UsedHeight = 0;
+	long long m_UsedArea = 0;
+};
@@ -0,0 +1,97 @@
+#include "SpriteAnimationBenchmark.h"
+
+//Library Includes
+#include <chrono>
+
+//Utilities
+#include "Utils/Utils_Debug.h"
+
+//Engine Includes
+#include "Types/BE_SharedTypes.h"
+#include "Animation/SpriteAnimationSystem.h"
+
+typedef std::chrono::high_resolution_clock Clock;
+
+//Fixed update step (60hz)
+static constexpr float UPDATE_STEP = 1.f / 60.f;
+
+//Times per-actor animators, returning the average time per update
+static double TimePerActor(SpriteTexture* texture, size_t count, unsigned updateCount)
+{
+	//Constructed in place, so each animator stays bound to its own sprite
+	std::vector<AnimatedSprite> sprites(count);
+	const int animCount = static_cast<int>(texture->m_Animations.size());
+	for (size_t i(0); i < count; ++i)
+	{
+		sprites[i].m_SprData.SetTexture(texture);
+		sprites[i].m_Animator.SetAnimation(static_cast<int>(i % animCount), true, false, true, false);
+	}
+
+	auto start = Clock::now();
+	for (unsigned u(0); u < updateCount; ++u)
+		for (auto& a : sprites)
+			a.m_Animator.Update(UPDATE_STEP);
+	return std::chrono::duration<double, std::milli>(Clock::now() - start).count() / updateCount;
+}
+
+//Times the animation system over the same setup, returning the average time per update
+static double TimeBatched(SpriteTexture* texture, size_t count, unsigned updateCount)
+{
+	std::vector<SpriteData> sprites(count);
+	SpriteAnimationSystem system(count);
+	const int animCount = static_cast<int>(texture->m_Animations.size());
+	for (size_t i(0); i < count; ++i)
+	{
+		sprites[i].SetTexture(texture);
+		SpriteAnimationSystem::AnimatorID id = system.AddAnimator(&sprites[i]);
+		system.SetAnimation(id, static_cast<int>(i % animCount), true, false, true, false);
+	}
+
+	auto start = Clock::now();
+	for (unsigned u(0); u < updateCount; ++u)
+		system.Update(UPDATE_STEP);
+	return std::chrono::duration<double, std::milli>(Clock::now() - start).count() / updateCount;
+}
+
+void SpriteAnimationBenchmark::Run(SpriteTexture* texture, size_t maxCount, unsigned updateCount)
+{
+	m_Results.clear();
+
+	if (!texture || texture->m_Animations.empty())
+	{
+		msg_assert(false, "Run(): No texture given, or texture has no animations!");
+		return;
+	}
+	updateCount = updateCount ? updateCount : 1;
+
+	//Warm up (so the first timing isn't paying for cold caches)
+	TimePerActor(texture, 1000, 1);
+	TimeBatched(texture, 1000, 1);
+
+	for (size_t count(1000); ; count *= 2)
+	{
+		if (count > maxCount)
+			count = maxCount;
+
+		Result result;
+		result.m_SpriteCount = count;
+		result.m_PerActorMS = TimePerActor(texture, count, updateCount);
+		result.m_BatchedMS = TimeBatched(texture, count, updateCount);
+		result.m_PerActorRate = result.m_PerActorMS > 0.0 ? count / result.m_PerActorMS : 0.0;
+		result.m_BatchedRate = result.m_BatchedMS > 0.0 ? count / result.m_BatchedMS : 0.0;
+		m_Results.push_back(result);
+
+		DBOUT("Run(): " << count << " sprites: Per-actor: " << result.m_PerActorRate << " sprites/ms (" << result.m_PerActorMS
+			<< "ms), Batched: " << result.m_BatchedRate << " sprites/ms (" << result.m_BatchedMS << "ms) (x"
+			<< (result.m_BatchedMS > 0.0 ? result.m_PerActorMS / result.m_BatchedMS : 0.0) << ")");
+
+		if (count == maxCount)
+			break;
+	}
+
+	//Report the max count against a full frame
+	const Result& last = m_Results.back();
+	DBOUT("Run(): " << last.m_SpriteCount << " sprites per frame: Per-actor: " << (last.m_PerActorMS / FRAME_BUDGET_MS) * 100.0
+		<< "% of frame, Batched: " << (last.m_BatchedMS / FRAME_BUDGET_MS) * 100.0 << "% of frame ("
+		<< (last.m_BatchedMS <= FRAME_BUDGET_MS ? "within" : "over") << " budget)");
+}
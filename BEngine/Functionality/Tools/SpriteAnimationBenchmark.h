@@ -0,0 +1,73 @@
+//*********************************************************************************\\
+//
+// Benchmark comparing per-actor SpriteAnimators against the batched
+// SpriteAnimationSystem. Animates a growing number of sprites (cycling through
+// the animations of a texture) up to a max count, timing a number of updates
+// with each path and outputting sprites animated per millisecond via DBOUT,
+// along with how much of a 60hz frame animating the max count takes.
+//
+//*********************************************************************************\\
+
+#pragma once
+
+//Library Includes
+#include <vector>
+
+//Forward Declarations
+struct SpriteTexture;
+
+class SpriteAnimationBenchmark
+{
+public:
+
+	//////////////////////////////
+	/// Enums, Types & Statics ///
+	//////////////////////////////
+
+	//Results for a single sprite count
+	struct Result
+	{
+		size_t m_SpriteCount = 0;
+		//Average time per update (milliseconds)
+		double m_PerActorMS = 0.0;
+		double m_BatchedMS = 0.0;
+		//Sprites animated per millisecond
+		double m_PerActorRate = 0.0;
+		double m_BatchedRate = 0.0;
+	};
+
+	//Frame time the max count is measured against (60hz)
+	static constexpr double FRAME_BUDGET_MS = 1000.0 / 60.0;
+
+	////////////////////
+	/// Constructors ///
+	////////////////////
+
+	SpriteAnimationBenchmark() { }
+	~SpriteAnimationBenchmark() { }
+
+	//////////////////
+	/// Operations ///
+	//////////////////
+
+	/*
+		Animates 1000, 2000, 4000... sprites up to the max count (always finishing on the max count) with the given
+		texture, timing the given number of 60hz updates with each path.
+	*/
+	void Run(SpriteTexture* texture, size_t maxCount = 100000, unsigned updateCount = 60);
+
+	/////////////////
+	/// Accessors ///
+	/////////////////
+
+	//Results from the last run
+	const std::vector<Result>& GetResults() { return m_Results; }
+
+private:
+
+	////////////
+	/// Data ///
+	////////////
+
+	std::vector<Result> m_Results;
+};
@@ -0,0 +1,296 @@
+#include "SpriteHullBuilder.h"
+
+//Library Includes
+#include <cmath>
+#include <algorithm>
+#include <filesystem>
+
+//Utilities
+#include "Utils/Utils_Debug.h"
+#include "Utils/Utils_RapidJSON.h"
+
+//Engine Includes
+#include "Tools/DDSImage.h"
+
+typedef SpriteHullBuilder::Point Point;
+
+static inline float Cross(const Point& a, const Point& b)
+{
+	return a.m_X * b.m_Y - a.m_Y * b.m_X;
+}
+
+static inline Point Sub(const Point& a, const Point& b)
+{
+	return { a.m_X - b.m_X, a.m_Y - b.m_Y };
+}
+
+//Monotone chain convex hull (removes collinear points)
+static void BuildConvexHull(std::vector<Point>& points, std::vector<Point>& outHull)
+{
+	std::sort(points.begin(), points.end(), [](const Point& a, const Point& b)
+	{
+		return a.m_X < b.m_X || (a.m_X == b.m_X && a.m_Y < b.m_Y);
+	});
+
+	outHull.clear();
+	outHull.resize(points.size() * 2);
+	size_t k = 0;
+
+	//Lower chain
+	for (size_t i = 0; i < points.size(); ++i)
+	{
+		while (k >= 2 && Cross(Sub(outHull[k - 1], outHull[k - 2]), Sub(points[i], outHull[k - 2])) <= 0.f)
+			--k;
+		outHull[k++] = points[i];
+	}
+	//Upper chain
+	for (size_t i = points.size() - 1, lower = k + 1; i > 0; --i)
+	{
+		while (k >= lower && Cross(Sub(outHull[k - 1], outHull[k - 2]), Sub(points[i - 1], outHull[k - 2])) <= 0.f)
+			--k;
+		outHull[k++] = points[i - 1];
+	}
+
+	//Last point is the same as the first
+	outHull.resize(k > 1 ? k - 1 : k);
+}
+
+/*
+	Removes one edge of a convex polygon by extending its neighbouring edges until they meet, picking the edge that
+	adds the least area. Keeps the polygon convex and conservative. Fails if no edge can be removed without the polygon
+	leaving the bounds.
+*/
+static bool CollapseEdge(std::vector<Point>& polygon, float width, float height)
+{
+	const size_t n = polygon.size();
+	const float epsilon = 0.001f;
+
+	float bestArea = INFINITY;
+	size_t bestEdge = 0;
+	Point bestPoint;
+	for (size_t i = 0; i < n; ++i)
+	{
+		const Point& prev = polygon[(i + n - 1) % n];
+		const Point& a = polygon[i];
+		const Point& b = polygon[(i + 1) % n];
+		const Point& next = polygon[(i + 2) % n];
+
+		//Solve a + t * d0 = b - u * d1 (both t and u must be positive to meet beyond the edge)
+		Point d0 = Sub(a, prev);
+		Point d1 = Sub(next, b);
+		Point e = Sub(b, a);
+		float denom = Cross(d0, d1);
+		if (std::fabs(denom) < epsilon)
+			continue;
+		float t = Cross(e, d1) / denom;
+		float u = Cross(d0, e) / denom;
+		if (t <= 0.f || u <= 0.f)
+			continue;
+
+		Point p = { a.m_X + d0.m_X * t, a.m_Y + d0.m_Y * t };
+		if (p.m_X < -epsilon || p.m_Y < -epsilon || p.m_X > width + epsilon || p.m_Y > height + epsilon)
+			continue;
+
+		float area = std::fabs(Cross(e, Sub(p, a))) * 0.5f;
+		if (area < bestArea)
+		{
+			bestArea = area;
+			bestEdge = i;
+			bestPoint = { std::min(std::max(p.m_X, 0.f), width), std::min(std::max(p.m_Y, 0.f), height) };
+		}
+	}
+
+	if (bestArea == INFINITY)
+		return false;
+
+	//Replace the edge with the new point
+	polygon[bestEdge] = bestPoint;
+	polygon.erase(polygon.begin() + ((bestEdge + 1) % n));
+	return true;
+}
+
+bool SpriteHullBuilder::BuildHull(const uint8_t* alpha, int stride, int width, int height, const Settings& settings, std::vector<Point>& outHull)
+{
+	outHull.clear();
+	msg_assert(settings.m_MaxVertices >= 3, "BuildHull(): Hulls need at least 3 vertices!");
+
+	//Outer pixel corners of the visible span of each row (all the convex hull needs)
+	std::vector<Point> points;
+	points.reserve(static_cast<size_t>(height) * 4);
+	for (int y(0); y < height; ++y)
+	{
+		const uint8_t* row = alpha + static_cast<size_t>(y) * stride;
+
+		int minX = 0;
+		while (minX < width && row[minX] <= settings.m_AlphaThreshold)
+			++minX;
+		if (minX == width)
+			continue;
+
+		int maxX = width - 1;
+		while (row[maxX] <= settings.m_AlphaThreshold)
+			--maxX;
+
+		float fy = static_cast<float>(y);
+		points.push_back({ static_cast<float>(minX), fy });
+		points.push_back({ static_cast<float>(minX), fy + 1.f });
+		points.push_back({ static_cast<float>(maxX + 1), fy });
+		points.push_back({ static_cast<float>(maxX + 1), fy + 1.f });
+	}
+
+	//Nothing visible (leave as a quad)
+	if (points.empty())
+		return false;
+
+	BuildConvexHull(points, outHull);
+
+	//Cut vertices down to the limit
+	while (outHull.size() > settings.m_MaxVertices)
+	{
+		if (!CollapseEdge(outHull, static_cast<float>(width), static_cast<float>(height)))
+			break;
+	}
+
+	//Only keep hulls that are within the limit, and save enough over the quad
+	float quadArea = static_cast<float>(width) * static_cast<float>(height);
+	if (outHull.size() < 3 || outHull.size() > settings.m_MaxVertices || GetArea(outHull) > quadArea * (1.f - settings.m_MinSaving))
+	{
+		outHull.clear();
+		return false;
+	}
+
+	return true;
+}
+
+float SpriteHullBuilder::GetArea(const std::vector<Point>& polygon)
+{
+	float area = 0.f;
+	for (size_t i = 0; i < polygon.size(); ++i)
+		area += Cross(polygon[i], polygon[(i + 1) % polygon.size()]);
+	return std::fabs(area) * 0.5f;
+}
+
+bool SpriteHullBuilder::ProcessManifest(const std::string& manifestFP, unsigned manifestIndex, const std::string& outputManifestFP, const Settings& settings)
+{
+	m_Report = Report();
+
+	//Load manifest document
+	rapidjson::Document manifestDoc;
+	std::string error;
+	if (!ParseNewJSONDocument(manifestDoc, manifestFP, &error))
+	{
+		DBOUT("ProcessManifest(): " << error);
+		return false;
+	}
+
+	if (!manifestDoc.HasMember("Manifests") || manifestIndex >= manifestDoc["Manifests"].Size())
+	{
+		msg_assert(false, "ProcessManifest(): Manifest not found!");
+		return false;
+	}
+
+	std::error_code ec;
+	std::filesystem::create_directories(settings.m_OutputDirectory, ec);
+
+	//Output manifest is a copy of the source manifest, with processed textures pointed at their new frame data
+	rapidjson::Document outDoc;
+	outDoc.SetObject();
+	rapidjson::Document::AllocatorType& alloc = outDoc.GetAllocator();
+	rapidjson::Value outManifest(manifestDoc["Manifests"][manifestIndex], alloc);
+	rapidjson::Value& textures = outManifest["Textures"];
+
+	DDSImage image;
+	std::vector<uint8_t> alpha;
+	std::vector<Point> hull;
+	for (unsigned i(0); i < textures.Size(); ++i)
+	{
+		rapidjson::Value& entry = textures[i];
+		std::string name = entry["Texture_Name"].GetString();
+
+		//Textures that can't be read are passed through as they are
+		if (!image.Load(entry["Texture_Filepath"].GetString()) || !image.DecodeAlpha(alpha))
+		{
+			DBOUT("ProcessManifest(): Passing through texture without hulls: " << name);
+			continue;
+		}
+
+		rapidjson::Document frameDoc;
+		std::string fp = entry["Frames_Filepath"].GetString();
+		if (!ParseNewJSONDocument(frameDoc, fp, &error) || !frameDoc.HasMember("frames") || !frameDoc["frames"].IsArray())
+		{
+			DBOUT("ProcessManifest(): Failed to load frames: " << (error.empty() ? fp : error));
+			error.clear();
+			continue;
+		}
+
+		rapidjson::Value& frames = frameDoc["frames"];
+		for (unsigned j(0); j < frames.Size(); ++j)
+		{
+			rapidjson::Value& frame = frames[j];
+			int x = frame["frame"]["x"].GetInt();
+			int y = frame["frame"]["y"].GetInt();
+			int w = frame["frame"]["w"].GetInt();
+			int h = frame["frame"]["h"].GetInt();
+
+			//Hulls are built around the frame as packed, so rotated frames have their dims swapped
+			if (frame.HasMember("rotated") && frame["rotated"].GetBool())
+				std::swap(w, h);
+
+			if (x < 0 || y < 0 || w <= 0 || h <= 0 || x + w > image.GetWidth() || y + h > image.GetHeight())
+			{
+				DBOUT("ProcessManifest(): Frame outside of texture: " << fp);
+				continue;
+			}
+
+			//Replace any existing hull
+			if (frame.HasMember("hull"))
+				frame.RemoveMember("hull");
+
+			double quadArea = static_cast<double>(w) * h;
+			m_Report.m_QuadArea += quadArea;
+			++m_Report.m_FrameCount;
+
+			if (!BuildHull(alpha.data() + static_cast<size_t>(y) * image.GetWidth() + x, image.GetWidth(), w, h, settings, hull))
+			{
+				m_Report.m_HullArea += quadArea;
+				continue;
+			}
+
+			//Stored flat (x0, y0, x1, y1...)
+			rapidjson::Value hullArr(rapidjson::kArrayType);
+			for (auto& p : hull)
+			{
+				hullArr.PushBack(p.m_X, frameDoc.GetAllocator());
+				hullArr.PushBack(p.m_Y, frameDoc.GetAllocator());
+			}
+			frame.AddMember("hull", hullArr, frameDoc.GetAllocator());
+
+			m_Report.m_HullArea += GetArea(hull);
+			++m_Report.m_HullFrameCount;
+		}
+
+		std::string framesFP = settings.m_OutputDirectory + name + ".json";
+		if (!WriteJSONDocument(frameDoc, framesFP))
+		{
+			DBOUT("ProcessManifest(): Failed to write frames: " << framesFP);
+			return false;
+		}
+		entry["Frames_Filepath"].SetString(framesFP.c_str(), static_cast<rapidjson::SizeType>(framesFP.size()), alloc);
+		++m_Report.m_TextureCount;
+	}
+
+	rapidjson::Value manifests(rapidjson::kArrayType);
+	manifests.PushBack(outManifest, alloc);
+	outDoc.AddMember("Manifests", manifests, alloc);
+
+	if (!WriteJSONDocument(outDoc, outputManifestFP))
+	{
+		DBOUT("ProcessManifest(): Failed to write manifest: " << outputManifestFP);
+		return false;
+	}
+
+	DBOUT("ProcessManifest(): " << m_Report.m_HullFrameCount << "/" << m_Report.m_FrameCount << " frames given hulls across "
+		<< m_Report.m_TextureCount << " textures. Frame area covered: " << m_Report.GetCoverage() * 100.0 << "% of quads");
+
+	return true;
+}
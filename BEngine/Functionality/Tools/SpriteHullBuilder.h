@@ -0,0 +1,105 @@
+//*********************************************************************************\\
+//
+// Offline sprite hull builder. Reads a texture manifest, and for each frame of
+// each texture builds a tight convex polygon (with a capped vertex count) around
+// the frames visible pixels, using the textures alpha. Hulls are written into a
+// copy of the frame data (see LoadFrameData), alongside a new manifest that loads
+// from it.
+//
+// Hulls are conservative (every visible pixel is inside), stay within the frame,
+// and are only kept when they cut enough of the frames area to be worth the extra
+// vertices. Drawing with hulls (see SpriteMeshBuilder) cuts the transparent
+// pixels shaded for mostly empty sprites.
+//
+//*********************************************************************************\\
+
+#pragma once
+
+//Library Includes
+#include <string>
+#include <vector>
+#include <cstdint>
+
+class SpriteHullBuilder
+{
+public:
+
+	//////////////////////////////
+	/// Enums, Types & Statics ///
+	//////////////////////////////
+
+	struct Settings
+	{
+		//Pixels with alpha above this are visible
+		uint8_t m_AlphaThreshold = 8;
+		//Maximum vertices per hull (at least 3)
+		unsigned m_MaxVertices = 8;
+		//Minimum fraction of the frame area a hull must cut to be kept (else frame is drawn as a quad)
+		float m_MinSaving = 0.1f;
+		//Where frame data is written (relative to the executable, like manifest paths)
+		std::string m_OutputDirectory = "../../BEngine/Resources/Textures/Hulls/";
+	};
+
+	//Hull vertex, in pixels relative to the frame as packed in the texture
+	struct Point
+	{
+		float m_X = 0.f;
+		float m_Y = 0.f;
+	};
+
+	//Summary of the last build
+	struct Report
+	{
+		//Textures processed (the rest were passed through)
+		unsigned m_TextureCount = 0;
+		unsigned m_FrameCount = 0;
+		//Frames given a hull
+		unsigned m_HullFrameCount = 0;
+		//Summed area of every frame, as quads and with hulls (in pixels)
+		double m_QuadArea = 0.0;
+		double m_HullArea = 0.0;
+
+		//Hull area relative to quad area
+		double GetCoverage() const { return m_QuadArea > 0.0 ? m_HullArea / m_QuadArea : 1.0; }
+	};
+
+	////////////////////
+	/// Constructors ///
+	////////////////////
+
+	SpriteHullBuilder() { }
+	~SpriteHullBuilder() { }
+
+	//////////////////
+	/// Operations ///
+	//////////////////
+
+	/*
+		Builds hulls for the textures of the manifest at the given index, writing frame data to the output directory,
+		and a new manifest (holding a single manifest, at index 0) to the output filepath.
+	*/
+	bool ProcessManifest(const std::string& manifestFP, unsigned manifestIndex, const std::string& outputManifestFP, const Settings& settings);
+
+	/*
+		Builds a hull for a single frame from its alpha (one byte per pixel, with stride between rows). Returns false if
+		no hull is worth keeping (frame should be drawn as a quad).
+	*/
+	static bool BuildHull(const uint8_t* alpha, int stride, int width, int height, const Settings& settings, std::vector<Point>& outHull);
+
+	//Area of a polygon (in either winding)
+	static float GetArea(const std::vector<Point>& polygon);
+
+	/////////////////
+	/// Accessors ///
+	/////////////////
+
+	const Report& GetReport() { return m_Report; }
+
+private:
+
+	////////////
+	/// Data ///
+	////////////
+
+	Report m_Report;
+};
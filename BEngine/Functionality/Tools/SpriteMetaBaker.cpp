@@ -0,0 +1,80 @@
+#include "SpriteMetaBaker.h"
+
+//Utilities
+#include "Utils/Utils_Debug.h"
+#include "Utils/Utils_RapidJSON.h"
+
+//Engine Includes
+#include "Tools/DDSImage.h"
+#include "IO/SpriteMetaFile.h"
+#include "Types/BE_SharedTypes.h"
+#include "Managers/Mgr_TextureResources.h"
+
+bool SpriteMetaBaker::BakeManifest(const std::string& manifestFP, unsigned manifestIndex)
+{
+	m_Report = Report();
+
+	//Load manifest document
+	rapidjson::Document manifestDoc;
+	std::string error;
+	if (!ParseNewJSONDocument(manifestDoc, manifestFP, &error))
+	{
+		DBOUT("BakeManifest(): " << error);
+		return false;
+	}
+
+	if (!manifestDoc.HasMember("Manifests") || manifestIndex >= manifestDoc["Manifests"].Size())
+	{
+		msg_assert(false, "BakeManifest(): Manifest not found!");
+		return false;
+	}
+
+	const rapidjson::Value& textures = manifestDoc["Manifests"][manifestIndex]["Textures"];
+	DDSImage image;
+	for (unsigned i(0); i < textures.Size(); ++i)
+	{
+		const rapidjson::Value& entry = textures[i];
+		std::string framesFP = entry["Frames_Filepath"].GetString();
+
+		//UVs are baked against the texture size, so it must be read first
+		if (!image.Load(entry["Texture_Filepath"].GetString()))
+		{
+			DBOUT("BakeManifest(): Skipping texture that couldn't be read: " << entry["Texture_Name"].GetString());
+			++m_Report.m_SkippedCount;
+			continue;
+		}
+
+		SpriteTexture tex;
+		tex.m_TexSize = DirectX::XMUINT2(image.GetWidth(), image.GetHeight());
+		if (!Mgr_TextureResources::LoadFrameData(tex, framesFP))
+		{
+			++m_Report.m_SkippedCount;
+			continue;
+		}
+		if (entry.HasMember("Animations_Filepath"))
+		{
+			std::string animFP = entry["Animations_Filepath"].GetString();
+			if (!Mgr_TextureResources::LoadAnimationData(tex, animFP))
+			{
+				++m_Report.m_SkippedCount;
+				continue;
+			}
+		}
+
+		std::string bakedFP = SpriteMetaFile::GetBakedFilepath(framesFP);
+		if (!SpriteMetaFile::Write(bakedFP, tex))
+		{
+			DBOUT("BakeManifest(): Failed to write: " << bakedFP);
+			return false;
+		}
+
+		++m_Report.m_TextureCount;
+		m_Report.m_FrameCount += static_cast<unsigned>(tex.m_Frames.size());
+		m_Report.m_AnimationCount += static_cast<unsigned>(tex.m_Animations.size());
+	}
+
+	DBOUT("BakeManifest(): Baked " << m_Report.m_TextureCount << " textures (" << m_Report.m_FrameCount << " frames, "
+		<< m_Report.m_AnimationCount << " animations), skipped " << m_Report.m_SkippedCount);
+
+	return true;
+}
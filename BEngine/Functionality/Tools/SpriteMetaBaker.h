@@ -0,0 +1,61 @@
+//*********************************************************************************\\
+//
+// Offline sprite metadata baker. Reads a texture manifest, and for each texture
+// loads its frame (and animation) JSON exactly as Mgr_TextureResources does, then
+// writes the result out as a binary file next to the frame data (see
+// SpriteMetaFile). Mgr_TextureResources loads baked files in place of the JSON
+// when they exist and are newer than the JSON they came from.
+//
+//*********************************************************************************\\
+
+#pragma once
+
+//Library Includes
+#include <string>
+
+class SpriteMetaBaker
+{
+public:
+
+	//////////////////////////////
+	/// Enums, Types & Statics ///
+	//////////////////////////////
+
+	//Summary of the last bake
+	struct Report
+	{
+		//Textures baked (the rest were skipped)
+		unsigned m_TextureCount = 0;
+		unsigned m_SkippedCount = 0;
+		unsigned m_FrameCount = 0;
+		unsigned m_AnimationCount = 0;
+	};
+
+	////////////////////
+	/// Constructors ///
+	////////////////////
+
+	SpriteMetaBaker() { }
+	~SpriteMetaBaker() { }
+
+	//////////////////
+	/// Operations ///
+	//////////////////
+
+	//Bakes the metadata of every texture in the manifest at the given index
+	bool BakeManifest(const std::string& manifestFP, unsigned manifestIndex);
+
+	/////////////////
+	/// Accessors ///
+	/////////////////
+
+	const Report& GetReport() { return m_Report; }
+
+private:
+
+	////////////
+	/// Data ///
+	////////////
+
+	Report m_Report;
+};
@@ -0,0 +1,119 @@
+#include "TextureStreamingBenchmark.h"
+
+//Library Includes
+#include <chrono>
+#include <thread>
+#include <memory>
+#include <vector>
+#include <algorithm>
+
+//Utilities
+#include "Utils/Utils_Debug.h"
+
+//Engine Includes
+#include "Types/BE_SharedTypes.h"
+
+typedef std::chrono::high_resolution_clock Clock;
+
+//Updates until nothing is in flight, returning the updates taken (and tracking the longest update)
+static unsigned UpdateUntilIdle(TextureStreamer& streamer, double& maxUpdateMS)
+{
+	unsigned updates = 0;
+	while (!streamer.IsIdle())
+	{
+		streamer.Update();
+		maxUpdateMS = std::max(maxUpdateMS, streamer.GetStats().m_LastMilliseconds);
+		++updates;
+		std::this_thread::yield();
+	}
+	return updates;
+}
+
+bool TextureStreamingBenchmark::Run(const std::string& manifestFP, unsigned manifestIndex, const TextureStreamer::Budget& budget, unsigned uploadLatency)
+{
+	m_Result = Result();
+
+	std::vector<TextureLoadPipeline::Entry> entries;
+	if (!TextureLoadPipeline::ReadManifest(manifestFP, manifestIndex, entries) || entries.empty())
+		return false;
+	m_Result.m_EntryCount = entries.size();
+
+	//Placeholder with a single empty frame (no resource is needed headless)
+	SpriteTexture placeholder;
+	placeholder.m_Name = "Placeholder";
+	placeholder.m_FrameStorage.push_back(SpriteFrame());
+	placeholder.m_Frames = placeholder.m_FrameStorage;
+
+	TextureStreamer streamer(std::make_unique<TextureStreamer::StubUploadBackend>(uploadLatency));
+	streamer.SetBudget(budget);
+	streamer.SetPlaceholder(placeholder, 0);
+
+	//Request: textures must keep their address while streaming
+	std::vector<std::unique_ptr<SpriteTexture>> textures;
+	textures.reserve(entries.size());
+	auto start = Clock::now();
+	for (auto& entry : entries)
+	{
+		textures.push_back(std::make_unique<SpriteTexture>());
+		streamer.Request(entry, *textures.back());
+	}
+
+	//Load and finalise within budget
+	m_Result.m_StreamUpdates = UpdateUntilIdle(streamer, m_Result.m_MaxUpdateMS);
+	m_Result.m_StreamMS = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+	std::vector<size_t> frameCounts(textures.size(), 0);
+	std::vector<const SpriteFrame*> frameData(textures.size(), nullptr);
+	for (size_t i(0); i < textures.size(); ++i)
+	{
+		TextureStreamer::State state = streamer.GetState(textures[i].get());
+		if (state == TextureStreamer::State::RESIDENT)
+		{
+			++m_Result.m_Resident;
+			frameCounts[i] = textures[i]->m_Frames.size();
+			frameData[i] = textures[i]->m_Frames.data();
+		}
+		else if (state == TextureStreamer::State::FAILED)
+			++m_Result.m_Failed;
+	}
+
+	//Evict everything resident (drawing with the placeholder again, over the same number of frames)
+	for (size_t i(0); i < textures.size(); ++i)
+	{
+		if (streamer.GetState(textures[i].get()) != TextureStreamer::State::RESIDENT)
+			continue;
+
+		streamer.Evict(*textures[i]);
+		if (streamer.GetState(textures[i].get()) == TextureStreamer::State::EVICTED &&
+			textures[i]->m_Frames.size() == frameCounts[i] && textures[i]->m_Frames.data() != frameData[i])
+			++m_Result.m_Evicted;
+	}
+
+	//Reload, which should bring back the data kept when evicted
+	start = Clock::now();
+	for (size_t i(0); i < textures.size(); ++i)
+	{
+		if (streamer.GetState(textures[i].get()) == TextureStreamer::State::EVICTED)
+			streamer.Reload(entries[i], *textures[i]);
+	}
+	m_Result.m_ReloadUpdates = UpdateUntilIdle(streamer, m_Result.m_MaxUpdateMS);
+	m_Result.m_ReloadMS = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+	for (size_t i(0); i < textures.size(); ++i)
+	{
+		if (frameCounts[i] > 0 && streamer.GetState(textures[i].get()) == TextureStreamer::State::RESIDENT &&
+			textures[i]->m_Frames.size() == frameCounts[i])
+			++m_Result.m_Reloaded;
+	}
+	m_Result.m_BytesUploaded = streamer.GetStats().m_BytesUploaded;
+
+	bool result = m_Result.m_Failed == 0 && m_Result.m_Resident == m_Result.m_EntryCount &&
+		m_Result.m_Evicted == m_Result.m_Resident && m_Result.m_Reloaded == m_Result.m_Resident;
+
+	DBOUT("Run(): " << m_Result.m_EntryCount << " entries: " << m_Result.m_Resident << " resident (" << m_Result.m_Failed << " failed) after "
+		<< m_Result.m_StreamUpdates << " updates (" << m_Result.m_StreamMS << "ms), " << m_Result.m_Evicted << " evicted, " << m_Result.m_Reloaded
+		<< " reloaded after " << m_Result.m_ReloadUpdates << " updates (" << m_Result.m_ReloadMS << "ms). Longest update: "
+		<< m_Result.m_MaxUpdateMS << "ms, " << m_Result.m_BytesUploaded << " bytes uploaded" << (result ? "" : " - STATES INVALID"));
+
+	return result;
+}
@@ -0,0 +1,77 @@
+//*********************************************************************************\\
+//
+// Headless run of TextureStreamer over a texture manifest (with
+// StubUploadBackend). Requests every entry, updates until all are finalised
+// within the streaming budget, then evicts and reloads them all, checking the
+// state of each texture along the way. Update counts and timings are output
+// via DBOUT.
+//
+//*********************************************************************************\\
+
+#pragma once
+
+//Library Includes
+#include <string>
+
+//Engine Includes
+#include "IO/TextureStreamer.h"
+
+class TextureStreamingBenchmark
+{
+public:
+
+	//////////////////////////////
+	/// Enums, Types & Statics ///
+	//////////////////////////////
+
+	struct Result
+	{
+		size_t m_EntryCount = 0;
+		//Textures that reached each state when expected
+		size_t m_Resident = 0;
+		size_t m_Failed = 0;
+		size_t m_Evicted = 0;
+		size_t m_Reloaded = 0;
+		//Updates taken to finalise all requests, and to reload all evicted textures
+		unsigned m_StreamUpdates = 0;
+		unsigned m_ReloadUpdates = 0;
+		//Total time (milliseconds) from first request until idle, and the longest single update
+		double m_StreamMS = 0.0;
+		double m_ReloadMS = 0.0;
+		double m_MaxUpdateMS = 0.0;
+		size_t m_BytesUploaded = 0;
+	};
+
+	////////////////////
+	/// Constructors ///
+	////////////////////
+
+	TextureStreamingBenchmark() { }
+	~TextureStreamingBenchmark() { }
+
+	//////////////////
+	/// Operations ///
+	//////////////////
+
+	/*
+		Streams every entry of the manifest at the given index through request, load, budgeted finalise, evict and reload,
+		with uploads completing after the given number of update checks. Returns false if any texture ended up in the
+		wrong state.
+	*/
+	bool Run(const std::string& manifestFP, unsigned manifestIndex, const TextureStreamer::Budget& budget, unsigned uploadLatency = 2);
+
+	/////////////////
+	/// Accessors ///
+	/////////////////
+
+	//Result of the last run
+	const Result& GetResult() { return m_Result; }
+
+private:
+
+	////////////
+	/// Data ///
+	////////////
+
+	Result m_Result;
+};
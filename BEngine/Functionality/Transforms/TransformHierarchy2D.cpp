@@ -0,0 +1,291 @@
+#include "TransformHierarchy2D.h"
+
+#include "Utils/Utils_Debug.h"
+
+#include <cmath>
+
+//Marks an unset depth value when rebuilding order
+static constexpr unsigned DEPTH_UNSET = 0xFFFFFFFF;
+
+TransformHierarchy2D::TransformID TransformHierarchy2D::CreateTransform(TransformID parent)
+{
+	return CreateTransform(Transform2D(), parent);
+}
+
+TransformHierarchy2D::TransformID TransformHierarchy2D::CreateTransform(const Transform2D& local, TransformID parent)
+{
+	msg_assert(parent == INVALID_ID || IsValidID(parent), "CreateTransform(): Invalid parent ID!");
+
+	TransformID id = INVALID_ID;
+
+	//Reuse freed IDs first, otherwise grow storage
+	if (!m_FreeIDs.empty())
+	{
+		id = m_FreeIDs.back();
+		m_FreeIDs.pop_back();
+
+		m_Locals[id] = local;
+		m_Parents[id] = parent;
+		m_InUse[id] = true;
+	}
+	else
+	{
+		id = static_cast<TransformID>(m_Parents.size());
+
+		m_Locals.push_back(local);
+		m_Worlds.push_back(local);
+		m_Parents.push_back(parent);
+		m_DirtyFlags.push_back(false);
+		m_InUse.push_back(true);
+	}
+
+	MarkDirty(id);
+	m_OrderDirty = true;
+
+	return id;
+}
+
+void TransformHierarchy2D::ReleaseTransform(TransformID id)
+{
+	if (!IsValidID(id))
+	{
+		msg_assert(false, "ReleaseTransform(): Invalid ID!");
+		return;
+	}
+
+	//Re-parent any children to this nodes parent
+	TransformID parent = m_Parents[id];
+	for (TransformID i(0); i < m_Parents.size(); ++i)
+	{
+		if (m_InUse[i] && m_Parents[i] == id)
+		{
+			m_Parents[i] = parent;
+			MarkDirty(i);
+		}
+	}
+
+	//Clear and free ID
+	m_InUse[id] = false;
+	m_DirtyFlags[id] = false;
+	m_Parents[id] = INVALID_ID;
+	m_FreeIDs.push_back(id);
+
+	m_OrderDirty = true;
+}
+
+void TransformHierarchy2D::Clear()
+{
+	m_Locals.clear();
+	m_Worlds.clear();
+	m_Parents.clear();
+	m_DirtyFlags.clear();
+	m_InUse.clear();
+	m_Order.clear();
+	m_Depths.clear();
+	m_UpdatedIDs.clear();
+	m_FreeIDs.clear();
+
+	m_AnyDirty = false;
+	m_OrderDirty = false;
+}
+
+void TransformHierarchy2D::Reserve(size_t count)
+{
+	m_Locals.reserve(count);
+	m_Worlds.reserve(count);
+	m_Parents.reserve(count);
+	m_DirtyFlags.reserve(count);
+	m_InUse.reserve(count);
+	m_Order.reserve(count);
+	m_Depths.reserve(count);
+	m_UpdatedIDs.reserve(count);
+}
+
+void TransformHierarchy2D::UpdateWorldTransforms()
+{
+	if (m_OrderDirty)
+		RebuildOrder();
+
+	//Nothing changed, so nothing to do
+	if (!m_AnyDirty)
+		return;
+
+	/*
+		Order guarantees that parents are visited before children, so a parent updated this pass already has its
+		dirty flag set by the time its children are visited. Children of a dirty parent are flagged dirty in turn,
+		so only changed subtrees are recalculated.
+	*/
+	for (TransformID id : m_Order)
+	{
+		TransformID parent = m_Parents[id];
+		if (parent != INVALID_ID && m_DirtyFlags[parent])
+			m_DirtyFlags[id] = true;
+
+		if (!m_DirtyFlags[id])
+			continue;
+
+		const Transform2D& local = m_Locals[id];
+		Transform2D& world = m_Worlds[id];
+
+		//Root nodes use local as world
+		if (parent == INVALID_ID)
+		{
+			world = local;
+		}
+		else
+		{
+			const Transform2D& pWorld = m_Worlds[parent];
+
+			//Scale then rotate local position into parent space
+			Vec2 pos = local.m_Position * pWorld.m_Scale;
+			float cosR = std::cos(pWorld.m_Rotation);
+			float sinR = std::sin(pWorld.m_Rotation);
+
+			world.m_Position =
+			{
+				pWorld.m_Position.x + (pos.x * cosR - pos.y * sinR),
+				pWorld.m_Position.y + (pos.x * sinR + pos.y * cosR)
+			};
+			world.m_Rotation = pWorld.m_Rotation + local.m_Rotation;
+			world.m_Scale = pWorld.m_Scale * local.m_Scale;
+		}
+
+		m_UpdatedIDs.push_back(id);
+	}
+
+	//Clear flags for only what was updated
+	for (TransformID id : m_UpdatedIDs)
+		m_DirtyFlags[id] = false;
+	m_UpdatedIDs.clear();
+
+	m_AnyDirty = false;
+}
+
+bool TransformHierarchy2D::SetParent(TransformID id, TransformID parent)
+{
+	msg_assert(IsValidID(id), "SetParent(): Invalid ID!");
+	msg_assert(parent == INVALID_ID || IsValidID(parent), "SetParent(): Invalid parent ID!");
+
+	//Walk up from new parent, failing if this transform is found (would create cycle)
+	for (TransformID i = parent; i != INVALID_ID; i = m_Parents[i])
+	{
+		if (i == id)
+		{
+			msg_assert(false, "SetParent(): Parent would create cyclic hierarchy!");
+			return false;
+		}
+	}
+
+	m_Parents[id] = parent;
+	MarkDirty(id);
+	m_OrderDirty = true;
+
+	return true;
+}
+
+TransformHierarchy2D::TransformID TransformHierarchy2D::GetParent(TransformID id)
+{
+	msg_assert(IsValidID(id), "GetParent(): Invalid ID!");
+	return m_Parents[id];
+}
+
+void TransformHierarchy2D::SetLocalTransform(TransformID id, const Transform2D& local)
+{
+	msg_assert(IsValidID(id), "SetLocalTransform(): Invalid ID!");
+	m_Locals[id] = local;
+	MarkDirty(id);
+}
+
+void TransformHierarchy2D::SetLocalPosition(TransformID id, const Vec2& pos)
+{
+	msg_assert(IsValidID(id), "SetLocalPosition(): Invalid ID!");
+	m_Locals[id].m_Position = pos;
+	MarkDirty(id);
+}
+
+void TransformHierarchy2D::SetLocalRotation(TransformID id, float rotation)
+{
+	msg_assert(IsValidID(id), "SetLocalRotation(): Invalid ID!");
+	m_Locals[id].m_Rotation = rotation;
+	MarkDirty(id);
+}
+
+void TransformHierarchy2D::SetLocalScale(TransformID id, const Vec2& scale)
+{
+	msg_assert(IsValidID(id), "SetLocalScale(): Invalid ID!");
+	m_Locals[id].m_Scale = scale;
+	MarkDirty(id);
+}
+
+const Transform2D& TransformHierarchy2D::GetLocalTransform(TransformID id)
+{
+	msg_assert(IsValidID(id), "GetLocalTransform(): Invalid ID!");
+	return m_Locals[id];
+}
+
+const Transform2D& TransformHierarchy2D::GetWorldTransform(TransformID id)
+{
+	msg_assert(IsValidID(id), "GetWorldTransform(): Invalid ID!");
+
+	//Lazily bring world transforms up to date
+	if (m_AnyDirty || m_OrderDirty)
+		UpdateWorldTransforms();
+
+	return m_Worlds[id];
+}
+
+void TransformHierarchy2D::MarkDirty(TransformID id)
+{
+	m_DirtyFlags[id] = true;
+	m_AnyDirty = true;
+}
+
+void TransformHierarchy2D::RebuildOrder()
+{
+	size_t count = m_Parents.size();
+	m_Depths.assign(count, DEPTH_UNSET);
+
+	//Scratch chain used for walking up the hierarchy
+	std::vector<TransformID> chain;
+	unsigned maxDepth = 0;
+
+	//Calculate depth of each node, walking up until a known depth (or root) is found
+	for (TransformID id(0); id < count; ++id)
+	{
+		if (!m_InUse[id] || m_Depths[id] != DEPTH_UNSET)
+			continue;
+
+		TransformID i = id;
+		while (i != INVALID_ID && m_Depths[i] == DEPTH_UNSET)
+		{
+			chain.push_back(i);
+			i = m_Parents[i];
+		}
+
+		//Resolve depths back down the chain
+		unsigned depth = (i == INVALID_ID) ? 0 : m_Depths[i] + 1;
+		while (!chain.empty())
+		{
+			m_Depths[chain.back()] = depth++;
+			chain.pop_back();
+		}
+
+		if (depth - 1 > maxDepth)
+			maxDepth = depth - 1;
+	}
+
+	//Counting sort by depth to get breadth-first order
+	std::vector<unsigned> offsets(maxDepth + 2, 0);
+	for (TransformID id(0); id < count; ++id)
+		if (m_InUse[id])
+			++offsets[m_Depths[id] + 1];
+	for (size_t i(1); i < offsets.size(); ++i)
+		offsets[i] += offsets[i - 1];
+
+	m_Order.resize(offsets.back());
+	for (TransformID id(0); id < count; ++id)
+		if (m_InUse[id])
+			m_Order[offsets[m_Depths[id]]++] = id;
+
+	m_OrderDirty = false;
+}
@@ -0,0 +1,163 @@
+//*********************************************************************************\\
+//
+// Parent/child transform hierarchy for 2D elements. Stores local transforms for
+// each node alongside a cached world transform, which is recalculated lazily
+// (only for nodes marked dirty and their children) in a breadth-first pass over
+// the contiguous node storage.
+//
+// Modules can be bound to a transform (see Module_Interface::BindTransform) to
+// read their world position from here rather than be synced manually.
+//
+//*********************************************************************************\\
+
+#pragma once
+
+//Library Includes
+#include <vector>
+
+//Utilities
+#include "Utils/Utils_D3D.h"
+
+/*
+	Basic 2D transform description. Rotation in radians.
+*/
+struct Transform2D
+{
+	Vec2 m_Position = { 0.f, 0.f };
+	Vec2 m_Scale = { 1.f, 1.f };
+	float m_Rotation = 0.f;
+};
+
+class TransformHierarchy2D
+{
+public:
+
+	//////////////////////////////
+	/// Enums, Types & Statics ///
+	//////////////////////////////
+
+	typedef unsigned TransformID;
+
+	//Reserved ID for no transform (or no parent)
+	static constexpr TransformID INVALID_ID = 0xFFFFFFFF;
+
+	////////////////////
+	/// Constructors ///
+	////////////////////
+
+	TransformHierarchy2D() { }
+	TransformHierarchy2D(size_t reserveCount) { Reserve(reserveCount); }
+	~TransformHierarchy2D() { }
+
+	//////////////////
+	/// Operations ///
+	//////////////////
+
+	//
+	//Creation & Release
+	//
+
+	//Creates new transform as a child of given parent (or as a root node if none given)
+	TransformID CreateTransform(TransformID parent = INVALID_ID);
+	TransformID CreateTransform(const Transform2D& local, TransformID parent = INVALID_ID);
+	/*
+		Releases the transform for reuse. Any children of the transform are re-parented to its parent
+		(keeping their local transforms).
+	*/
+	void ReleaseTransform(TransformID id);
+	//Releases all transforms
+	void Clear();
+
+	//Reserves storage for a given number of transforms
+	void Reserve(size_t count);
+
+	//
+	//Updates
+	//
+
+	/*
+		Recalculates the world transforms of all dirty nodes (and their children). Is cheap when nothing is dirty,
+		and is automatically called when requesting a world transform while dirty.
+	*/
+	void UpdateWorldTransforms();
+
+	/////////////////
+	/// Accessors ///
+	/////////////////
+
+	//
+	//Hierarchy
+	//
+
+	//Sets new parent of transform (INVALID_ID to make it a root). Returns false if this would create a cycle.
+	bool SetParent(TransformID id, TransformID parent);
+	TransformID GetParent(TransformID id);
+
+	//
+	//Local Transforms (each marks the transform dirty)
+	//
+
+	void SetLocalTransform(TransformID id, const Transform2D& local);
+	void SetLocalPosition(TransformID id, const Vec2& pos);
+	void SetLocalRotation(TransformID id, float rotation);
+	void SetLocalScale(TransformID id, const Vec2& scale);
+
+	const Transform2D& GetLocalTransform(TransformID id);
+
+	//
+	//World Transforms
+	//
+
+	//Returns cached world transform, updating hierarchy first if needed
+	const Transform2D& GetWorldTransform(TransformID id);
+
+	//
+	//General
+	//
+
+	bool IsValidID(TransformID id) { return id < m_Parents.size() && m_InUse[id]; }
+	bool IsDirty() { return m_AnyDirty || m_OrderDirty; }
+	size_t GetTransformCount() { return m_Parents.size() - m_FreeIDs.size(); }
+
+private:
+
+	//////////////////
+	/// Operations ///
+	//////////////////
+
+	//Flags transform as needing its world transform recalculated
+	void MarkDirty(TransformID id);
+	//Rebuilds the breadth-first update order (parents always before their children)
+	void RebuildOrder();
+
+	////////////
+	/// Data ///
+	////////////
+
+	//
+	//Node Data (indexed by ID)
+	//
+
+	std::vector<Transform2D> m_Locals;
+	std::vector<Transform2D> m_Worlds;
+	std::vector<TransformID> m_Parents;
+	//Dirty state per node, also used to propagate dirtiness down to children during an update
+	std::vector<unsigned char> m_DirtyFlags;
+	std::vector<unsigned char> m_InUse;
+
+	//
+	//Update Data
+	//
+
+	//Breadth-first order of in use IDs
+	std::vector<TransformID> m_Order;
+	//Per node depth, used as scratch data when rebuilding order
+	std::vector<unsigned> m_Depths;
+	//IDs updated in the last pass (so flags can be cleared without a full pass)
+	std::vector<TransformID> m_UpdatedIDs;
+	//Previously released IDs available for reuse
+	std::vector<TransformID> m_FreeIDs;
+
+	bool m_AnyDirty = false;
+	bool m_OrderDirty = false;
+};
@@ -1,12 +1,34 @@
 #include "Mgr_Graphics.h"
 
+#include <set>
+#include <cmath>
+#include <limits>
+#include <unordered_set>
+
 #include "Actors/Actor2D_Interface.h"
+#include "Modules/Module_Sprite.h"
+#include "Modules/Module_AnimatedSprite.h"
 
+#include "Utils/Utils_General.h"
 #include "Utils/Utils_Debug.h"
 #include "Utils/Utils_D3D_Debug.h"
 
 #include "Game.h"
 
+//Gets the SpriteData of a sprite module (nullptr for other modules)
+static SpriteData* GetModuleSpriteData(Module_Interface* mod)
+{
+	switch (mod->GetType())
+	{
+	case Module_Interface::ModuleTypeID::SPRITE:
+		return &recast_static(Module_Sprite*, mod)->GetSpriteData();
+	case Module_Interface::ModuleTypeID::ANIMATED_SPRITE:
+		return &recast_static(Module_AnimatedSprite*, mod)->GetSpriteData();
+	default:
+		return nullptr;
+	}
+}
+
 Mgr_Graphics::Mgr_Graphics(ID3D12Device* d3dDevice)
 {
 	//Initialise common states
@@ -39,6 +61,12 @@ DirectX::SpriteFont* Mgr_Graphics::GetSpritefont(unsigned index)
 	return m_Spritefonts[index].get();
 }
 
+const Mgr_Graphics::RenderGroupCullStats& Mgr_Graphics::GetRenderGroupCullStats(unsigned index)
+{
+	msg_assert(index < m_CullStats.size(), "GetRenderGroupCullStats(): Index OOR!");
+	return m_CullStats[index];
+}
+
 unsigned Mgr_Graphics::InsertNewRootSignature(Microsoft::WRL::ComPtr<ID3D12RootSignature>& rootSig)
 {
 	m_RootSigs.push_back(std::move(rootSig));
@@ -67,6 +95,9 @@ void Mgr_Graphics::SyncRenderGroupCount()
 		m_RenderGroups.push_back(std::vector<Actor2D_Interface*>());
 		m_RenderGroups[i].reserve(GROUP_RESERVE_COUNT);
 	}
+
+	m_PendingReports.assign(m_RenderGroups.size(), false);
+	m_CullStats.assign(m_RenderGroups.size(), RenderGroupCullStats());
 }
 
 void Mgr_Graphics::SubmitToRenderGroup(unsigned index, Actor2D_Interface* actor)
@@ -76,10 +107,48 @@ void Mgr_Graphics::SubmitToRenderGroup(unsigned index, Actor2D_Interface* actor)
 	m_RenderGroups[index].push_back(actor);
 }
 
+void Mgr_Graphics::SortRenderGroup(unsigned index)
+{
+	msg_assert(index < m_RenderGroups.size(), "SortRenderGroup(): Index OOR");
+
+	std::vector<Actor2D_Interface*>& group = m_RenderGroups[index];
+
+	//Keys are only built here, so groups that are never sorted don't pay for them (position is submission order)
+	m_SortKeys.clear();
+	for (uint32_t i(0); i < group.size(); ++i)
+		m_SortKeys.push_back({ BuildSortKey(index, group[i], i), i });
+
+	RenderSortKey::Sort(m_SortKeys, m_SortScratch);
+
+	//Reorder actors to match
+	m_SortedActors.resize(group.size());
+	for (uint32_t i(0); i < m_SortKeys.size(); ++i)
+		m_SortedActors[i] = group[m_SortKeys[i].m_Index];
+	group.swap(m_SortedActors);
+}
+
 void Mgr_Graphics::DrawBatch(System& sys, unsigned index, ID3D12GraphicsCommandList* cmdList)
 {
 	msg_assert(index <= m_Spritebatches.size(), "DrawBatch(): Index OOR");
 
+	//Drop anything off screen before drawing
+	CullRenderGroup(index);
+
+	//Report stats if requested (done here so the group is fully submitted)
+	if (index < m_PendingReports.size() && m_PendingReports[index])
+	{
+		const RenderGroupCullStats& cull = m_CullStats[index];
+		DBOUT("Render Group " << index << ": " << cull.m_SubmittedCount << " actors submitted, " << cull.m_CulledCount
+			<< " culled, " << cull.m_DrawnCount << " drawn");
+		RenderGroupTextureStats stats = GetRenderGroupTextureStats(index);
+		DBOUT("Render Group " << index << ": " << stats.m_SpriteCount << " sprites, " << stats.m_TextureEntryCount
+			<< " texture entries, " << stats.m_GPUTextureCount << " distinct GPU textures");
+		RenderGroupOverdrawStats overdraw = GetRenderGroupOverdrawStats(index);
+		DBOUT("Render Group " << index << ": " << overdraw.m_HullSpriteCount << " sprites with hulls, " << overdraw.m_QuadArea
+			<< " pixels as quads, " << overdraw.m_HullArea << " pixels with hulls (" << overdraw.GetSaving() * 100.0 << "% saved)");
+		m_PendingReports[index] = false;
+	}
+
 	//Open batch to drawing
 	m_Spritebatches[index]->BeginBatch(cmdList);
 	//Submit sync'd render group for draw
@@ -88,12 +157,154 @@ void Mgr_Graphics::DrawBatch(System& sys, unsigned index, ID3D12GraphicsCommandL
 	m_Spritebatches[index]->EndBatch();
 }
 
+void Mgr_Graphics::CullRenderGroup(unsigned index)
+{
+	msg_assert(index < m_RenderGroups.size(), "CullRenderGroup(): Index OOR");
+
+	std::vector<Actor2D_Interface*>& group = m_RenderGroups[index];
+	RenderGroupCullStats& stats = m_CullStats[index];
+	stats.m_SubmittedCount = static_cast<unsigned>(group.size());
+	stats.m_CulledCount = 0;
+	stats.m_DrawnCount = stats.m_SubmittedCount;
+
+	//Visible area in the space sprites are drawn in
+	W_SpriteBatch& batch = *m_Spritebatches[index];
+	if (!m_CullingEnabled || group.empty() || batch.m_Viewport.Width <= 0.f || batch.m_Viewport.Height <= 0.f)
+		return;
+
+	const DirectX::XMMATRIX* transform = nullptr;
+	if (batch.m_DrawMode == W_SpriteBatch::DrawMode::TRANSFORMED)
+	{
+		batch.m_Transform.Update();
+		transform = &batch.m_Transform.GetMatrix();
+	}
+	DirectX::XMFLOAT4 visibleRect;
+	if (!ViewportCuller::BuildVisibleRect(batch.m_Viewport.Width, batch.m_Viewport.Height, transform, visibleRect))
+		return;
+
+	//Gather every textured sprite of every actor, then cull them all at once
+	m_Culler.Reset();
+	m_ActorBounds.clear();
+	for (auto& actor : group)
+	{
+		m_ActorBounds.push_back(m_Culler.GetBoundsCount());
+		for (unsigned i(0); i < actor->GetModuleCount(); ++i)
+		{
+			Module_Interface* mod = actor->GetModule(i);
+			//Modules bound to a transform only pick up its position when read, so bring them up to date before bounding
+			mod->ReadWorldTransform();
+			SpriteData* spr = GetModuleSpriteData(mod);
+			if (spr && spr->m_Texture)
+				m_Culler.AddSprite(*spr);
+			//Strings aren't bounded, so anything drawing one is always kept
+			else if (mod->GetType() == Module_Interface::ModuleTypeID::UI_SF_STRING)
+				m_Culler.AddBounds(0.f, 0.f, std::numeric_limits<float>::infinity());
+		}
+	}
+	m_ActorBounds.push_back(m_Culler.GetBoundsCount());
+	m_Culler.Cull(visibleRect);
+
+	//Keep actors with any sprite visible (or none to go by)
+	size_t kept = 0;
+	for (size_t i(0); i < group.size(); ++i)
+	{
+		bool visible = m_ActorBounds[i] == m_ActorBounds[i + 1];
+		for (uint32_t b(m_ActorBounds[i]); !visible && b < m_ActorBounds[i + 1]; ++b)
+			visible = m_Culler.IsVisible(b);
+		if (!visible)
+			continue;
+
+		group[kept++] = group[i];
+	}
+	group.resize(kept);
+
+	stats.m_DrawnCount = static_cast<unsigned>(kept);
+	stats.m_CulledCount = stats.m_SubmittedCount - stats.m_DrawnCount;
+}
+
 void Mgr_Graphics::ClearRenderGroups()
 {
 	for (auto& a : m_RenderGroups)
 		a.clear();
 }
 
+template<class Func>
+void Mgr_Graphics::ForEachSpriteInGroup(unsigned index, Func func)
+{
+	for (auto& actor : m_RenderGroups[index])
+	{
+		for (unsigned i(0); i < actor->GetModuleCount(); ++i)
+		{
+			SpriteData* spr = GetModuleSpriteData(actor->GetModule(i));
+			if (spr && spr->m_Texture)
+				func(*spr);
+		}
+	}
+}
+
+uint64_t Mgr_Graphics::BuildSortKey(unsigned index, Actor2D_Interface* actor, uint32_t order)
+{
+	//Texture of the first textured sprite module (actors without one sort after those with)
+	SpriteTexture::TextureID textureID = SpriteTexture::INVALID_ID;
+	for (unsigned i(0); i < actor->GetModuleCount(); ++i)
+	{
+		SpriteData* spr = GetModuleSpriteData(actor->GetModule(i));
+		if (spr && spr->m_Texture)
+		{
+			textureID = spr->m_Texture->m_ID;
+			break;
+		}
+	}
+
+	return RenderSortKey::Build(index, actor->GetActorDepth(), textureID, order);
+}
+
+Mgr_Graphics::RenderGroupTextureStats Mgr_Graphics::GetRenderGroupTextureStats(unsigned index)
+{
+	msg_assert(index < m_RenderGroups.size(), "GetRenderGroupTextureStats(): Index OOR");
+
+	RenderGroupTextureStats stats;
+	std::unordered_set<const SpriteTexture*> entries;
+	//GPU textures identified by heap and index in heap
+	std::set<std::pair<const DirectX::DescriptorHeap*, unsigned>> gpuTextures;
+
+	ForEachSpriteInGroup(index, [&](SpriteData& spr)
+	{
+		++stats.m_SpriteCount;
+		entries.insert(spr.m_Texture);
+		gpuTextures.insert({ spr.m_Texture->m_Heap, spr.m_Texture->m_HeapIndex });
+	});
+
+	stats.m_TextureEntryCount = static_cast<unsigned>(entries.size());
+	stats.m_GPUTextureCount = static_cast<unsigned>(gpuTextures.size());
+	return stats;
+}
+
+Mgr_Graphics::RenderGroupOverdrawStats Mgr_Graphics::GetRenderGroupOverdrawStats(unsigned index)
+{
+	msg_assert(index < m_RenderGroups.size(), "GetRenderGroupOverdrawStats(): Index OOR");
+
+	RenderGroupOverdrawStats stats;
+	ForEachSpriteInGroup(index, [&stats](SpriteData& spr)
+	{
+		const SpriteFrame& frame = spr.GetCurrentFrame();
+		double area = std::fabs(static_cast<double>(frame.m_Size.x) * frame.m_Size.y * spr.m_Scale.x * spr.m_Scale.y);
+
+		++stats.m_SpriteCount;
+		if (frame.m_HullCount)
+			++stats.m_HullSpriteCount;
+		stats.m_QuadArea += area;
+		stats.m_HullArea += area * frame.m_HullCoverage;
+	});
+
+	return stats;
+}
+
+void Mgr_Graphics::RequestRenderGroupReport()
+{
+	m_PendingReports.assign(m_RenderGroups.size(), true);
+}
+
 std::array<const CD3DX12_STATIC_SAMPLER_DESC, 6> Mgr_Graphics::GetStaticSamplers()
 {
 	// Applications usually only need a handful of samplers.  So just define them all up front
@@ -25,6 +25,8 @@
 #include <array>
 
 #include "Types/SpriteBatch_Wrapper.h"
+#include "Rendering/RenderSortKey.h"
+#include "Rendering/ViewportCuller.h"
 
 //
 //Forward Declarations
@@ -42,6 +44,45 @@ public:
 
     const static int GROUP_RESERVE_COUNT = 4048;
 
+    /*
+        Texture usage of a render group. Every texture change in draw order breaks a batch, so fewer distinct
+        GPU textures (e.g. via atlasing, see AtlasPacker) means fewer batches.
+    */
+    struct RenderGroupTextureStats
+    {
+        //Sprite modules with a texture set
+        unsigned m_SpriteCount = 0;
+        //Distinct SpriteTexture entries used
+        unsigned m_TextureEntryCount = 0;
+        //Distinct GPU textures used (entries sharing a resource/SRV count once)
+        unsigned m_GPUTextureCount = 0;
+    };
+
+    /*
+        CPU side estimate of the pixels a render group shades (summed over sprites, so overlapping sprites count
+        each time). Compares drawing every sprite as a quad against drawing with frame hulls (see SpriteMeshBuilder).
+    */
+    struct RenderGroupOverdrawStats
+    {
+        unsigned m_SpriteCount = 0;
+        //Sprites whose current frame has a hull
+        unsigned m_HullSpriteCount = 0;
+        //Pixels shaded (scaled frame area)
+        double m_QuadArea = 0.0;
+        double m_HullArea = 0.0;
+
+        //Fraction of the quad pixels saved by hulls
+        double GetSaving() const { return m_QuadArea > 0.0 ? 1.0 - (m_HullArea / m_QuadArea) : 0.0; }
+    };
+
+    //Actors culled from a render group by its last cull (see CullRenderGroup)
+    struct RenderGroupCullStats
+    {
+        unsigned m_SubmittedCount = 0;
+        unsigned m_CulledCount = 0;
+        unsigned m_DrawnCount = 0;
+    };
+
     ////////////////////
     /// Constructors ///
     ////////////////////
@@ -77,6 +118,18 @@ public:
 
     //Submits the given actor to target render group (index should sync with target spritebatch)
     void SubmitToRenderGroup(unsigned index, Actor2D_Interface* actor);
+    /*
+        Sorts the target render group by sort keys built for it here (actor depth high to low, then texture, then submission
+        order, see RenderSortKey). For batches that draw in submission order (e.g. immediate mode).
+    */
+    void SortRenderGroup(unsigned index);
+    /*
+        Removes actors from the target render group whose sprites are all outside the visible area of the matching batch
+        (its viewport, through its transform if transformed). Actors without textured sprites, or with strings, are always kept.
+        Modules bound to a transform read it first (see Module_Interface::ReadWorldTransform), so they're culled where they draw.
+        Called by DrawBatch, so only needed directly for custom rendering.
+    */
+    void CullRenderGroup(unsigned index);
 
     /*
         Starts/ends render cycle for the target batch and matching render group.
@@ -89,6 +142,13 @@ public:
     //Clears all render groups of currently held actors (should be called post render)
     void ClearRenderGroups();
 
+    //Counts textures used by sprite modules of actors in target render group
+    RenderGroupTextureStats GetRenderGroupTextureStats(unsigned index);
+    //Estimates pixels shaded by sprite modules of actors in target render group
+    RenderGroupOverdrawStats GetRenderGroupOverdrawStats(unsigned index);
+    //Enables a one time report (via debug output) of each render groups texture, overdraw and cull stats, on the next draw of each group
+    void RequestRenderGroupReport();
+
     //
     //Supports
     //
@@ -121,6 +181,10 @@ public:
 
     DirectX::GraphicsMemory* GetGraphicsMemory() { return m_GraphicsMemory.get(); }
     DirectX::CommonStates* GetCommonStates() { return m_CommonStates.get(); }
+
+    //Culling of render groups (enabled by default)
+    void SetCullingEnabled(bool enabled) { m_CullingEnabled = enabled; }
+    bool IsCullingEnabled() { return m_CullingEnabled; }
     
     //
     //Accessors via index
@@ -131,6 +195,7 @@ public:
     W_SpriteBatch* GetSpritebatch(unsigned index);
     std::vector<Actor2D_Interface*>& GetRenderGroup(unsigned index);
     DirectX::SpriteFont* GetSpritefont(unsigned index);
+    const RenderGroupCullStats& GetRenderGroupCullStats(unsigned index);
 
     //
     //Container accessors
@@ -145,6 +210,12 @@ private:
     /// Operations ///
     //////////////////
 
+    //Calls the function with the SpriteData of each (textured) sprite module in the render group
+    template<class Func>
+    void ForEachSpriteInGroup(unsigned index, Func func);
+
+    //Builds the sort key of an actor in a render group
+    uint64_t BuildSortKey(unsigned index, Actor2D_Interface* actor, uint32_t order);
 
     ////////////
     /// Data ///
@@ -168,6 +239,17 @@ private:
         cleared after being rendered.
     */
     std::vector<std::vector<Actor2D_Interface*>> m_RenderGroups;
+    //Sort keys of the render group being sorted, and scratch space for sorting
+    std::vector<RenderSortKey::Entry> m_SortKeys;
+    std::vector<RenderSortKey::Entry> m_SortScratch;
+    std::vector<Actor2D_Interface*> m_SortedActors;
+    //Sprite bounds of the group being culled, with the first bound of each actor (plus one past the last)
+    ViewportCuller m_Culler;
+    std::vector<uint32_t> m_ActorBounds;
+    std::vector<RenderGroupCullStats> m_CullStats;
+    bool m_CullingEnabled = true;
+    //Tracks which render groups still need to report their stats (see RequestRenderGroupReport)
+    std::vector<bool> m_PendingReports;
 
     //
     //Other Resources
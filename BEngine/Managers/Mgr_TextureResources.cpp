@@ -8,6 +8,154 @@
 #include "Utils/Utils_D3D_Debug.h"
 #include "Utils/Utils_RapidJSON.h"
 
+#include "IO/AssetPack.h"			//Packed asset files
+#include "IO/SpriteMetaFile.h"		//Baked frame/animation data
+#include "IO/TextureLoadPipeline.h"	//Staged manifest loading
+#include "Rendering/GlyphLayoutCache.h"	//Font layout invalidation
+
+#include <cmath>
+#include <algorithm>
+#include <deque>
+#include <future>
+#include <chrono>
+#include <filesystem>
+
+/*
+	Animators hold a frame of their current animation (the texture frame for linear animations, an index into the frame
+	list for non-linear ones), so a replacement must keep every frame the old animation could be on valid.
+*/
+static bool IsCompatibleAnimation(const AnimationData& current, const AnimationData& replacement)
+{
+	if (current.m_TypeID != replacement.m_TypeID || replacement.GetFrameCount() < current.GetFrameCount())
+		return false;
+	return current.m_TypeID != AnimationData::AnimID::LINEAR_FRAMES || replacement.m_StartFrame == current.m_StartFrame;
+}
+
+//Creates pipeline textures in the target heap through LoadTexture (from the file data the pipeline read)
+class Mgr_TextureResources::DeviceTextureCreator : public TextureLoadPipeline::TextureCreator
+{
+public:
+	DeviceTextureCreator(Mgr_TextureResources& mgr, SRVData& srvData, ID3D12Device* d3dDevice, DirectX::ResourceUploadBatch& resourceUpload)
+		:m_Mgr(mgr), m_SRVData(srvData), m_Device(d3dDevice), m_ResourceUpload(resourceUpload)
+	{}
+
+	bool CreateTexture(const TextureLoadPipeline::TextureFile& file, SpriteTexture& outTex) override
+	{
+		return m_Mgr.LoadTexture(outTex, m_SRVData, StringtoWString(file.m_Filepath), m_Device, m_ResourceUpload, file.m_Data, file.m_Size);
+	}
+
+private:
+	Mgr_TextureResources& m_Mgr;
+	SRVData& m_SRVData;
+	ID3D12Device* m_Device;
+	DirectX::ResourceUploadBatch& m_ResourceUpload;
+};
+
+//Creates streamed textures in the target heap through LoadTexture, uploading each submits textures in its own batch
+class Mgr_TextureResources::DeviceUploadBackend : public TextureStreamer::UploadBackend
+{
+public:
+	DeviceUploadBackend(Mgr_TextureResources& mgr, unsigned heapIndex, ID3D12Device* d3dDevice, ID3D12CommandQueue* commandQueue)
+		:m_Mgr(mgr), m_HeapIndex(heapIndex), m_Device(d3dDevice), m_CommandQueue(commandQueue), m_ResourceUpload(d3dDevice)
+	{}
+
+	bool CreateTexture(const TextureLoadPipeline::TextureFile& file, SpriteTexture& outTex) override
+	{
+		if (!m_Begun)
+		{
+			m_ResourceUpload.Begin();
+			m_Begun = true;
+		}
+		return m_Mgr.LoadTexture(outTex, m_Mgr.m_SRVHeaps[m_HeapIndex], StringtoWString(file.m_Filepath), m_Device, m_ResourceUpload, file.m_Data, file.m_Size);
+	}
+
+	uint64_t Submit() override
+	{
+		++m_Submits;
+		if (m_Begun)
+		{
+			m_Pending.push_back(std::make_pair(m_Submits, m_ResourceUpload.End(m_CommandQueue)));
+			m_Begun = false;
+		}
+		return m_Submits;
+	}
+
+	bool IsComplete(uint64_t ticket) override
+	{
+		//Batches complete in submission order
+		while (!m_Pending.empty() && m_Pending.front().second.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+		{
+			m_Pending.front().second.get();
+			m_Pending.pop_front();
+		}
+		return m_Pending.empty() || m_Pending.front().first > ticket;
+	}
+
+	bool LoadMetaData(const TextureLoadPipeline::Entry& entry, SpriteTexture& outTex) override
+	{
+		return TextureLoadPipeline::LoadMetaData(entry, outTex);
+	}
+
+	void SwapIn(SpriteTexture& live, SpriteTexture& loaded, bool resourceOnly) override
+	{
+		//Live texture keeps its name and ID (sprites and lookups hold onto both)
+		live.m_TextureResource = std::move(loaded.m_TextureResource);
+		live.m_Heap = loaded.m_Heap;
+		live.m_HeapIndex = loaded.m_HeapIndex;
+		live.m_TexSize = loaded.m_TexSize;
+		if (resourceOnly)
+			return;
+
+		//Views stay valid when moving their storage (vector buffers move with them)
+		live.m_FrameStorage = std::move(loaded.m_FrameStorage);
+		live.m_HullVertexStorage = std::move(loaded.m_HullVertexStorage);
+		live.m_Frames = loaded.m_Frames;
+		live.m_HullVertices = loaded.m_HullVertices;
+		live.m_MetaFile = std::move(loaded.m_MetaFile);
+		live.m_Animations = std::move(loaded.m_Animations);
+	}
+
+private:
+	Mgr_TextureResources& m_Mgr;
+	unsigned m_HeapIndex;
+	ID3D12Device* m_Device;
+	ID3D12CommandQueue* m_CommandQueue;
+	DirectX::ResourceUploadBatch m_ResourceUpload;
+	bool m_Begun = false;
+	uint64_t m_Submits = 0;
+	//Submitted batches (ticket, completion)
+	std::deque<std::pair<uint64_t, std::future<void>>> m_Pending;
+};
+
+//Evicts textures by releasing their file and swapping in the streamers placeholder, reloading them through the streamer
+class Mgr_TextureResources::StreamingResidencyLoader : public TextureResidencyCache::Loader
+{
+public:
+	StreamingResidencyLoader(Mgr_TextureResources& mgr)
+		:m_Mgr(mgr)
+	{}
+
+	void Evict(SpriteTexture& texture) override
+	{
+		//Released while the texture still holds its own resource
+		m_Mgr.ReleaseTextureFile(texture);
+		m_Mgr.m_Streamer->Evict(texture);
+	}
+
+	void Reload(const TextureLoadPipeline::Entry& entry, SpriteTexture& texture) override
+	{
+		m_Mgr.m_Streamer->Reload(entry, texture);
+	}
+
+	TextureStreamer::State GetState(const SpriteTexture& texture) override
+	{
+		return m_Mgr.m_Streamer->GetState(&texture);
+	}
+
+private:
+	Mgr_TextureResources& m_Mgr;
+};
+
 Mgr_TextureResources::Mgr_TextureResources()
 {
 	//Reserve safe amount of space for SRVs
@@ -16,8 +164,14 @@ Mgr_TextureResources::Mgr_TextureResources()
 
 Mgr_TextureResources::~Mgr_TextureResources()
 {
-	//Clear map
-	m_SprTexResources.clear();
+	//Stop residency and streaming before releasing what they work on
+	m_Residency.reset();
+	m_ResidencyLoader.reset();
+	m_Streamer.reset();
+	//Clear textures and maps
+	m_Textures.clear();
+	m_TextureIDs.clear();
+	m_LoadedTextureFiles.clear();
 	//Release heaps
 	m_SRVHeaps.clear();
 }
@@ -26,59 +180,26 @@ bool Mgr_TextureResources::LoadTexturesFromManifest(std::string& manifestFP, uns
 {
 	msg_assert(targetHeapIndex < m_SRVHeaps.size(), "LoadTexturesFromManifest(): Heap Index OOR!");
 
-	//Load manifest document
-	rapidjson::Document manifestDoc;
-	ParseNewJSONDocument(manifestDoc, manifestFP);
-
 	//Get target heap data for this manifest
 	SRVData& srvData = m_SRVHeaps[targetHeapIndex];
 
-	//Get the texture array at target manifest index
-	rapidjson::Value& tArr = manifestDoc["Manifests"][manifestIndex]["Textures"].GetArray();
-
-	//Cycle through the array, loading its texture and associated resources
-	for (unsigned i(0); i < tArr.Size(); ++i)
-	{
-		//Create new SpriteTexture resource to load data into
-		std::unique_ptr<SpriteTexture> newST = std::make_unique<SpriteTexture>();
-
-		//Get resource data
-		newST->m_Name = tArr[i]["Texture_Name"].GetString();
-
-		//Get texture filepath and attempt to load
-		std::wstring texFP = StringtoWString(tArr[i]["Texture_Filepath"].GetString());
-		if (!(LoadTexture(newST, srvData, texFP, d3dDevice, resourceUpload)))
-		{
-			//Failed to load
-			newST.release();
-			return false;
-		}
-		//Get frames filepath and attempt to load
-		std::string fp = tArr[i]["Frames_Filepath"].GetString();
-		if (!(LoadFrameData(newST, fp)))
-		{
-			//Failed to load
-			newST.release();
-			return false;
-		}
-		//If animation filepath found, attempt to load from it
-		if (tArr[i].HasMember("Animations_Filepath"))
-		{
-			fp = tArr[i]["Animations_Filepath"].GetString();
-			if (!(LoadAnimationData(newST, fp)))
-			{
-				//Failed to load
-				newST.release();
-				return false;
-			}
-		}
+	//Read manifest, then read and parse every entries files across worker threads
+	std::vector<TextureLoadPipeline::Entry> entries;
+	if (!TextureLoadPipeline::ReadManifest(manifestFP, manifestIndex, entries))
+		return false;
+	RecordManifest(manifestFP, manifestIndex);
+	TextureLoadPipeline pipeline;
+	bool result = pipeline.LoadFiles(entries);
 
-		//All loading stages done, load into resource map
-		m_SprTexResources[newST->m_Name] = std::move(newST);
-	}
+	//Create resources and SRVs in manifest order (stopping at the first failure), then store
+	DeviceTextureCreator creator(*this, srvData, d3dDevice, resourceUpload);
+	std::vector<std::unique_ptr<SpriteTexture>> textures;
+	result = pipeline.CreateTextures(creator, textures) && result;
+	for (size_t i = 0; i < textures.size(); ++i)
+		StoreTexture(std::move(textures[i]), entries[i]);
 
 	//Loading Done
-	return true;
+	return result;
 }
 
 bool Mgr_TextureResources::LoadSingleTexture(std::string& textureName, std::wstring& textureFP, std::string& framesFP, unsigned targetHeapIndex, ID3D12Device* d3dDevice, DirectX::ResourceUploadBatch& resourceUpload)
@@ -95,14 +216,14 @@ bool Mgr_TextureResources::LoadSingleTexture(std::string& textureName, std::wstr
 	newST->m_Name = textureName;
 
 	//Attempt to load from texture filepath
-	if (!(LoadTexture(newST, srvData, textureFP, d3dDevice, resourceUpload)))
+	if (!(LoadTexture(*newST, srvData, textureFP, d3dDevice, resourceUpload)))
 	{
 		//Failed to load
 		newST.release();
 		return false;
 	}
 	//Attempt to load from frame filepath
-	if (!(LoadFrameData(newST, framesFP)))
+	if (!(LoadMetaData(*newST, framesFP, nullptr)))
 	{
 		//Failed to load
 		newST.release();
@@ -110,7 +231,11 @@ bool Mgr_TextureResources::LoadSingleTexture(std::string& textureName, std::wstr
 	}
 
 	//All loading stages done, load into resource map
-	m_SprTexResources[newST->m_Name] = std::move(newST);
+	TextureLoadPipeline::Entry source;
+	source.m_Name = textureName;
+	source.m_TextureFP = WStringToString(textureFP);
+	source.m_FramesFP = framesFP;
+	StoreTexture(std::move(newST), source);
 
 	//Loading Done
 	return true;
@@ -130,33 +255,251 @@ bool Mgr_TextureResources::LoadSingleTexture(std::string& textureName, std::wstr
 	newST->m_Name = textureName;
 
 	//Attempt to load from texture filepath
-	if (!(LoadTexture(newST, srvData, textureFP, d3dDevice, resourceUpload)))
+	if (!(LoadTexture(*newST, srvData, textureFP, d3dDevice, resourceUpload)))
 	{
 		//Failed to load
 		newST.release();
 		return false;
 	}
-	//Attempt to load from frame filepath
-	if (!(LoadFrameData(newST, framesFP)))
+	//Attempt to load from frame and animation filepaths
+	if (!(LoadMetaData(*newST, framesFP, &animsFP)))
 	{
 		//Failed to load
 		newST.release();
 		return false;
 	}
-	if (!(LoadAnimationData(newST, animsFP)))
+
+	//All loading stages done, load into resource map
+	TextureLoadPipeline::Entry source;
+	source.m_Name = textureName;
+	source.m_TextureFP = WStringToString(textureFP);
+	source.m_FramesFP = framesFP;
+	source.m_AnimationsFP = animsFP;
+	StoreTexture(std::move(newST), source);
+
+	//Loading Done
+	return true;
+}
+
+bool Mgr_TextureResources::EnableStreaming(std::unique_ptr<TextureStreamer::UploadBackend> backend, std::string& placeholderTexName, unsigned placeholderFrame)
+{
+	SpriteTexture* placeholder = FindTextureData(placeholderTexName);
+	if (!placeholder)
 	{
-		//Failed to load
-		newST.release();
+		msg_assert(false, "EnableStreaming(): Placeholder texture not found!");
 		return false;
 	}
 
-	//All loading stages done, load into resource map
-	m_SprTexResources[newST->m_Name] = std::move(newST);
+	m_Streamer = std::make_unique<TextureStreamer>(std::move(backend));
+	m_Streamer->SetPlaceholder(*placeholder, placeholderFrame);
+	m_PlaceholderID = placeholder->m_ID;
+	return true;
+}
 
-	//Loading Done
+std::unique_ptr<TextureStreamer::UploadBackend> Mgr_TextureResources::CreateDeviceUploadBackend(unsigned targetHeapIndex, ID3D12Device* d3dDevice, ID3D12CommandQueue* commandQueue)
+{
+	msg_assert(targetHeapIndex < m_SRVHeaps.size(), "CreateDeviceUploadBackend(): Heap Index OOR!");
+	return std::make_unique<DeviceUploadBackend>(*this, targetHeapIndex, d3dDevice, commandQueue);
+}
+
+SpriteTexture* Mgr_TextureResources::RequestTexture(std::string& textureName, std::string& textureFP, std::string& framesFP, std::string& animsFP)
+{
+	msg_assert(m_Streamer != nullptr, "RequestTexture(): Streaming not enabled!");
+
+	//Already loaded or requested
+	if (SpriteTexture* existing = FindTextureData(textureName))
+		return existing;
+
+	TextureLoadPipeline::Entry entry;
+	entry.m_Name = textureName;
+	entry.m_TextureFP = textureFP;
+	entry.m_FramesFP = framesFP;
+	entry.m_AnimationsFP = animsFP;
+
+	//Requested before storing, so it is stored (and tracked) as loading. Streamer fills it in place.
+	std::unique_ptr<SpriteTexture> newST = std::make_unique<SpriteTexture>();
+	m_Streamer->Request(entry, *newST);
+	return StoreTexture(std::move(newST), entry);
+}
+
+bool Mgr_TextureResources::RequestTexturesFromManifest(std::string& manifestFP, unsigned manifestIndex)
+{
+	std::vector<TextureLoadPipeline::Entry> entries;
+	if (!TextureLoadPipeline::ReadManifest(manifestFP, manifestIndex, entries))
+		return false;
+	RecordManifest(manifestFP, manifestIndex);
+
+	for (auto& entry : entries)
+		RequestTexture(entry.m_Name, entry.m_TextureFP, entry.m_FramesFP, entry.m_AnimationsFP);
+
+	return true;
+}
+
+void Mgr_TextureResources::UpdateStreaming()
+{
+	//Residency first, so reloads it starts can begin uploading this frame
+	if (m_Residency)
+		m_Residency->Update();
+	if (m_Streamer)
+		m_Streamer->Update();
+}
+
+bool Mgr_TextureResources::EnableResidency(const TextureResidencyCache::Settings& settings)
+{
+	if (!m_Streamer)
+	{
+		msg_assert(false, "EnableResidency(): Streaming not enabled!");
+		return false;
+	}
+
+	m_ResidencyLoader = std::make_unique<StreamingResidencyLoader>(*this);
+	m_Residency = std::make_unique<TextureResidencyCache>(*m_ResidencyLoader);
+	m_Residency->SetSettings(settings);
+
+	//Track every texture loaded from file so far (placeholder pinned, as everything evicted draws with it)
+	for (SpriteTexture::TextureID id(0); id < m_Textures.size(); ++id)
+	{
+		if (m_Textures[id] && !m_TextureSources[id].m_TextureFP.empty())
+			m_Residency->Track(*m_Textures[id], m_TextureSources[id], id == m_PlaceholderID);
+	}
+
+	return true;
+}
+
+void Mgr_TextureResources::EnableHotReload(FileWatcher& watcher)
+{
+	m_HotReload = &watcher;
+
+	//Textures loaded from file so far
+	for (SpriteTexture::TextureID id(0); id < m_Textures.size(); ++id)
+	{
+		if (m_Textures[id])
+			WatchTextureFiles(id);
+	}
+
+	//Manifests loaded so far (once per file, reloading every index loaded from it)
+	std::vector<std::string> watched;
+	for (auto& manifest : m_Manifests)
+	{
+		if (std::find(watched.begin(), watched.end(), manifest.first) != watched.end())
+			continue;
+		watched.push_back(manifest.first);
+		m_HotReload->Watch(manifest.first, [this](const std::string& fp) { ReloadManifest(fp); });
+	}
+}
+
+bool Mgr_TextureResources::ReloadMetaData(SpriteTexture::TextureID texID)
+{
+	SpriteTexture* tex = GetTexture(texID);
+	if (!tex)
+	{
+		msg_assert(false, "ReloadMetaData(): No texture found!");
+		return false;
+	}
+
+	//Streaming (and evicted) textures have their frames swapped in later, so leave them be
+	TextureStreamer::State state = m_Streamer ? m_Streamer->GetState(tex) : TextureStreamer::State::NONE;
+	if (state != TextureStreamer::State::NONE && state != TextureStreamer::State::RESIDENT)
+	{
+		DBOUT("ReloadMetaData(): Texture is streaming or evicted, skipping: " << tex->m_Name);
+		return false;
+	}
+
+	//Load into a scratch texture, so the live one is only touched once everything has loaded
+	TextureLoadPipeline::Entry source = m_TextureSources[texID];
+	SpriteTexture loaded;
+	loaded.m_TexSize = tex->m_TexSize;
+	if (!LoadFrameData(loaded, source.m_FramesFP))
+		return false;
+	if (!source.m_AnimationsFP.empty() && !LoadAnimationData(loaded, source.m_AnimationsFP))
+		return false;
+
+	if (loaded.m_Frames.size() < tex->m_Frames.size())
+	{
+		DBOUT("ReloadMetaData(): Frames were removed (sprites may still use them), skipping: " << tex->m_Name);
+		return false;
+	}
+
+	//Frames are indexed by sprites, so the views can be swapped (storage buffers move with the vectors)
+	tex->m_FrameStorage = std::move(loaded.m_FrameStorage);
+	tex->m_HullVertexStorage = std::move(loaded.m_HullVertexStorage);
+	tex->m_Frames = loaded.m_Frames;
+	tex->m_HullVertices = loaded.m_HullVertices;
+	tex->m_MetaFile.reset();
+
+	//Animators point at animations, so they are overwritten in place (as long as every animation stays compatible)
+	if (loaded.m_Animations.size() != tex->m_Animations.size())
+		DBOUT("ReloadMetaData(): Animation count changed (needs a restart), keeping old animations: " << tex->m_Name);
+	else
+	{
+		bool compatible = true;
+		for (size_t i = 0; i < tex->m_Animations.size() && compatible; ++i)
+		{
+			if (!IsCompatibleAnimation(tex->m_Animations[i], loaded.m_Animations[i]))
+			{
+				DBOUT("ReloadMetaData(): Animation shrunk, moved or changed type (animators may be on removed frames), keeping old animations: "
+					<< tex->m_Name << ", " << tex->m_Animations[i].m_Name);
+				compatible = false;
+			}
+		}
+
+		for (size_t i = 0; i < tex->m_Animations.size() && compatible; ++i)
+			tex->m_Animations[i] = std::move(loaded.m_Animations[i]);
+	}
+
+	DBOUT("ReloadMetaData(): Reloaded " << tex->m_Name << " (" << tex->m_Frames.size() << " frames, " << tex->m_Animations.size() << " animations)");
 	return true;
 }
 
+bool Mgr_TextureResources::ReloadManifest(const std::string& manifestFP)
+{
+	bool result = true;
+	for (size_t i = 0; i < m_Manifests.size(); ++i)
+	{
+		if (m_Manifests[i].first != manifestFP)
+			continue;
+
+		std::vector<TextureLoadPipeline::Entry> entries;
+		if (!TextureLoadPipeline::ReadManifest(manifestFP, m_Manifests[i].second, entries))
+		{
+			result = false;
+			continue;
+		}
+
+		for (auto& entry : entries)
+		{
+			//New textures can only be loaded between frames by streaming them in
+			SpriteTexture::TextureID id = FindTextureID(entry.m_Name);
+			if (!GetTexture(id))
+			{
+				if (m_Streamer)
+					RequestTexture(entry.m_Name, entry.m_TextureFP, entry.m_FramesFP, entry.m_AnimationsFP);
+				else
+					DBOUT("ReloadManifest(): New texture needs streaming enabled to load, skipping: " << entry.m_Name);
+				continue;
+			}
+
+			TextureLoadPipeline::Entry& source = m_TextureSources[id];
+			if (entry.m_TextureFP != source.m_TextureFP)
+				DBOUT("ReloadManifest(): Texture file changed (needs a restart), keeping old file: " << entry.m_Name);
+
+			//Leave unchanged entries alone
+			if (entry.m_FramesFP == source.m_FramesFP && entry.m_AnimationsFP == source.m_AnimationsFP)
+				continue;
+
+			source.m_FramesFP = entry.m_FramesFP;
+			source.m_AnimationsFP = entry.m_AnimationsFP;
+			if (m_Residency)
+				m_Residency->Track(*m_Textures[id], source, id == m_PlaceholderID);
+			if (m_HotReload)
+				WatchTextureFiles(id);
+			result = ReloadMetaData(id) && result;
+		}
+	}
+
+	return result;
+}
+
 std::unique_ptr<DirectX::SpriteFont> Mgr_TextureResources::CreateNewFont(std::wstring& fontFP, unsigned targetHeapIndex, ID3D12Device* d3dDevice, DirectX::ResourceUploadBatch& resourceUpload)
 {
 	msg_assert(targetHeapIndex < m_SRVHeaps.size(), "LoadFontTexture(): Heap Index OOR!");
@@ -165,38 +508,221 @@ std::unique_ptr<DirectX::SpriteFont> Mgr_TextureResources::CreateNewFont(std::ws
 	SRVData& data = m_SRVHeaps[targetHeapIndex];
 
 	//If no SRV space left, return nullptr
-	if (data.m_Count >= data.m_ResourceDescriptors->Count() - 1)
+	unsigned slot = data.m_Allocator.Allocate();
+	if (slot == DescriptorAllocator::INVALID_INDEX)
 	{
 		msg_assert(false, "CreateNewFont(): Not enough descriptor space left in target heap!");
 		return nullptr;
 	}
 
-	//Pre-increment count and fix in the return code
-	++data.m_Count;
+	//Create from a mounted asset pack in place if it has the font
+	AssetPack::View packed;
+	if (AssetPack::FindMounted(WStringToString(fontFP), packed))
+	{
+		return std::make_unique<DirectX::SpriteFont>(
+			d3dDevice,
+			resourceUpload,
+			packed.m_Data,
+			packed.m_Size,
+			data.m_ResourceDescriptors->GetCpuHandle(slot),
+			data.m_ResourceDescriptors->GetGpuHandle(slot)
+		);
+	}
+
 	//Create and return completed resource
 	return std::make_unique<DirectX::SpriteFont>(
 		d3dDevice,
 		resourceUpload,
 		fontFP.c_str(),
-		data.m_ResourceDescriptors->GetCpuHandle(data.m_Count-1), //Re-align count
-		data.m_ResourceDescriptors->GetGpuHandle(data.m_Count-1)  //Re-align count
+		data.m_ResourceDescriptors->GetCpuHandle(slot),
+		data.m_ResourceDescriptors->GetGpuHandle(slot)
 	);
 }
 
+bool Mgr_TextureResources::UnloadTexture(SpriteTexture::TextureID texID)
+{
+	SpriteTexture* tex = GetTexture(texID);
+	if (!tex)
+	{
+		msg_assert(false, "UnloadTexture(): No texture found!");
+		return false;
+	}
+
+	//Streamed textures can only go once settled
+	TextureStreamer::State state = m_Streamer ? m_Streamer->GetState(tex) : TextureStreamer::State::NONE;
+	if (state != TextureStreamer::State::NONE && state != TextureStreamer::State::RESIDENT && state != TextureStreamer::State::FAILED)
+	{
+		msg_assert(false, "UnloadTexture(): Texture is still streaming!");
+		return false;
+	}
+
+	ReleaseTextureFile(*tex);
+	UnwatchTextureFiles(texID);
+	if (m_Residency)
+		m_Residency->Untrack(tex);
+	if (m_Streamer)
+		m_Streamer->Forget(tex);
+	m_Textures[texID].reset();
+	return true;
+}
+
+bool Mgr_TextureResources::ReleaseFont(const DirectX::SpriteFont& font, unsigned heapIndex)
+{
+	msg_assert(heapIndex < m_SRVHeaps.size(), "ReleaseFont(): Heap Index OOR!");
+
+	//Drop cached layouts, as another font may take its address
+	GlyphLayoutCache::GetShared().InvalidateFont(&font);
+
+	//Work back to the slot from the fonts descriptor
+	DirectX::DescriptorHeap& heap = *m_SRVHeaps[heapIndex].m_ResourceDescriptors;
+	UINT64 offset = font.GetSpriteSheet().ptr - heap.GetFirstGpuHandle().ptr;
+	return m_SRVHeaps[heapIndex].m_Allocator.Free(static_cast<unsigned>(offset / heap.Increment()));
+}
+
 const Mgr_TextureResources::SRVData& Mgr_TextureResources::GetHeapAtIndex(unsigned index)
 {
 	msg_assert(index < m_SRVHeaps.size(), "GetResourceHeap(): Heap Index OOR!");
 	return m_SRVHeaps[index];
 }
 
+DescriptorAllocator::Report Mgr_TextureResources::GetHeapReport(unsigned index)
+{
+	msg_assert(index < m_SRVHeaps.size(), "GetHeapReport(): Heap Index OOR!");
+	return m_SRVHeaps[index].m_Allocator.BuildReport();
+}
+
+void Mgr_TextureResources::LogHeapReports()
+{
+	for (unsigned i(0); i < m_SRVHeaps.size(); ++i)
+	{
+		DescriptorAllocator::Report report = GetHeapReport(i);
+		DBOUT("Heap " << i << ": " << report.m_UsedSlots << "/" << report.m_Capacity << " slots used (high water "
+			<< report.m_HighWaterMark << ") in " << report.m_LiveAllocations << " allocations, " << report.m_FreeRanges
+			<< " free ranges (largest " << report.m_LargestFreeRange << ", fragmentation " << report.m_Fragmentation * 100.f
+			<< "%), compacting would move " << report.m_SlotsToMove << " slots in " << report.m_MovesToCompact << " moves, "
+			<< report.m_FailedAllocations << " failed allocations");
+	}
+}
+
+SpriteTexture::TextureID Mgr_TextureResources::FindTextureID(const std::string& texName)
+{
+	TextureIDMap::iterator it = m_TextureIDs.find(texName);
+	if (it != m_TextureIDs.end())
+		return it->second;
+	else
+		return SpriteTexture::INVALID_ID;
+}
+
 SpriteTexture* Mgr_TextureResources::FindTextureData(std::string& texName)
 {
-	//Iterate through cotainer, and return texture if found, else return nullptr
-	TextureResourceMap::iterator it = m_SprTexResources.find(texName);
-	if (it != m_SprTexResources.end())
-		return it->second.get();
+	//Resolve name, and return texture if found, else return nullptr
+	return GetTexture(FindTextureID(texName));
+}
+
+SpriteTexture* Mgr_TextureResources::StoreTexture(std::unique_ptr<SpriteTexture> texture, const TextureLoadPipeline::Entry& source)
+{
+	//Reuse ID of any texture already stored with this name (so existing IDs now get the new texture)
+	auto result = m_TextureIDs.emplace(texture->m_Name, static_cast<SpriteTexture::TextureID>(m_Textures.size()));
+	SpriteTexture::TextureID id = result.first->second;
+	texture->m_ID = id;
+
+	if (result.second)
+	{
+		msg_assert(m_Textures.size() < SpriteTexture::INVALID_ID, "StoreTexture(): Out of texture IDs!");
+		m_Textures.push_back(std::move(texture));
+		m_TextureSources.push_back(source);
+	}
 	else
-		return nullptr;
+	{
+		//Release replaced textures file (after the new one took its reference, in case it is the same file)
+		if (m_Textures[id])
+		{
+			ReleaseTextureFile(*m_Textures[id]);
+			if (m_Residency)
+				m_Residency->Untrack(m_Textures[id].get());
+			if (m_Streamer)
+				m_Streamer->Forget(m_Textures[id].get());
+		}
+		m_Textures[id] = std::move(texture);
+		m_TextureSources[id] = source;
+	}
+
+	if (m_Residency)
+		m_Residency->Track(*m_Textures[id], source);
+	if (m_HotReload)
+		WatchTextureFiles(id);
+
+	return m_Textures[id].get();
+}
+
+void Mgr_TextureResources::ReleaseTextureFile(const SpriteTexture& texture)
+{
+	//Textures yet to stream in (or that failed to) only borrow the placeholders resource
+	if (m_Streamer)
+	{
+		TextureStreamer::State state = m_Streamer->GetState(&texture);
+		if (state != TextureStreamer::State::NONE && state != TextureStreamer::State::RESIDENT)
+			return;
+	}
+
+	//Find the file by its resource
+	for (auto it = m_LoadedTextureFiles.begin(); it != m_LoadedTextureFiles.end(); ++it)
+	{
+		LoadedTextureFile& file = it->second;
+		if (!texture.m_TextureResource || file.m_Resource != texture.m_TextureResource)
+			continue;
+
+		if (--file.m_RefCount == 0)
+		{
+			for (auto& srvData : m_SRVHeaps)
+			{
+				if (srvData.m_ResourceDescriptors.get() == file.m_Heap)
+					srvData.m_Allocator.Free(file.m_HeapIndex);
+			}
+			m_LoadedTextureFiles.erase(it);
+		}
+		return;
+	}
+}
+
+void Mgr_TextureResources::RecordManifest(const std::string& manifestFP, unsigned manifestIndex)
+{
+	std::pair<std::string, unsigned> manifest(manifestFP, manifestIndex);
+	if (std::find(m_Manifests.begin(), m_Manifests.end(), manifest) != m_Manifests.end())
+		return;
+
+	//Watch newly loaded manifest files
+	bool newFile = std::none_of(m_Manifests.begin(), m_Manifests.end(), [&manifestFP](const std::pair<std::string, unsigned>& recorded) { return recorded.first == manifestFP; });
+	m_Manifests.push_back(manifest);
+	if (m_HotReload && newFile)
+		m_HotReload->Watch(manifestFP, [this](const std::string& fp) { ReloadManifest(fp); });
+}
+
+void Mgr_TextureResources::WatchTextureFiles(SpriteTexture::TextureID texID)
+{
+	UnwatchTextureFiles(texID);
+
+	//Only textures loaded from file
+	const TextureLoadPipeline::Entry& source = m_TextureSources[texID];
+	if (!m_HotReload || source.m_FramesFP.empty())
+		return;
+
+	std::vector<FileWatcher::WatchID>& watches = m_TextureWatches[texID];
+	auto reload = [this, texID](const std::string&) { ReloadMetaData(texID); };
+	watches.push_back(m_HotReload->Watch(source.m_FramesFP, reload));
+	if (!source.m_AnimationsFP.empty())
+		watches.push_back(m_HotReload->Watch(source.m_AnimationsFP, reload));
+}
+
+void Mgr_TextureResources::UnwatchTextureFiles(SpriteTexture::TextureID texID)
+{
+	auto it = m_TextureWatches.find(texID);
+	if (it == m_TextureWatches.end())
+		return;
+
+	for (FileWatcher::WatchID watch : it->second)
+		m_HotReload->Unwatch(watch);
+	m_TextureWatches.erase(it);
 }
 
 bool Mgr_TextureResources::CreateNewHeap(ID3D12Device* d3dDevice, D3D12_DESCRIPTOR_HEAP_TYPE heapType, D3D12_DESCRIPTOR_HEAP_FLAGS flags, unsigned heapSize)
@@ -212,73 +738,195 @@ bool Mgr_TextureResources::CreateNewHeap(ID3D12Device* d3dDevice, D3D12_DESCRIPT
 		flags,
 		heapSize
 	);
+	m_SRVHeaps[index].m_Allocator.Reset(heapSize);
 
 	//Job done
 	return true;
 }
 
-bool Mgr_TextureResources::LoadTexture(std::unique_ptr<SpriteTexture>& data, SRVData& srvData, std::wstring& textureFP, ID3D12Device* d3dDevice, DirectX::ResourceUploadBatch& resourceUpload)
+bool Mgr_TextureResources::LoadTexture(SpriteTexture& data, SRVData& srvData, const std::wstring& textureFP, ID3D12Device* d3dDevice, DirectX::ResourceUploadBatch& resourceUpload,
+	const uint8_t* fileData, size_t fileSize)
 {
-	//Check if the maximum amount of descriptors as been hit before trying to insert a new resource
-	if (srvData.m_Count >= srvData.m_ResourceDescriptors->Count() - 1)
+	//If file is already loaded into this heap, share its resource and SRV
+	auto loaded = m_LoadedTextureFiles.find(textureFP);
+	if (loaded != m_LoadedTextureFiles.end() && loaded->second.m_Heap == srvData.m_ResourceDescriptors.get())
+	{
+		data.m_TextureResource = loaded->second.m_Resource;
+		data.m_Heap = loaded->second.m_Heap;
+		data.m_HeapIndex = loaded->second.m_HeapIndex;
+		data.m_TexSize = loaded->second.m_TexSize;
+		++loaded->second.m_RefCount;
+		return true;
+	}
+
+	//Allocate a slot for the SRV before trying to insert a new resource
+	unsigned slot = srvData.m_Allocator.Allocate();
+	if (slot == DescriptorAllocator::INVALID_INDEX)
 	{
 		//No space to dont try to create new resource
 		msg_assert(false, "LoadTextureFromFile(): Not enough descriptor space left in target heap!");
 		return false;
 	}
 
-	//Attempt to create texture resource from target file location
-	ThrowIfFailed(CreateDDSTextureFromFile(
-		d3dDevice,
-		resourceUpload,
-		static_cast<const wchar_t*>(textureFP.c_str()),
-		data->m_TextureResource.ReleaseAndGetAddressOf())
-	);
+	//Files in a mounted asset pack are created from the pack in place
+	AssetPack::View packed;
+	if (!fileData && AssetPack::FindMounted(WStringToString(textureFP), packed))
+	{
+		fileData = packed.m_Data;
+		fileSize = packed.m_Size;
+	}
+
+	if (fileData)
+	{
+		//Create texture resource from file data already read, and queue its upload (as CreateDDSTextureFromFile)
+		std::vector<D3D12_SUBRESOURCE_DATA> subresources;
+		ThrowIfFailed(LoadDDSTextureFromMemory(
+			d3dDevice,
+			fileData,
+			fileSize,
+			data.m_TextureResource.ReleaseAndGetAddressOf(),
+			subresources)
+		);
+		resourceUpload.Upload(data.m_TextureResource.Get(), 0, subresources.data(), static_cast<UINT>(subresources.size()));
+		resourceUpload.Transition(data.m_TextureResource.Get(), D3D12_RESOURCE_STATE_COPY_DEST, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+	}
+	else
+	{
+		//Attempt to create texture resource from target file location
+		ThrowIfFailed(CreateDDSTextureFromFile(
+			d3dDevice,
+			resourceUpload,
+			static_cast<const wchar_t*>(textureFP.c_str()),
+			data.m_TextureResource.ReleaseAndGetAddressOf())
+		);
+	}
 
 	//Attempt to create a new SRV entry at target heap and index
 	DirectX::CreateShaderResourceView(
 		d3dDevice,
-		data->m_TextureResource.Get(),
-		srvData.m_ResourceDescriptors->GetCpuHandle(srvData.m_Count)
+		data.m_TextureResource.Get(),
+		srvData.m_ResourceDescriptors->GetCpuHandle(slot)
 	);
 
+	//Store texture size (used for frame UVs, and by sprites when drawing)
+	data.m_TexSize = DirectX::GetTextureSize(data.m_TextureResource.Get());
+
 	//Store heap address
-	data->m_Heap = srvData.m_ResourceDescriptors.get();
-	//Store index of texture in the heap (post incrementing for next possible resource)
-	data->m_HeapIndex = (unsigned)srvData.m_Count++;
+	data.m_Heap = srvData.m_ResourceDescriptors.get();
+	//Store index of texture in the heap
+	data.m_HeapIndex = slot;
+
+	//Track file for any later entries using it
+	LoadedTextureFile& file = m_LoadedTextureFiles[textureFP];
+	file.m_Resource = data.m_TextureResource;
+	file.m_Heap = data.m_Heap;
+	file.m_HeapIndex = data.m_HeapIndex;
+	file.m_TexSize = data.m_TexSize;
+	file.m_RefCount = 1;
 
 	//Texture loaded into heap and updated
 	return true;
 }
 
-bool Mgr_TextureResources::LoadFrameData(std::unique_ptr<SpriteTexture>& data, std::string& framesFP)
+bool Mgr_TextureResources::LoadMetaData(SpriteTexture& data, std::string& framesFP, std::string* animFP)
+{
+	//Use baked metadata if there is one, and it isn't older than the files it was baked from
+	std::string bakedFP = SpriteMetaFile::GetBakedFilepath(framesFP);
+	std::error_code ec;
+	std::filesystem::file_time_type bakedTime = std::filesystem::last_write_time(bakedFP, ec);
+	if (!ec)
+	{
+		bool current = std::filesystem::last_write_time(framesFP, ec) <= bakedTime || ec;
+		if (animFP)
+			current = current && (std::filesystem::last_write_time(*animFP, ec) <= bakedTime || ec);
+
+		if (current && SpriteMetaFile::Load(bakedFP, data))
+			return true;
+	}
+
+	//Otherwise load from JSON
+	if (!LoadFrameData(data, framesFP))
+		return false;
+	if (animFP && !LoadAnimationData(data, *animFP))
+		return false;
+
+	return true;
+}
+
+bool Mgr_TextureResources::LoadFrameData(SpriteTexture& data, std::string& framesFP)
 {
 	//Parse file
 	rapidjson::Document doc;
-	ParseNewJSONDocument(doc, framesFP);
+	std::string error;
+	if (!ParseNewJSONDocument(doc, framesFP, &error))
+	{
+		DBOUT("LoadFrameData(): " << error);
+		return false;
+	}
+
+	if (doc["frames"].GetArray().Size() > SpriteTexture::MAX_FRAMES)
+	{
+		msg_assert(false, "LoadFrameData(): Too many frames for 16-bit frame indexes!");
+		return false;
+	}
+
+	//Texture size should be known by now, and is needed to normalise UVs
+	msg_assert(data.m_TexSize.x > 0 && data.m_TexSize.y > 0, "LoadFrameData(): Texture size not set!");
+	float invTexX = 1.f / static_cast<float>(data.m_TexSize.x);
+	float invTexY = 1.f / static_cast<float>(data.m_TexSize.y);
 
-	//Load individual frame data
-	data->m_Frames.reserve(doc["frames"].GetArray().Size());
+	//Load individual frame data, baking everything needed to draw each frame
+	data.m_FrameStorage.clear();
+	data.m_HullVertexStorage.clear();
+	data.m_FrameStorage.reserve(doc["frames"].GetArray().Size());
 	for (auto& a : doc["frames"].GetArray())
 	{
-		//Store new frame
-		RECT newFrame = {
+		SpriteFrame newFrame;
+
+		/*
+			Frame w/h are the (trimmed) size of the sprite upright. Rotated frames are stored 90 degrees clockwise
+			in the texture, so the rect in the texture has them swapped.
+		*/
+		float frameH = a["frame"]["h"].GetFloat();
+		newFrame.m_Rotated = a.HasMember("rotated") && a["rotated"].GetBool();
+
+		//Store frame rect
+		newFrame.m_Rect = {
 			a["frame"]["x"].GetInt(),
 			a["frame"]["y"].GetInt(),
-			a["frame"]["x"].GetInt() + a["frame"]["w"].GetInt(),
-			a["frame"]["y"].GetInt() + a["frame"]["h"].GetInt()
+			a["frame"]["x"].GetInt() + (newFrame.m_Rotated ? a["frame"]["h"].GetInt() : a["frame"]["w"].GetInt()),
+			a["frame"]["y"].GetInt() + (newFrame.m_Rotated ? a["frame"]["w"].GetInt() : a["frame"]["h"].GetInt())
 		};
-		data->m_Frames.push_back(newFrame);
 
-		DirectX::XMFLOAT2 origin;
+		//Size and normalised rect
+		newFrame.m_Size =
+		{
+			static_cast<float>(newFrame.m_Rect.right - newFrame.m_Rect.left),
+			static_cast<float>(newFrame.m_Rect.bottom - newFrame.m_Rect.top)
+		};
+		newFrame.m_UV =
+		{
+			static_cast<float>(newFrame.m_Rect.left) * invTexX,
+			static_cast<float>(newFrame.m_Rect.top) * invTexY,
+			static_cast<float>(newFrame.m_Rect.right) * invTexX,
+			static_cast<float>(newFrame.m_Rect.bottom) * invTexY
+		};
+
+		//Untrimmed size (falling back to sprite source size for older exports)
+		if (a.HasMember("sourceSize"))
+			newFrame.m_SourceSize = { a["sourceSize"]["w"].GetFloat(), a["sourceSize"]["h"].GetFloat() };
+		else
+			newFrame.m_SourceSize = { a["spriteSourceSize"]["w"].GetFloat(), a["spriteSourceSize"]["h"].GetFloat() };
+
 		//If pivoting enabled, store origin value adjusted by pivot
+		DirectX::XMFLOAT2 origin;
 		if (a.HasMember("pivot"))
 		{
 			//Store accociated origin
 			origin =
 			{
-				a["spriteSourceSize"]["w"].GetFloat() * a["pivot"]["x"].GetFloat(),
-				a["spriteSourceSize"]["h"].GetFloat() * a["pivot"]["y"].GetFloat()
+				newFrame.m_SourceSize.x * a["pivot"]["x"].GetFloat(),
+				newFrame.m_SourceSize.y * a["pivot"]["y"].GetFloat()
 			};
 		}
 		//Not pivot assigned, so do a safe adjustment to centre for origin data
@@ -286,26 +934,69 @@ bool Mgr_TextureResources::LoadFrameData(std::unique_ptr<SpriteTexture>& data, s
 		{
 			origin =
 			{
-				a["spriteSourceSize"]["w"].GetFloat() * 0.5f,
-				a["spriteSourceSize"]["h"].GetFloat() * 0.5f
+				newFrame.m_SourceSize.x * 0.5f,
+				newFrame.m_SourceSize.y * 0.5f
 			};
 		}
 
-		data->m_Origins.push_back(origin);
+		//Pivot is relative to the untrimmed sprite, so move it into the trimmed frame
+		if (a.HasMember("trimmed") && a["trimmed"].GetBool())
+		{
+			origin.x -= a["spriteSourceSize"]["x"].GetFloat();
+			origin.y -= a["spriteSourceSize"]["y"].GetFloat();
+		}
+
+		//Rotate origin to match frame in texture (upright (x, y) is at (h - y, x) in the texture)
+		if (newFrame.m_Rotated)
+			newFrame.m_Origin = { frameH - origin.y, origin.x };
+		else
+			newFrame.m_Origin = origin;
+
+		//Optional hull (flat x/y pairs in pixels, relative to the frame as packed)
+		if (a.HasMember("hull") && a["hull"].IsArray() && a["hull"].Size() >= 6)
+		{
+			const rapidjson::Value& hull = a["hull"];
+			newFrame.m_HullFirst = static_cast<uint32_t>(data.m_HullVertexStorage.size());
+			newFrame.m_HullCount = static_cast<uint16_t>(hull.Size() / 2);
+
+			float area = 0.f;
+			for (unsigned i(0); i < newFrame.m_HullCount; ++i)
+			{
+				DirectX::XMFLOAT2 v = { hull[i * 2].GetFloat() / newFrame.m_Size.x, hull[i * 2 + 1].GetFloat() / newFrame.m_Size.y };
+				data.m_HullVertexStorage.push_back(v);
+
+				//Shoelace area (normalised, so relative to the quad)
+				unsigned next = ((i + 1) % newFrame.m_HullCount) * 2;
+				area += v.x * (hull[next + 1].GetFloat() / newFrame.m_Size.y) - (hull[next].GetFloat() / newFrame.m_Size.x) * v.y;
+			}
+			newFrame.m_HullCoverage = std::fabs(area) * 0.5f;
+		}
+
+		data.m_FrameStorage.push_back(newFrame);
 	}
 
+	//Point views at the loaded frames
+	data.m_Frames = data.m_FrameStorage;
+	data.m_HullVertices = data.m_HullVertexStorage;
+	data.m_MetaFile.reset();
+
 	//Frames loaded
 	return true;
 }
 
-bool Mgr_TextureResources::LoadAnimationData(std::unique_ptr<SpriteTexture>& data, std::string& animFP)
+bool Mgr_TextureResources::LoadAnimationData(SpriteTexture& data, std::string& animFP)
 {
 	//Parse file
 	rapidjson::Document doc;
-	ParseNewJSONDocument(doc, animFP);
+	std::string error;
+	if (!ParseNewJSONDocument(doc, animFP, &error))
+	{
+		DBOUT("LoadAnimationData(): " << error);
+		return false;
+	}
 
 	//Reserve space of animations
-	data->m_Animations.reserve(doc["Animations"].GetArray().Size());
+	data.m_Animations.reserve(doc["Animations"].GetArray().Size());
 
 	//Linear animations are defined
 	unsigned frameCount = 0;
@@ -364,7 +1055,7 @@ bool Mgr_TextureResources::LoadAnimationData(std::unique_ptr<SpriteTexture>& dat
 
 		//Set internal index id and then store
 		newAnim.m_ContainerIndex = indexCount++;
-		data->m_Animations.push_back(newAnim);
+		data.m_Animations.push_back(newAnim);
 	}	
 
 	//Animations done loading
@@ -12,6 +12,10 @@
 #include "SpriteFont.h"
 
 #include "Types/BE_SharedTypes.h"		//SpriteTexture type
+#include "IO/TextureStreamer.h"			//Texture streaming
+#include "IO/TextureResidencyCache.h"		//Texture memory budget
+#include "IO/FileWatcher.h"				//Hot reloading
+#include "Rendering/DescriptorAllocator.h"	//Heap slot allocation
 
 class Mgr_TextureResources
 {
@@ -24,16 +28,30 @@ public:
 	static constexpr size_t HEAP_RESERVE = 8;
 	static constexpr size_t DEFAULT_SRV_SIZE = 256;
 
-	//Texture map typedef
-	typedef std::unordered_map<std::string, std::shared_ptr<SpriteTexture>> TextureResourceMap;
+	//Texture storage typedefs (textures indexed by ID, and IDs by name)
+	typedef std::vector<std::unique_ptr<SpriteTexture>> TextureArray;
+	typedef std::unordered_map<std::string, SpriteTexture::TextureID> TextureIDMap;
 	/*
-		Pairs descriptor heap and active tracking of the amount of bound resources together.
-		Tracking value allows for proper sequencing of resources automatically when loading resources.
+		Pairs descriptor heap and the allocator of its slots together. Slots are allocated automatically when loading
+		resources, and returned when unloading them (see UnloadTexture and ReleaseFont).
 	*/
 	struct SRVData
 	{
 		std::unique_ptr<DirectX::DescriptorHeap> m_ResourceDescriptors;
-		size_t m_Count = 0;
+		DescriptorAllocator m_Allocator;
+	};
+	/*
+		Texture file already loaded into a heap. Manifest entries pointing at the same file (e.g. textures packed into
+		the same atlas, see AtlasPacker) share the resource and SRV, so sprites using them can batch together.
+	*/
+	struct LoadedTextureFile
+	{
+		Microsoft::WRL::ComPtr<ID3D12Resource> m_Resource = nullptr;
+		DirectX::DescriptorHeap* m_Heap = nullptr;
+		unsigned m_HeapIndex = 0;
+		DirectX::XMUINT2 m_TexSize = { 0, 0 };
+		//Textures using the file (resource and slot released when none are left)
+		unsigned m_RefCount = 0;
 	};
 
 	////////////////////
@@ -54,6 +72,7 @@ public:
 	/*
 		Loads all texture indexes form a given manifest index in target manifest file. File must be standard engine format (See Texture_Manifest_Example.json).
 		Textures frame JSON must be produced/match TexturePacker output format, with Animation format following standard engine format (See Texture_Animation_Example.json).
+		Files are read and parsed on worker threads (see TextureLoadPipeline), with only resource creation done serially.
 	*/
 	bool LoadTexturesFromManifest(std::string& manifestFP, unsigned manifestIndex, unsigned targetHeapIndex, ID3D12Device* d3dDevice, DirectX::ResourceUploadBatch& resourceUpload);
 	//Loads and generates texture resource, and loads frame information. Uses JSON array file output from TexturePacker.
@@ -73,6 +92,19 @@ public:
 	*/
 
 
+	/*
+		Loads frame information about a texture from file (texture size must be set first, as UVs are baked from it).
+		Public so offline tools can load frame data without a device (see SpriteMetaBaker).
+	*/
+	static bool LoadFrameData(SpriteTexture& data, std::string& framesFP);
+	//Optional aspect of the loading process that loads any animation data relating to the frame data previously loaded
+	static bool LoadAnimationData(SpriteTexture& data, std::string& animFP);
+	/*
+		Loads frame and (optional) animation data, from baked metadata if present and up to date (see SpriteMetaFile),
+		falling back to the JSON files. Touches no manager state, so is safe to call from loading threads.
+	*/
+	static bool LoadMetaData(SpriteTexture& data, std::string& framesFP, std::string* animFP);
+
 	/*
 		Loading fonts works a little differently to regular textures (as it needs to be bound to font and heap at the same time), so use this call to bind a font
 		file to the target heap, returning a complete spritefont resource that should be held elsewhere (See Mgr_Graphics).
@@ -80,6 +112,74 @@ public:
 	*/
 	std::unique_ptr<DirectX::SpriteFont> CreateNewFont(std::wstring& fontFP, unsigned targetHeapIndex, ID3D12Device* d3dDevice, DirectX::ResourceUploadBatch& resourceUpload);
 
+	//
+	//Unloading
+	//
+
+	/*
+		Unloads a texture, returning its heap slot (and resource) once no other texture shares its file. The textures ID stays
+		reserved for its name. Only unload textures the GPU is done with (e.g. after waiting on it), as the slot can be reused.
+	*/
+	bool UnloadTexture(SpriteTexture::TextureID texID);
+	//Returns the heap slot of a font created with CreateNewFont (same GPU caveat as UnloadTexture), before the font is released
+	bool ReleaseFont(const DirectX::SpriteFont& font, unsigned heapIndex);
+
+	//
+	//Streaming
+	//
+
+	/*
+		Enables streaming (see TextureStreamer) through the given upload backend, with the given frame of a loaded texture
+		drawn in place of textures yet to stream in.
+	*/
+	bool EnableStreaming(std::unique_ptr<TextureStreamer::UploadBackend> backend, std::string& placeholderTexName, unsigned placeholderFrame = 0);
+	//Creates the D3D12 upload backend, creating streamed textures in the target heap and uploading them via the given queue
+	std::unique_ptr<TextureStreamer::UploadBackend> CreateDeviceUploadBackend(unsigned targetHeapIndex, ID3D12Device* d3dDevice, ID3D12CommandQueue* commandQueue);
+
+	/*
+		Requests a texture be streamed in, returning it straight away (drawing with the placeholder until resident, see
+		TextureStreamer::GetState). Returns the existing texture if already loaded or requested. Animations path optional.
+	*/
+	SpriteTexture* RequestTexture(std::string& textureName, std::string& textureFP, std::string& framesFP, std::string& animsFP);
+	//Requests every texture from a given manifest index in target manifest file (see LoadTexturesFromManifest)
+	bool RequestTexturesFromManifest(std::string& manifestFP, unsigned manifestIndex);
+
+	/*
+		Finalises streamed textures within the streaming budget, and keeps textures within the residency budget (if enabled).
+		Call once per frame, before drawing (does nothing if streaming isn't enabled).
+	*/
+	void UpdateStreaming();
+
+	/*
+		Enables the residency cache (see TextureResidencyCache), evicting least recently drawn textures when over budget and
+		streaming them back in when drawn again. Requires streaming. Tracks every texture loaded from file (but the placeholder).
+	*/
+	bool EnableResidency(const TextureResidencyCache::Settings& settings);
+
+	//
+	//Hot Reloading
+	//
+
+	/*
+		Enables hot reloading through the watcher (see FileWatcher), which must be updated between frames. Watches the frame
+		and animation files of every texture loaded from file (and any stored later), patching textures in place when they
+		change, and each manifest loaded so far (and later), reloading only the entries that changed. Only loose files are
+		watched, so files in a mounted AssetPack keep loading from the pack.
+	*/
+	void EnableHotReload(FileWatcher& watcher);
+	/*
+		Reloads a textures frame and animation data from its JSON, patching the texture in place (sprites and animators keep
+		their pointers into it). Frames can change or be added but not removed, as sprites index into them. Animations can
+		change but not be added, removed, shortened, or (for linear animations) have their start frame moved, as animators
+		hold frames within them (keeping the old animations if any of this happens). Streaming or evicted textures are skipped.
+	*/
+	bool ReloadMetaData(SpriteTexture::TextureID texID);
+	/*
+		Rereads the loaded indexes of a manifest, reloading textures whose frame or animation filepaths changed and requesting
+		new textures (if streaming is enabled). Texture file changes are reported but not applied (needs a restart).
+	*/
+	bool ReloadManifest(const std::string& manifestFP);
+
 	//
 	//Setup
 	//
@@ -94,30 +194,85 @@ public:
 
 	//Get SRV data at index
 	const SRVData& GetHeapAtIndex(unsigned index);
+	//Usage and fragmentation of heap at index (see DescriptorAllocator::Report)
+	DescriptorAllocator::Report GetHeapReport(unsigned index);
+	//Outputs every heaps report (via DBOUT)
+	void LogHeapReports();
+
+	/*
+		Resolves a texture name to its ID (INVALID_ID if not found). Resolve once up front, as IDs stay valid for the
+		managers lifetime (reloading a texture under the same name keeps its ID).
+	*/
+	SpriteTexture::TextureID FindTextureID(const std::string& texName);
+	//Gets texture by ID, a single array index (nullptr if invalid)
+	SpriteTexture* GetTexture(SpriteTexture::TextureID texID) { return texID < m_Textures.size() ? m_Textures[texID].get() : nullptr; }
+	//Number of stored textures (IDs are dense, from 0 to count)
+	size_t GetTextureCount() { return m_Textures.size(); }
 
-	//Searches for texture data and returns it found (nullptr if not)
+	//Searches for texture data by name and returns it found (nullptr if not). Hashes the name each call, so meant for setup and tooling.
 	SpriteTexture* FindTextureData(std::string& texName);
 
+	//Streamer (nullptr if streaming isn't enabled)
+	TextureStreamer* GetStreamer() { return m_Streamer.get(); }
+	//Residency cache (nullptr if not enabled)
+	TextureResidencyCache* GetResidencyCache() { return m_Residency.get(); }
+
 private:
 
 	//////////////////
 	/// Operations ///
 	//////////////////
 
-	//Attempts to load texture into given resource from file
-	bool LoadTexture(std::unique_ptr<SpriteTexture>& data, SRVData& srvData, std::wstring& textureFP, ID3D12Device* d3dDevice, DirectX::ResourceUploadBatch& resourceUpload);
-	//Attepts to load frame information about a texture from file
-	bool LoadFrameData(std::unique_ptr<SpriteTexture>& data, std::string& framesFP);
-	//Optional aspect of the loading process that loads any animation data relating to the frame data previously loaded
-	bool LoadAnimationData(std::unique_ptr<SpriteTexture>& data, std::string& animFP);
+	/*
+		Attempts to load texture into given resource from file (reusing the resource if the file is already loaded into the heap).
+		Creates from file data instead if given (already read, see TextureLoadPipeline), or if the file is in a mounted AssetPack.
+	*/
+	bool LoadTexture(SpriteTexture& data, SRVData& srvData, const std::wstring& textureFP, ID3D12Device* d3dDevice, DirectX::ResourceUploadBatch& resourceUpload,
+		const uint8_t* fileData = nullptr, size_t fileSize = 0);
+
+	//Stores texture, assigning it the next ID (or the existing ID of a texture with the same name, which it replaces), and where it came from
+	SpriteTexture* StoreTexture(std::unique_ptr<SpriteTexture> texture, const TextureLoadPipeline::Entry& source);
+	//Drops a textures reference to its file, freeing the files heap slot when it was the last user
+	void ReleaseTextureFile(const SpriteTexture& texture);
+
+	//Records a loaded manifest index (for hot reloading)
+	void RecordManifest(const std::string& manifestFP, unsigned manifestIndex);
+	//(Re)watches the frame and animation files of a texture (if hot reloading), or stops watching them
+	void WatchTextureFiles(SpriteTexture::TextureID texID);
+	void UnwatchTextureFiles(SpriteTexture::TextureID texID);
+
+	//Creates textures for TextureLoadPipeline through LoadTexture (defined in source)
+	class DeviceTextureCreator;
+	//Creates and uploads streamed textures through LoadTexture (defined in source)
+	class DeviceUploadBackend;
+	//Evicts and reloads textures for the residency cache through the streamer (defined in source)
+	class StreamingResidencyLoader;
 
 	////////////
 	/// Data ///
 	////////////
 
-	//Texture map
-	TextureResourceMap m_SprTexResources;
+	//Textures by ID, and name lookup into them
+	TextureArray m_Textures;
+	TextureIDMap m_TextureIDs;
+	//Files each texture was loaded from, by ID (for reloading)
+	std::vector<TextureLoadPipeline::Entry> m_TextureSources;
+	//Texture files loaded so far, by filepath
+	std::unordered_map<std::wstring, LoadedTextureFile> m_LoadedTextureFiles;
 
 	//Container of SRV Heaps
 	std::vector<SRVData> m_SRVHeaps;
+
+	//Streams requested textures in (if enabled), with the texture drawn in their place
+	std::unique_ptr<TextureStreamer> m_Streamer;
+	SpriteTexture::TextureID m_PlaceholderID = SpriteTexture::INVALID_ID;
+	//Keeps textures within budget (if enabled)
+	std::unique_ptr<TextureResidencyCache::Loader> m_ResidencyLoader;
+	std::unique_ptr<TextureResidencyCache> m_Residency;
+
+	//Watcher for hot reloading (if enabled, not owned), with the watches of each texture by ID
+	FileWatcher* m_HotReload = nullptr;
+	std::unordered_map<SpriteTexture::TextureID, std::vector<FileWatcher::WatchID>> m_TextureWatches;
+	//Manifest indexes loaded so far (filepath and index)
+	std::vector<std::pair<std::string, unsigned>> m_Manifests;
 };
\ No newline at end of file
@@ -4,18 +4,19 @@
 #include "Utils/Utils_Debug.h"
 #include "Utils/Utils_D3D_Debug.h"
 
-//Library Includes
-#include "DirectXHelpers.h"			//Get Texture Size
-
 //Engine Includes
 #include "Includes/BE_All_Managers.h"
+#include "Types/BE_Snapshot.h"
+
+#include <cmath>
+#include <utility>
 
 void SFString::Draw()
 {
 	msg_assert(m_Font && m_Batch, "Draw(): No font and/or batch set!");
-	m_Font->DrawString(
+	GlyphLayoutCache::Draw(
+		GetLayout(m_Font),
 		m_Batch,
-		m_DrawableStr.c_str(),
 		m_Position + m_PositionOffset,
 		m_Colour,
 		m_Rotation,
@@ -29,9 +30,9 @@ void SFString::Draw()
 void SFString::Draw(DirectX::SpriteBatch* batch)
 {
 	msg_assert(m_Font && batch, "Draw(): No font and/or batch set!");
-	m_Font->DrawString(
+	GlyphLayoutCache::Draw(
+		GetLayout(m_Font),
 		batch,
-		m_DrawableStr.c_str(),
 		m_Position + m_PositionOffset,
 		m_Colour,
 		m_Rotation,
@@ -45,9 +46,9 @@ void SFString::Draw(DirectX::SpriteBatch* batch)
 void SFString::Draw(DirectX::SpriteFont* font)
 {
 	msg_assert(font && m_Batch, "Draw(): No font and/or batch set!");
-	font->DrawString(
+	GlyphLayoutCache::Draw(
+		GetLayout(font),
 		m_Batch,
-		m_DrawableStr.c_str(),
 		m_Position + m_PositionOffset,
 		m_Colour,
 		m_Rotation,
@@ -61,9 +62,9 @@ void SFString::Draw(DirectX::SpriteFont* font)
 void SFString::Draw(DirectX::SpriteFont* font, DirectX::SpriteBatch* batch)
 {
 	msg_assert(font && batch, "Draw(): No font and/or batch set!");
-	font->DrawString(
+	GlyphLayoutCache::Draw(
+		GetLayout(font),
 		batch,
-		m_DrawableStr.c_str(),
 		m_Position + m_PositionOffset,
 		m_Colour,
 		m_Rotation,
@@ -78,8 +79,9 @@ void SFString::UpdateOrigin()
 {
     msg_assert(m_Font, "UpdateOrigin(): No SF set!");
 
-	//Call justification calc
-    CalcStringJustification(m_Font, (StringJustificationID)m_JustificationID, m_DrawableStr, m_Origin);
+	//Call justification calc with the laid out size
+	const GlyphLayoutCache::Layout& layout = GetLayout(m_Font);
+	CalcStringJustification((StringJustificationID)m_JustificationID, Vec2(layout.m_Extents), m_Origin);
 }
 
 void SFString::UpdateOrigin(StringJustificationID id)
@@ -88,7 +90,7 @@ void SFString::UpdateOrigin(StringJustificationID id)
 
 	//Set new ID and call calc
 	m_JustificationID = (unsigned short)id;
-	CalcStringJustification(m_Font, (StringJustificationID)m_JustificationID, m_DrawableStr, m_Origin);
+	UpdateOrigin();
 }
 
 void SFString::SetNewString(const std::string& str, bool updateOrigin)
@@ -108,42 +110,189 @@ void SFString::SetBothStrings(const std::string& str)
 	m_DrawableStr = m_DefaultStr;
 }
 
+const GlyphLayoutCache::Layout& SFString::GetLayout(DirectX::SpriteFont* font)
+{
+	msg_assert(font, "GetLayout(): No SF set!");
+
+	//Relayout from the last layout if the string has changed, reusing any shared prefix
+	if (!m_Layout || m_Layout->m_Font != font || m_Layout->m_Text != m_DrawableStr)
+		m_Layout = GlyphLayoutCache::GetShared().Acquire(font, m_DrawableStr, m_Layout.get());
+
+	return *m_Layout;
+}
+
+int AnimationData::GetFrameCount() const
+{
+	switch (m_TypeID)
+	{
+	case AnimID::LINEAR_FRAMES:
+		return (m_EndFrame - m_StartFrame) + 1;
+	case AnimID::NON_LINEAR_FRAMES:
+		return static_cast<int>(m_FrameIndexes.size());
+	}
+
+	return 0;
+}
+
+int AnimationData::GetTextureFrame(int relativeFrame) const
+{
+	switch (m_TypeID)
+	{
+	case AnimID::LINEAR_FRAMES:
+		return m_StartFrame + relativeFrame;
+	case AnimID::NON_LINEAR_FRAMES:
+		return m_FrameIndexes[relativeFrame];
+	}
+
+	return 0;
+}
+
+bool AnimationData::StepRelativeFrame(int& relativeFrame, long long steps, bool loop, bool reverse) const
+{
+	long long length = GetFrameCount();
+	if (length <= 0)
+	{
+		relativeFrame = 0;
+		return false;
+	}
+
+	//Still in range, nothing else to do
+	long long target = reverse ? relativeFrame - steps : relativeFrame + steps;
+	if (target >= 0 && target < length)
+	{
+		relativeFrame = static_cast<int>(target);
+		return true;
+	}
+
+	//Wrap around however many times needed
+	if (loop)
+	{
+		relativeFrame = static_cast<int>(((target % length) + length) % length);
+		return true;
+	}
+
+	//Hold on end frame (in direction of play)
+	relativeFrame = reverse ? 0 : static_cast<int>(length - 1);
+	return false;
+}
+
+int AnimationData::SampleRelativeFrame(float time, float frameDuration, bool loop, bool reverse) const
+{
+	int relativeFrame = reverse ? GetFrameCount() - 1 : 0;
+	if (time > 0.f && frameDuration > 0.f)
+		StepRelativeFrame(relativeFrame, static_cast<long long>(time / frameDuration), loop, reverse);
+
+	return relativeFrame;
+}
+
+/*
+	Rotated frames are stored 90 degrees clockwise, so draw them rotated back. Scale and flips are applied by the
+	batch before rotating (in texture space), so swap their axes to match.
+*/
+static inline void AdjustForRotatedFrame(XMF2& scale, float& rotation, DirectX::SpriteEffects& effect)
+{
+	std::swap(scale.x, scale.y);
+	rotation -= DirectX::XM_PIDIV2;
+	unsigned flips = static_cast<unsigned>(effect);
+	effect = static_cast<DirectX::SpriteEffects>(((flips & 1) << 1) | ((flips & 2) >> 1));
+}
+
+SpriteTexture& SpriteTexture::operator=(const SpriteTexture& other)
+{
+	if (this == &other)
+		return *this;
+
+	m_FrameStorage = other.m_FrameStorage;
+	m_HullVertexStorage = other.m_HullVertexStorage;
+	m_MetaFile = other.m_MetaFile;
+	m_Animations = other.m_Animations;
+	m_TexSize = other.m_TexSize;
+	m_Name = other.m_Name;
+	m_ID = other.m_ID;
+	m_Used = other.m_Used;
+	m_TextureResource = other.m_TextureResource;
+	m_Heap = other.m_Heap;
+	m_HeapIndex = other.m_HeapIndex;
+
+	//View own copy of the storage if the source viewed its storage
+	m_Frames = other.m_Frames.data() == other.m_FrameStorage.data() ? ArrayView<SpriteFrame>(m_FrameStorage) : other.m_Frames;
+	m_HullVertices = other.m_HullVertices.data() == other.m_HullVertexStorage.data() ?
+		ArrayView<DirectX::XMFLOAT2>(m_HullVertexStorage) : other.m_HullVertices;
+
+	return *this;
+}
+
+SpriteTexture& SpriteTexture::operator=(SpriteTexture&& other) noexcept
+{
+	if (this == &other)
+		return *this;
+
+	//Check before the storage moves (moved buffers keep their address, so views carry over either way)
+	bool ownsFrames = other.m_Frames.data() == other.m_FrameStorage.data();
+	bool ownsHulls = other.m_HullVertices.data() == other.m_HullVertexStorage.data();
+
+	m_FrameStorage = std::move(other.m_FrameStorage);
+	m_HullVertexStorage = std::move(other.m_HullVertexStorage);
+	m_MetaFile = std::move(other.m_MetaFile);
+	m_Animations = std::move(other.m_Animations);
+	m_TexSize = other.m_TexSize;
+	m_Name = std::move(other.m_Name);
+	m_ID = other.m_ID;
+	m_Used = other.m_Used;
+	m_TextureResource = std::move(other.m_TextureResource);
+	m_Heap = other.m_Heap;
+	m_HeapIndex = other.m_HeapIndex;
+
+	m_Frames = ownsFrames ? ArrayView<SpriteFrame>(m_FrameStorage) : other.m_Frames;
+	m_HullVertices = ownsHulls ? ArrayView<DirectX::XMFLOAT2>(m_HullVertexStorage) : other.m_HullVertices;
+
+	//Source no longer owns anything to view
+	other.m_Frames = ArrayView<SpriteFrame>();
+	other.m_HullVertices = ArrayView<DirectX::XMFLOAT2>();
+
+	return *this;
+}
+
 void SpriteData::Draw()
 {
-    m_Batch->Draw(
-        m_Texture->m_Heap->GetGpuHandle(m_Texture->m_HeapIndex),
-        m_TexSize,
-        m_Position + m_PositionOffset,
-        &m_FrameRect,
-        m_Colour,
-        m_Rotation + m_RotationOffset,
-        m_Origin,
-        m_Scale,
-        m_SprEffect,
-        m_LayerDepth
-    );
+    Draw(m_Batch);
 }
 
 void SpriteData::Draw(DirectX::SpriteBatch* batch)
 {
+	const SpriteFrame& frame = m_Texture->m_Frames[m_FrameIndex];
+	m_Texture->m_Used = true;
+
+	XMF2 scale = m_Scale;
+	float rotation = m_Rotation + m_RotationOffset;
+	DirectX::SpriteEffects effect = m_SprEffect;
+	if (frame.m_Rotated)
+		AdjustForRotatedFrame(scale, rotation, effect);
+
 	batch->Draw(
 		m_Texture->m_Heap->GetGpuHandle(m_Texture->m_HeapIndex),
-		m_TexSize,
+		m_Texture->m_TexSize,
 		m_Position + m_PositionOffset,
-		&m_FrameRect,
+		&frame.m_Rect,
 		m_Colour,
-		m_Rotation + m_RotationOffset,
-		m_Origin,
-		m_Scale,
-		m_SprEffect,
+		rotation,
+		frame.m_Origin,
+		scale,
+		effect,
 		m_LayerDepth
 	);
 }
 
 bool SpriteData::SetTexture(std::string& texName, System& sys)
 {
-    //Attempt to find target texture from resource manager
-	SpriteTexture* tex = sys.m_TexMgr->FindTextureData(texName);
+    //Resolve name, then set as by ID
+	return SetTexture(sys.m_TexMgr->FindTextureID(texName), sys);
+}
+
+bool SpriteData::SetTexture(SpriteTexture::TextureID texID, System& sys)
+{
+    //Attempt to get target texture from resource manager
+	SpriteTexture* tex = sys.m_TexMgr->GetTexture(texID);
     msg_assert(tex, "SetTexture(): No texture found!");
 
     //If texture found, finish setup
@@ -151,8 +300,6 @@ bool SpriteData::SetTexture(std::string& texName, System& sys)
     {
 		//Set texture
 		m_Texture = tex;
-		//Store texture size
-		m_TexSize = DirectX::GetTextureSize(m_Texture->m_TextureResource.Get());
         //Should be at least one frame, set to first frame by default
         SetFrame(0);
 
@@ -171,8 +318,6 @@ bool SpriteData::SetTexture(std::shared_ptr<SpriteTexture> tex)
     {
         //Set texture
         m_Texture = tex.get();
-        //Store texture size
-        m_TexSize = DirectX::GetTextureSize(m_Texture->m_TextureResource.Get());
         //Should be at least one frame, set to first frame by default
         SetFrame(0);
 
@@ -191,8 +336,6 @@ bool SpriteData::SetTexture(SpriteTexture* tex)
 	{
 		//Set texture
 		m_Texture = tex;
-		//Store texture size
-		m_TexSize = DirectX::GetTextureSize(m_Texture->m_TextureResource.Get());
 		//Should be at least one frame, set to first frame by default
 		SetFrame(0);
 
@@ -205,9 +348,70 @@ bool SpriteData::SetTexture(SpriteTexture* tex)
 
 void SpriteData::SetFrame(int index)
 {
-    assert(index >= 0 && index <= m_Texture->m_Frames.size());
-    m_FrameRect = m_Texture->m_Frames[index];
-    m_Origin = m_Texture->m_Origins[index];
+    assert(index >= 0 && index < m_Texture->m_Frames.size());
+    m_FrameIndex = static_cast<SpriteTexture::FrameIndex>(index);
+}
+
+void SpriteData::SaveSnapshot(SnapshotWriter& writer)
+{
+	//Write each field on its own, so the format doesn't depend on member layout or padding
+	DirectX::XMFLOAT4 colour;
+	DirectX::XMStoreFloat4(&colour, m_Colour);
+
+	writer.Write(m_Position.x);
+	writer.Write(m_Position.y);
+	writer.Write(m_PositionOffset.x);
+	writer.Write(m_PositionOffset.y);
+	writer.Write(colour);
+	writer.Write(m_Rotation);
+	writer.Write(m_RotationOffset);
+	writer.Write(m_Scale);
+	writer.Write(static_cast<uint32_t>(m_SprEffect));
+	writer.Write(m_LayerDepth);
+	writer.Write(m_FrameIndex);
+}
+
+bool SpriteData::LoadSnapshot(SnapshotReader& reader, bool apply)
+{
+	//Read into temporaries, only applying them if everything was read
+	Vec2 position;
+	Vec2 positionOffset;
+	DirectX::XMFLOAT4 colour;
+	float rotation = 0.f;
+	float rotationOffset = 0.f;
+	XMF2 scale;
+	uint32_t effect = 0;
+	float layerDepth = 0.f;
+	SpriteTexture::FrameIndex frameIndex = 0;
+
+	bool result = reader.Read(position.x) && reader.Read(position.y) &&
+		reader.Read(positionOffset.x) && reader.Read(positionOffset.y) &&
+		reader.Read(colour) && reader.Read(rotation) && reader.Read(rotationOffset) &&
+		reader.Read(scale) && reader.Read(effect) && reader.Read(layerDepth) && reader.Read(frameIndex);
+	if (!result)
+		return false;
+
+	//Frame must exist in the current texture
+	if (m_Texture && frameIndex >= m_Texture->m_Frames.size())
+	{
+		msg_assert(false, "LoadSnapshot(): Frame index out of range for current texture!");
+		return false;
+	}
+
+	if (!apply)
+		return true;
+
+	m_Position = position;
+	m_PositionOffset = positionOffset;
+	m_Colour = DirectX::XMLoadFloat4(&colour);
+	m_Rotation = rotation;
+	m_RotationOffset = rotationOffset;
+	m_Scale = scale;
+	m_SprEffect = static_cast<DirectX::SpriteEffects>(effect);
+	m_LayerDepth = layerDepth;
+	m_FrameIndex = frameIndex;
+
+	return true;
 }
 
 void SpriteAnimator::Update(float dTime)
@@ -231,38 +435,11 @@ void SpriteAnimator::Update(float dTime)
 
 void SpriteAnimator::RestartAnimation(bool play)
 {
-	//Restart to base frame (based on animation type and reverse state)
-	switch (m_Data.m_Reverse)
-	{
-	case false:
-		switch (m_CurrentAnim->m_TypeID)
-		{
-		case(AnimationData::AnimID::LINEAR_FRAMES):
-			m_Data.m_CurrentFrame = m_CurrentAnim->m_StartFrame;
-			break;
-		case(AnimationData::AnimID::NON_LINEAR_FRAMES):
-			m_Data.m_CurrentFrame = m_CurrentAnim->m_FrameIndexes[0];
-			break;
-		}
-		break;
-
-	case true:
-		switch (m_CurrentAnim->m_TypeID)
-		{
-		case(AnimationData::AnimID::LINEAR_FRAMES):
-			m_Data.m_CurrentFrame = m_CurrentAnim->m_EndFrame;
-			break;
-		case(AnimationData::AnimID::NON_LINEAR_FRAMES):
-			m_Data.m_CurrentFrame = m_CurrentAnim->m_FrameIndexes[m_CurrentAnim->m_FrameIndexes.size() - 1];
-			break;
-		}
-		break;
-	}
-
-	//Set frame & origin
-	m_SprData->SetFrame(m_Data.m_CurrentFrame);
-	//Reset timer
+	//Restart to base frame (last frame if reversed), and set frame & origin
+	ApplyRelativeFrame(m_Data.m_Reverse ? m_CurrentAnim->GetFrameCount() - 1 : 0);
+	//Reset timer, taking the animations current speed
 	m_Data.m_Elapsed = 0.f;
+	m_Data.m_Speed = m_CurrentAnim->m_Speed;
 	//Set play flag
 	m_Data.m_Play = play;
 }
@@ -378,10 +555,79 @@ void SpriteAnimator::SetFrame(int newFrame, bool resetElapsed)
 		m_Data.m_Elapsed = 0.f;
 }
 
+short SpriteAnimator::SampleFrame(float time)
+{
+	int relativeFrame = m_CurrentAnim->SampleRelativeFrame(time, GetFrameDuration(), m_Data.m_Loop, m_Data.m_Reverse);
+	return static_cast<short>(m_CurrentAnim->GetTextureFrame(relativeFrame));
+}
+
+void SpriteAnimator::SetAnimationTime(float time)
+{
+	float frameDuration = GetFrameDuration();
+	if (time < 0.f)
+		time = 0.f;
+
+	//Step from the start of the animation to the given time
+	int relativeFrame = m_Data.m_Reverse ? m_CurrentAnim->GetFrameCount() - 1 : 0;
+	long long frames = static_cast<long long>(time / frameDuration);
+	if (m_CurrentAnim->StepRelativeFrame(relativeFrame, frames, m_Data.m_Loop, m_Data.m_Reverse))
+		m_Data.m_Elapsed = std::fmod(time, frameDuration);
+	else
+		EndAnimation();
+
+	ApplyRelativeFrame(relativeFrame);
+}
+
+void SpriteAnimator::SaveSnapshot(SnapshotWriter& writer)
+{
+	writer.Write(m_Data);
+
+	//Store animation via its index in the texture (-1 if none)
+	int32_t animIndex = m_CurrentAnim ? static_cast<int32_t>(m_CurrentAnim->m_ContainerIndex) : -1;
+	writer.Write(animIndex);
+}
+
+bool SpriteAnimator::LoadSnapshot(SnapshotReader& reader, bool apply)
+{
+	AnimatorData data;
+	int32_t animIndex = -1;
+	if (!reader.Read(data) || !reader.Read(animIndex))
+		return false;
+
+	//Find animation through sprite texture
+	const AnimationData* anim = nullptr;
+	if (animIndex >= 0)
+	{
+		bool isValid = m_SprData && m_SprData->m_Texture && animIndex < static_cast<int32_t>(m_SprData->m_Texture->m_Animations.size());
+		if (!isValid)
+		{
+			msg_assert(false, "LoadSnapshot(): Animation not found via sprite texture!");
+			return false;
+		}
+
+		anim = &m_SprData->m_Texture->m_Animations[animIndex];
+	}
+
+	if (!apply)
+		return true;
+
+	m_Data = data;
+	m_CurrentAnim = anim;
+
+	return true;
+}
+
 bool SpriteAnimator::SetAnimation(int index, bool play, bool restartIfPlaying, bool loop, bool reverse)
 {
+	//Textures still streaming in have no animations yet (see TextureStreamer::Request), so wait for them to be resident
+	if (m_SprData->m_Texture->m_Animations.empty())
+	{
+		DBOUT("SetAnimation(): Texture has no animations (still streaming?): " << m_SprData->m_Texture->m_Name);
+		return false;
+	}
+
 	//Check index validity
-	bool isValid = index >= 0 && index <= m_SprData->m_Texture->m_Animations.size();
+	bool isValid = index >= 0 && index < static_cast<int>(m_SprData->m_Texture->m_Animations.size());
 	if (!isValid)
 	{
 		msg_assert(false, "SetAnimation(): Index invalid!");
@@ -403,9 +649,8 @@ bool SpriteAnimator::SetAnimation(int index, bool play, bool restartIfPlaying, b
 	//Set local data
 	m_Data.m_Loop = loop;
 	m_Data.m_Reverse = reverse;
-	m_Data.m_Speed = m_CurrentAnim->m_Speed;
 
-	//This sets the frame, play status and resets current frame timer
+	//This sets the frame, speed, play status and resets current frame timer
 	RestartAnimation(play);
 
 	return true;
@@ -413,110 +658,73 @@ bool SpriteAnimator::SetAnimation(int index, bool play, bool restartIfPlaying, b
 
 void SpriteAnimator::Update_LinearAnimation(float dTime)
 {
-	//Uptick elapsed time
-	m_Data.m_Elapsed += dTime;
-	//Calculate current frame duration (in terms of Frames Per Second, modified by speed multiplier)
-	float frameDuration = (1.f / (m_Data.m_Speed * m_Data.m_AnimSpeedMod));
-	//If elapsed over animation speed
-	if (m_Data.m_Elapsed > frameDuration)
-	{
-		//Reset the clock
-		m_Data.m_Elapsed = 0.f;
+	long long frames = ConsumeElapsedFrames(dTime);
+	if (frames == 0)
+		return;
 
-		//Determine how to manage the animation based on reverse flag
-		switch (m_Data.m_Reverse)
-		{
-		case false:
-			//Increment the frame count
-			++m_Data.m_CurrentFrame;
-			//Check if out of animation range
-			if (m_Data.m_CurrentFrame > m_CurrentAnim->m_EndFrame)
-			{
-				//If set to loop, change to first frame, else set frame to end and stop
-				if (m_Data.m_Loop)
-					m_Data.m_CurrentFrame = m_CurrentAnim->m_StartFrame;
-				else
-				{
-					m_Data.m_CurrentFrame = m_CurrentAnim->m_EndFrame;
-					m_Data.m_Play = false;
-
-					//Disable lock
-					m_Data.m_AnimLockedIn = false;
-				}
-			}
-			break;
-
-		case true:
-			--m_Data.m_CurrentFrame;
-			if (m_Data.m_CurrentFrame < m_CurrentAnim->m_StartFrame)
-			{
-				if (m_Data.m_Loop)
-					m_Data.m_CurrentFrame = m_CurrentAnim->m_EndFrame;
-				else
-				{
-					m_Data.m_CurrentFrame = m_CurrentAnim->m_StartFrame;
-					m_Data.m_Play = false;
-
-					//Disable lock
-					m_Data.m_AnimLockedIn = false;
-				}
-			}
-			break;
-		}
+	//Step however many frames have passed in one go
+	int relativeFrame = m_Data.m_CurrentFrame - m_CurrentAnim->m_StartFrame;
+	if (!m_CurrentAnim->StepRelativeFrame(relativeFrame, frames, m_Data.m_Loop, m_Data.m_Reverse))
+		EndAnimation();
 
-		//Set frame post anim update
-		m_SprData->SetFrame(m_Data.m_CurrentFrame);
-	}
+	//Set frame post anim update
+	ApplyRelativeFrame(relativeFrame);
 }
 
 void SpriteAnimator::Update_NonLinearAnimation(float dTime)
+{
+	long long frames = ConsumeElapsedFrames(dTime);
+	if (frames == 0)
+		return;
+
+	//Current frame is already relative (index into frame indexes)
+	int relativeFrame = m_Data.m_CurrentFrame;
+	if (!m_CurrentAnim->StepRelativeFrame(relativeFrame, frames, m_Data.m_Loop, m_Data.m_Reverse))
+		EndAnimation();
+
+	//Set frame post anim update
+	ApplyRelativeFrame(relativeFrame);
+}
+
+long long SpriteAnimator::ConsumeElapsedFrames(float dTime)
 {
 	//Uptick elapsed time
 	m_Data.m_Elapsed += dTime;
 	//Calculate current frame duration (in terms of Frames Per Second, modified by speed multiplier)
-	float frameDuration = (1.f / (m_Data.m_Speed * m_Data.m_AnimSpeedMod));
-	//If elapsed over animation speed
-	if (m_Data.m_Elapsed > frameDuration)
-	{
-		//Reset the clock
-		m_Data.m_Elapsed = 0.f;
+	float frameDuration = GetFrameDuration();
+	if (m_Data.m_Elapsed < frameDuration)
+		return 0;
 
-		//Determine how to manage the animation based on reverse flag
-		switch (m_Data.m_Reverse)
-		{
-		case false:
-			//Increment the frame count
-			++m_Data.m_CurrentFrame;
-			//Check if out of animation range
-			if (m_Data.m_CurrentFrame > m_CurrentAnim->m_FrameIndexes.size())
-			{
-				//If set to loop, change to first frame, else set frame to end and stop
-				if (m_Data.m_Loop)
-					m_Data.m_CurrentFrame = m_CurrentAnim->m_FrameIndexes[0];
-				else
-				{
-					m_Data.m_CurrentFrame = static_cast<short int>(m_CurrentAnim->m_FrameIndexes.size());
-					m_Data.m_Play = false;
-				}
-			}
-			break;
-
-		case true:
-			--m_Data.m_CurrentFrame;
-			if (m_Data.m_CurrentFrame < 0)
-			{
-				if (m_Data.m_Loop)
-					m_Data.m_CurrentFrame = static_cast<short>(m_CurrentAnim->m_FrameIndexes.size());
-				else
-				{
-					m_Data.m_CurrentFrame = m_CurrentAnim->m_FrameIndexes[0];
-					m_Data.m_Play = false;
-				}
-			}
-			break;
-		}
+	/*
+		Work out every frame that has passed (not just one), and keep the remainder rather than resetting the clock.
+		This keeps animations in time through frame hitches or with frame durations shorter than the update rate.
+	*/
+	long long frames = static_cast<long long>(m_Data.m_Elapsed / frameDuration);
+	m_Data.m_Elapsed = std::fmod(m_Data.m_Elapsed, frameDuration);
+
+	return frames;
+}
 
-		//Set frame post anim update
-		m_SprData->SetFrame(m_Data.m_CurrentFrame);
+void SpriteAnimator::ApplyRelativeFrame(int relativeFrame)
+{
+	//Linear animations track texture frames, non-linear track the index into frame indexes
+	switch (m_CurrentAnim->m_TypeID)
+	{
+	case AnimationData::AnimID::LINEAR_FRAMES:
+		m_Data.m_CurrentFrame = static_cast<short>(m_CurrentAnim->m_StartFrame + relativeFrame);
+		break;
+	case AnimationData::AnimID::NON_LINEAR_FRAMES:
+		m_Data.m_CurrentFrame = static_cast<short>(relativeFrame);
+		break;
 	}
-}
\ No newline at end of file
+
+	m_SprData->SetFrame(m_CurrentAnim->GetTextureFrame(relativeFrame));
+}
+
+void SpriteAnimator::EndAnimation()
+{
+	m_Data.m_Play = false;
+	m_Data.m_Elapsed = 0.f;
+	//Disable lock
+	m_Data.m_AnimLockedIn = false;
+}
@@ -14,11 +14,15 @@
 #include <d3d12.h>			//ID3D12Resource
 #include <vector>
 #include <string>
+#include <cstdint>
+#include <memory>
+#include <utility>
 #include "DescriptorHeap.h"
 #include "ResourceUploadBatch.h"
 
 //Engine Includes
 #include "Types/FrameResources.h"
+#include "Rendering/GlyphLayoutCache.h"
 
 //
 //Foward Declarations
@@ -26,6 +30,11 @@
 
 //Main system container used to pass manager accessors around
 struct System;
+//Memory mapped file (see MappedFile.h)
+class MappedFile;
+//Snapshot read/writers (see BE_Snapshot.h)
+class SnapshotWriter;
+class SnapshotReader;
 
 //================================================================================\\
 // General Data Types 
@@ -35,6 +44,9 @@ struct System;
 	Composite structure for providing several different data types used in drawing strings
 	with Spritefonts. Also provides some additional basic behaviour to get it working out
 	of the box, as part of another
+
+	The string is laid out through the shared GlyphLayoutCache, so measuring it for the origin
+	and drawing it reuse the same layout, and changes only lay out what differs.
 */
 struct SFString
 {
@@ -90,6 +102,9 @@ struct SFString
 	//Gets the combined position (main position + offset)
 	Vec2 GetAdjustedPosition() { return m_Position + m_PositionOffset; }
 
+	//Gets the layout of the drawable string with the given font, updating it if the string (or font) has changed since
+	const GlyphLayoutCache::Layout& GetLayout(DirectX::SpriteFont* font);
+
 	////////////
 	/// Data ///
 	////////////
@@ -120,6 +135,9 @@ struct SFString
 	*/
 	Vec2 m_Origin = { 0.f, 0.f };
 	unsigned short m_JustificationID = 0;
+
+	//Last layout of the drawable string, checked against the string before use (as it can be set directly)
+	GlyphLayoutCache::LayoutPtr m_Layout;
 };
 
 //================================================================================\\
@@ -175,6 +193,83 @@ struct AnimationData
 
 	//Uses (End Frame - Start Frame + 1) to determine number of frames in the given animation
 	void CalculateAnimLength() { m_AnimationLength = (m_EndFrame - m_StartFrame) + 1; }
+
+	//
+	//Frame Stepping (frames relative to the start of the animation, regardless of type)
+	//
+
+	//Gets number of frames in animation (based on type)
+	int GetFrameCount() const;
+	//Converts frame relative to the start of the animation into its texture frame
+	int GetTextureFrame(int relativeFrame) const;
+
+	/*
+		Steps relative frame by any number of frames in one go, wrapping if looping, or holding on the end frame otherwise.
+		Returns false if the animation ended (wasn't looping and stepped past the end).
+	*/
+	bool StepRelativeFrame(int& relativeFrame, long long steps, bool loop, bool reverse) const;
+	/*
+		Stateless evaluation of the relative frame at an absolute time since the animation started (from its first frame,
+		or last if reversed). Lets animators not be updated at all while unseen, and be resynced when needed.
+	*/
+	int SampleRelativeFrame(float time, float frameDuration, bool loop, bool reverse) const;
+};
+
+/*
+	Non-owning view of a contiguous array. Lets data be referenced where it already lives (owned storage, or a memory
+	mapped file) without being copied.
+*/
+template<class T>
+struct ArrayView
+{
+	ArrayView() { }
+	ArrayView(const T* data, size_t size)
+		:m_Data(data), m_Size(size)
+	{ }
+	ArrayView(const std::vector<T>& vec)
+		:m_Data(vec.data()), m_Size(vec.size())
+	{ }
+
+	const T& operator[](size_t index) const { return m_Data[index]; }
+	size_t size() const { return m_Size; }
+	bool empty() const { return m_Size == 0; }
+	const T* data() const { return m_Data; }
+	const T* begin() const { return m_Data; }
+	const T* end() const { return m_Data + m_Size; }
+
+	const T* m_Data = nullptr;
+	size_t m_Size = 0;
+};
+
+/*
+	Baked data for a single frame of a texture. Built once when the frame data is loaded, so everything a sprite needs
+	to draw the frame is in one place (rather than converted or looked up from several containers as needed).
+*/
+struct SpriteFrame
+{
+	//Frame rect relative to the texture (in pixels)
+	RECT m_Rect;
+	//Frame rect normalised to the texture size (left, top, right, bottom)
+	DirectX::XMFLOAT4 m_UV;
+	//Origin point of the frame, relative to the frame as packed (adjusted for trimming and rotation)
+	DirectX::XMFLOAT2 m_Origin;
+	//Size of the frame as packed in the texture (i.e. trimmed size, and swapped if rotated)
+	DirectX::XMFLOAT2 m_Size;
+	//Size of the sprite before trimming (upright)
+	DirectX::XMFLOAT2 m_SourceSize;
+	/*
+		Frame is stored rotated 90 degrees clockwise in the texture. Drawn rotated back by -90 degrees, with scale
+		and flips swapped to match (see SpriteData::Draw).
+	*/
+	bool m_Rotated = false;
+	/*
+		Optional polygon hull around the frames visible pixels (see SpriteHullBuilder). Vertices are in the textures
+		hull vertex list, normalised to the frame as packed. A count of 0 means the frame is drawn as a quad.
+	*/
+	uint16_t m_HullCount = 0;
+	uint32_t m_HullFirst = 0;
+	//Area drawn relative to the full quad (1 for quads)
+	float m_HullCoverage = 1.f;
 };
 
 /*
@@ -183,13 +278,34 @@ struct AnimationData
 */
 struct SpriteTexture
 {
+	//////////////////////////////
+	/// Enums, Types & Statics ///
+	//////////////////////////////
+
+	//Frames are referenced by 16-bit index (see SpriteData::m_FrameIndex)
+	typedef uint16_t FrameIndex;
+	static constexpr size_t MAX_FRAMES = 0xFFFF;
+	//Textures are referenced by dense handle, indexing the texture array of Mgr_TextureResources
+	typedef uint32_t TextureID;
+	static constexpr TextureID INVALID_ID = 0xFFFFFFFF;
+
 	////////////////////
 	/// Constructors ///
 	////////////////////
 
+	SpriteTexture() { }
+	/*
+		Copies/moves point the frame and hull views at their own storage where the source viewed its owned storage
+		(views of a mapped file are kept, as the file is shared).
+	*/
+	SpriteTexture(const SpriteTexture& other) { *this = other; }
+	SpriteTexture(SpriteTexture&& other) noexcept { *this = std::move(other); }
+	SpriteTexture& operator=(const SpriteTexture& other);
+	SpriteTexture& operator=(SpriteTexture&& other) noexcept;
 	~SpriteTexture()
 	{
-		m_Frames.clear();
+		m_FrameStorage.clear();
+		m_HullVertexStorage.clear();
 		m_Animations.clear();
 	}
 
@@ -197,15 +313,29 @@ struct SpriteTexture
 	/// Data ///
 	////////////
 
-	//Each frame of the texture (the individual animation frames)
-	std::vector<RECT> m_Frames;
-	//Origin point for each of the frame in the texture
-	std::vector<DirectX::XMFLOAT2> m_Origins;
+	/*
+		Each frame of the texture (the individual animation frames), stored contiguously, and the hull vertices of all
+		frames (see SpriteFrame::m_HullFirst). Views either the owned storage below (loaded from JSON), or a mapped
+		baked metadata file (see SpriteMetaFile).
+	*/
+	ArrayView<SpriteFrame> m_Frames;
+	ArrayView<DirectX::XMFLOAT2> m_HullVertices;
+	std::vector<SpriteFrame> m_FrameStorage;
+	std::vector<DirectX::XMFLOAT2> m_HullVertexStorage;
+	//Baked metadata file the views point into (if loaded from one), kept mapped for as long as the texture lives
+	std::shared_ptr<MappedFile> m_MetaFile;
 	//Each animation related to this texture
 	std::vector<AnimationData> m_Animations;
 
-	//Texture name (alias used in texture map)
+	//Size of the texture (stored on load, avoiding resource queries when setting textures)
+	DirectX::XMUINT2 m_TexSize = { 0, 0 };
+
+	//Texture name (alias resolved to ID, see Mgr_TextureResources::FindTextureID)
 	std::string m_Name = "NULL";
+	//Handle assigned when stored by Mgr_TextureResources
+	TextureID m_ID = INVALID_ID;
+	//Set when drawn, and cleared by TextureResidencyCache as it records use each frame
+	bool m_Used = false;
 	//Pointer to the resource information directly
 	Microsoft::WRL::ComPtr<ID3D12Resource> m_TextureResource = nullptr;
 	//Pointer to heap that the texture is located in
@@ -227,9 +357,9 @@ public:
 	////////////////////
 
 	SpriteData()
-		:m_Batch(nullptr), m_TexSize(1920, 1080), m_Position(0, 0), m_PositionOffset(0, 0), m_FrameRect({ 0, 0, 1920, 1080 }),
-		m_Colour({ 1.f, 1.f, 1.f, 1.f }), m_Rotation(0.f), m_Origin(0.f, 0.f), m_Scale(1.f, 1.f),
-		m_SprEffect(DirectX::SpriteEffects::SpriteEffects_None), m_LayerDepth(1.f), m_RotationOffset(0.f)
+		:m_Texture(nullptr), m_Batch(nullptr), m_Position(0, 0), m_PositionOffset(0, 0), m_Colour({ 1.f, 1.f, 1.f, 1.f }),
+		m_Rotation(0.f), m_RotationOffset(0.f), m_Scale(1.f, 1.f), m_SprEffect(DirectX::SpriteEffects::SpriteEffects_None),
+		m_LayerDepth(1.f), m_FrameIndex(0)
 	{ }
 
 	//////////////////
@@ -245,9 +375,13 @@ public:
 	/// Accessors ///
 	/////////////////
 
-	//Get the relative size of the current frame
-	float GetFrameSizeX() { return static_cast<float>(m_FrameRect.right - m_FrameRect.left); }
-	float GetFrameSizeY() { return static_cast<float>(m_FrameRect.bottom - m_FrameRect.top); }
+	//Gets baked data for the current frame (texture must be set)
+	const SpriteFrame& GetCurrentFrame() { return m_Texture->m_Frames[m_FrameIndex]; }
+	SpriteTexture::FrameIndex GetFrameIndex() { return m_FrameIndex; }
+
+	//Get the relative size of the current frame (untrimmed, so unaffected by how the frame was packed)
+	float GetFrameSizeX() { return m_Texture ? GetCurrentFrame().m_SourceSize.x : 0.f; }
+	float GetFrameSizeY() { return m_Texture ? GetCurrentFrame().m_SourceSize.y : 0.f; }
 	//Gets the relative size of the current frame, adjusted for current scale
 	float GetFrameSizeX_Scaled() { return GetFrameSizeX() * m_Scale.x; }
 	float GetFrameSizeY_Scaled() { return GetFrameSizeY() * m_Scale.y; }
@@ -255,8 +389,10 @@ public:
 	//Gets the position with offset factored in
 	Vec2 GetAdjustedPosition() { return m_Position + m_PositionOffset; }
 
-	//Sets texture via accessor name (accesses Mgr_TextureResources to do so)
+	//Sets texture via accessor name (accesses Mgr_TextureResources to do so, hashing the name, so prefer IDs for repeated swaps)
 	bool SetTexture(std::string& texName, System& sys);
+	//Sets texture via ID (see Mgr_TextureResources::FindTextureID)
+	bool SetTexture(SpriteTexture::TextureID texID, System& sys);
 	//Sets texture using given resource
 	bool SetTexture(std::shared_ptr<SpriteTexture> tex);
 	bool SetTexture(SpriteTexture* tex);
@@ -264,6 +400,15 @@ public:
 	//Sets frame via texture information (Animator uses this to set frame during animation)
 	void SetFrame(int index);
 
+	//
+	//Snapshots
+	//
+
+	//Writes sprite state into snapshot (texture and batch are not stored, so restore onto setup sprites)
+	void SaveSnapshot(SnapshotWriter& writer);
+	//Reads sprite state, applying it only if apply is set and everything read is valid
+	bool LoadSnapshot(SnapshotReader& reader, bool apply = true);
+
 	////////////
 	/// Data ///
 	////////////
@@ -273,26 +418,27 @@ public:
 	//Spritebatch being used in draw calls (ensure draw call begun when called)
 	DirectX::SpriteBatch* m_Batch;
 
-	//Total size of the texture
-	XMUI2 m_TexSize;
+	/*
+		Members from here to m_FrameIndex are the sprites value state. They are snapshotted (see SaveSnapshot), so bump
+		the snapshot version if changing them, and copied as one block by prefab instancing, so keep handles above.
+	*/
+
 	//Main position (should be informed by the actor), and an offsetting factor
 	Vec2 m_Position;
 	Vec2 m_PositionOffset;
-	//Frames dims relative to the texture
-	RECT m_FrameRect;
 	//Colour/Alpha adjustments to the sprite
 	XMVec4 m_Colour;
 	//Base rotation in radians (should be informed by the actor), and an offsetting factor
 	float m_Rotation;
 	float m_RotationOffset;
-	//Origin of the sprite relative to the frame
-	XMF2 m_Origin;
 	//Size of the sprite
 	XMF2 m_Scale;
 	//Applied effect like flipping on x/y axis'
 	DirectX::SpriteEffects m_SprEffect;
 	//Depth/layering priority within the draw call (1 = highest, 0 = lowest)
 	float m_LayerDepth;
+	//Current frame in the textures frame table (rect, origin etc are read from there)
+	SpriteTexture::FrameIndex m_FrameIndex;
 
 private:
 
@@ -343,7 +489,7 @@ public:
 
 	//Update window that should be called once per frame
 	void Update(float dTime);
-	//Restarts the current animation and timer
+	//Restarts the current animation and timer, re-reading its speed (so reloaded FPS values apply from here)
 	void RestartAnimation(bool play);
 
 	/*
@@ -371,6 +517,17 @@ public:
 	//Rebinds a sprite to this animator (should be the same sprite data, and called when sprite is lost for whatever reason)
 	void RebindSprite(SpriteData* spr) { m_SprData = spr; }
 
+	//
+	//Snapshots
+	//
+
+	/*
+		Writes animator state and current animation into snapshot. Restoring looks the animation up via the
+		bound sprites texture, so restore the sprite first.
+	*/
+	void SaveSnapshot(SnapshotWriter& writer);
+	bool LoadSnapshot(SnapshotReader& reader, bool apply = true);
+
 	/*
 		
 	*/
@@ -401,6 +558,16 @@ public:
 	//Sets frame relative to the number in the index container
 	void SetFrame(int newFrame, bool resetElapsed = true);
 
+	//Gets duration of a single frame (in seconds) with current speed values
+	float GetFrameDuration()						 { return 1.f / (m_Data.m_Speed * m_Data.m_AnimSpeedMod); }
+	//Evaluates the texture frame of the current animation at an absolute time since it started (doesn't modify state)
+	short SampleFrame(float time);
+	/*
+		Moves the current animation to the state at an absolute time since it started, as if updated all the way there
+		(stopping if the animation would have ended). Use to resync animators that skipped updates.
+	*/
+	void SetAnimationTime(float time);
+
 	//Set/Resets an animation with some optional control flags.
 	bool SetAnimation(int index, bool play, bool restartIfPlaying = false, bool loop = true, bool reverse = false);
 
@@ -416,6 +583,13 @@ private:
 	void Update_LinearAnimation(float dTime);
 	void Update_NonLinearAnimation(float dTime);
 
+	//Adds time, returning the number of whole frames passed (with the remainder carried over)
+	long long ConsumeElapsedFrames(float dTime);
+	//Sets current frame (and sprite frame) from frame relative to the start of the animation
+	void ApplyRelativeFrame(int relativeFrame);
+	//Stops playback at the end of a non-looping animation
+	void EndAnimation();
+
 	////////////
 	/// Data ///
 	////////////
@@ -0,0 +1,144 @@
+#include "BE_Snapshot.h"
+
+#include "Utils/Utils_Debug.h"
+
+//
+//SnapshotWriter
+//
+
+void SnapshotWriter::Begin()
+{
+	m_Buffer.clear();
+
+	//Write placeholder header (finalised in End())
+	Header header;
+	Write(header);
+}
+
+void SnapshotWriter::End()
+{
+	msg_assert(m_Buffer.size() >= sizeof(Header), "End(): Begin() not called!");
+
+	//Patch payload size into header
+	uint32_t payloadSize = static_cast<uint32_t>(m_Buffer.size() - sizeof(Header));
+	std::memcpy(m_Buffer.data() + offsetof(Header, m_PayloadSize), &payloadSize, sizeof(uint32_t));
+}
+
+void SnapshotWriter::WriteBytes(const void* data, size_t size)
+{
+	size_t offset = m_Buffer.size();
+	m_Buffer.resize(offset + size);
+	std::memcpy(m_Buffer.data() + offset, data, size);
+}
+
+void SnapshotWriter::WriteString(const std::string& str)
+{
+	uint32_t size = static_cast<uint32_t>(str.size());
+	Write(size);
+	WriteBytes(str.data(), size);
+}
+
+size_t SnapshotWriter::BeginSection(uint32_t id)
+{
+	//Store where the section header starts, and write with empty size for now
+	size_t marker = m_Buffer.size();
+
+	SectionHeader section;
+	section.m_ID = id;
+	Write(section);
+
+	return marker;
+}
+
+void SnapshotWriter::EndSection(size_t marker)
+{
+	msg_assert(marker + sizeof(SectionHeader) <= m_Buffer.size(), "EndSection(): Invalid marker!");
+
+	//Patch size in (excluding the section header itself)
+	uint32_t size = static_cast<uint32_t>(m_Buffer.size() - marker - sizeof(SectionHeader));
+	std::memcpy(m_Buffer.data() + marker + offsetof(SectionHeader, m_Size), &size, sizeof(uint32_t));
+}
+
+//
+//SnapshotReader
+//
+
+bool SnapshotReader::Begin()
+{
+	m_Position = 0;
+
+	SnapshotWriter::Header header;
+	if (!Read(header))
+	{
+		DBOUT("SnapshotReader::Begin(): Data too small for header!");
+		return false;
+	}
+
+	if (header.m_Magic != SnapshotWriter::SNAPSHOT_MAGIC)
+	{
+		DBOUT("SnapshotReader::Begin(): Data not a snapshot!");
+		return false;
+	}
+
+	if (header.m_Version != SnapshotWriter::SNAPSHOT_VERSION)
+	{
+		DBOUT("SnapshotReader::Begin(): Snapshot from another version, cannot read!");
+		return false;
+	}
+
+	if (header.m_PayloadSize > GetRemaining())
+	{
+		DBOUT("SnapshotReader::Begin(): Snapshot truncated!");
+		return false;
+	}
+
+	//Limit reads to the payload
+	m_Size = m_Position + header.m_PayloadSize;
+	m_Version = header.m_Version;
+
+	return true;
+}
+
+bool SnapshotReader::ReadBytes(void* data, size_t size)
+{
+	if (size > GetRemaining())
+		return false;
+
+	std::memcpy(data, m_Data + m_Position, size);
+	m_Position += size;
+
+	return true;
+}
+
+bool SnapshotReader::ReadString(std::string& str)
+{
+	uint32_t size = 0;
+	if (!Read(size) || size > GetRemaining())
+		return false;
+
+	str.assign(reinterpret_cast<const char*>(m_Data + m_Position), size);
+	m_Position += size;
+
+	return true;
+}
+
+bool SnapshotReader::BeginSection(uint32_t& id, size_t& sectionEnd)
+{
+	SnapshotWriter::SectionHeader section;
+	if (!Read(section) || section.m_Size > GetRemaining())
+		return false;
+
+	id = section.m_ID;
+	sectionEnd = m_Position + section.m_Size;
+
+	return true;
+}
+
+bool SnapshotReader::SkipTo(size_t position)
+{
+	if (position > m_Size)
+		return false;
+
+	m_Position = position;
+	return true;
+}
@@ -0,0 +1,194 @@
+//*********************************************************************************\\
+//
+// Versioned binary snapshot format for actor, module and sprite/animator states.
+// All data is written into a single contiguous buffer as raw (trivially copyable)
+// blocks, allowing for fast save/restore for uses like quick-saving, rollback or
+// level streaming.
+//
+// Layout:
+// - Header (magic, version, payload size)
+// - Sections (ID, byte size, data), which can be nested (e.g. actor > modules)
+//
+// Section sizes allow readers to skip data they have no target for (e.g. a
+// module an actor no longer has). Snapshots are only read by the version that
+// wrote them, as there is no conversion from older layouts.
+//
+// Note: Resources (textures, batches, fonts, b2World) are NOT stored. Snapshots
+// are restored onto actors that have already been setup with their resources.
+//
+//*********************************************************************************\\
+
+#pragma once
+
+//Library Includes
+#include <vector>
+#include <string>
+#include <cstring>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+class SnapshotWriter
+{
+public:
+
+	//////////////////////////////
+	/// Enums, Types & Statics ///
+	//////////////////////////////
+
+	//"BESN"
+	static constexpr uint32_t SNAPSHOT_MAGIC = 0x4E534542;
+	//Current format version. Bump when the layout of any section changes, so older snapshots are rejected
+	static constexpr uint16_t SNAPSHOT_VERSION = 3;
+
+	struct Header
+	{
+		uint32_t m_Magic = SNAPSHOT_MAGIC;
+		uint16_t m_Version = SNAPSHOT_VERSION;
+		uint16_t m_Reserved = 0;
+		uint32_t m_PayloadSize = 0;
+	};
+
+	struct SectionHeader
+	{
+		uint32_t m_ID = 0;
+		uint32_t m_Size = 0;
+	};
+
+	//Common section IDs (module sections use their ModuleTypeID)
+	enum SectionID : uint32_t
+	{
+		SECTION_ACTOR = 0x52544341,			//"ACTR"
+		SECTION_ACTOR_EXTENDED = 0x58544341,	//"ACTX"
+		SECTION_SCENE = 0x4E454353,			//"SCEN"
+	};
+
+	////////////////////
+	/// Constructors ///
+	////////////////////
+
+	SnapshotWriter() { }
+	SnapshotWriter(size_t reserveSize) { m_Buffer.reserve(reserveSize); }
+	~SnapshotWriter() { }
+
+	//////////////////
+	/// Operations ///
+	//////////////////
+
+	/*
+		Starts a new snapshot, clearing any existing data (capacity is kept so repeated saves don't reallocate).
+	*/
+	void Begin();
+	//Finalises the snapshot header, after which the buffer is ready for use
+	void End();
+
+	//
+	//Writing
+	//
+
+	//Writes raw copy of the data (must be trivially copyable)
+	template<class T>
+	void Write(const T& data);
+	void WriteBytes(const void* data, size_t size);
+	//Writes string as size + characters
+	void WriteString(const std::string& str);
+
+	/*
+		Opens a new section, returning a marker that is given to EndSection when the section data is written.
+	*/
+	size_t BeginSection(uint32_t id);
+	void EndSection(size_t marker);
+
+	/////////////////
+	/// Accessors ///
+	/////////////////
+
+	const std::vector<unsigned char>& GetBuffer() { return m_Buffer; }
+	const unsigned char* GetData() { return m_Buffer.data(); }
+	size_t GetSize() { return m_Buffer.size(); }
+
+private:
+
+	////////////
+	/// Data ///
+	////////////
+
+	std::vector<unsigned char> m_Buffer;
+};
+
+class SnapshotReader
+{
+public:
+
+	////////////////////
+	/// Constructors ///
+	////////////////////
+
+	SnapshotReader(const unsigned char* data, size_t size)
+		:m_Data(data), m_Size(size)
+	{}
+	SnapshotReader(const std::vector<unsigned char>& buffer)
+		:m_Data(buffer.data()), m_Size(buffer.size())
+	{}
+	~SnapshotReader() { }
+
+	//////////////////
+	/// Operations ///
+	//////////////////
+
+	//Validates and reads header. Fails if data is not a snapshot, is truncated or from another version.
+	bool Begin();
+
+	//
+	//Reading (all fail without modifying output if not enough data remains)
+	//
+
+	template<class T>
+	bool Read(T& data);
+	bool ReadBytes(void* data, size_t size);
+	bool ReadString(std::string& str);
+
+	/*
+		Reads the next section header, giving the ID and the position where the section ends (see SkipTo).
+	*/
+	bool BeginSection(uint32_t& id, size_t& sectionEnd);
+	//Moves read position to given position (used to skip the rest of a section, or return to an earlier one)
+	bool SkipTo(size_t position);
+
+	/////////////////
+	/// Accessors ///
+	/////////////////
+
+	uint16_t GetVersion() { return m_Version; }
+	size_t GetPosition() { return m_Position; }
+	size_t GetRemaining() { return m_Size - m_Position; }
+
+private:
+
+	////////////
+	/// Data ///
+	////////////
+
+	const unsigned char* m_Data = nullptr;
+	size_t m_Size = 0;
+	size_t m_Position = 0;
+	uint16_t m_Version = 0;
+};
+
+//
+//Template Funcs
+//
+
+template<class T>
+void SnapshotWriter::Write(const T& data)
+{
+	static_assert(std::is_trivially_copyable<T>::value, "SnapshotWriter::Write(): Type must be trivially copyable!");
+	WriteBytes(&data, sizeof(T));
+}
+
+template<class T>
+bool SnapshotReader::Read(T& data)
+{
+	static_assert(std::is_trivially_copyable<T>::value, "SnapshotReader::Read(): Type must be trivially copyable!");
+	return ReadBytes(&data, sizeof(T));
+}
@@ -81,6 +81,8 @@ struct W_SpriteBatch
 	//Transformation/Camera
 	//Batches can be transformed as required so keep a specially tailored class for it here
 	SceneTransform m_Transform;
+	//Viewport the batch was created with (the batch keeps its own copy), used to cull render groups. Zero sized skips culling.
+	D3D12_VIEWPORT m_Viewport = {};
 	
 	/*
 		As part of Mgr_Graphics, this can be used for render group based rendering. 
@@ -16,6 +16,13 @@ using Microsoft::WRL::ComPtr;
 //========================================
 
 void CalcStringJustification(DirectX::SpriteFont* sf, StringJustificationID index, const std::string& message, Vec2& origin)
+{
+	//Top left needs no measuring
+	Vec2 size = index == StringJustificationID::LEFT_TOP ? Vec2(0.f, 0.f) : Vec2(sf->MeasureString(message.c_str()));
+	CalcStringJustification(index, size, origin);
+}
+
+void CalcStringJustification(StringJustificationID index, const Vec2& size, Vec2& origin)
 {
 	switch (index)
 	{
@@ -24,41 +31,41 @@ void CalcStringJustification(DirectX::SpriteFont* sf, StringJustificationID inde
 		break;
 
 	case StringJustificationID::LEFT:
-		origin = sf->MeasureString(message.c_str()) * 0.5f;
+		origin = size * 0.5f;
 		origin.x = 0.f;
 		break;
 
 	case StringJustificationID::LEFT_BOTTOM:
-		origin = sf->MeasureString(message.c_str());
+		origin = size;
 		origin.x = 0.f;
 		break;
 
 	case StringJustificationID::RIGHT_TOP:
-		origin = sf->MeasureString(message.c_str());
+		origin = size;
 		origin.y = 0.f;
 		break;
 
 	case StringJustificationID::RIGHT:
-		origin = sf->MeasureString(message.c_str());
+		origin = size;
 		origin.y *= 0.5f;
 		break;
 
 	case StringJustificationID::RIGHT_BOTTOM:
-		origin = sf->MeasureString(message.c_str());
+		origin = size;
 		break;
 
 	case StringJustificationID::TOP:
-		origin = sf->MeasureString(message.c_str()) * 0.5f;
+		origin = size * 0.5f;
 		origin.y = 0.f;
 		break;
 
 	case StringJustificationID::BOTTOM:
-		origin = sf->MeasureString(message.c_str());
+		origin = size;
 		origin.x *= 0.5f;
 		break;
 
 	case StringJustificationID::CENTER:
-		origin = sf->MeasureString(message.c_str()) * 0.5f;
+		origin = size * 0.5f;
 		break;
 
 	default:
@@ -183,6 +183,8 @@ typedef DirectX::XMUINT4 XMUI4;
 
 //Calculates the origin point of a string using JustificationPosition input, alongside spritefont and message to position correctly
 void CalcStringJustification(DirectX::SpriteFont* sf, StringJustificationID index, const std::string& message, Vec2& origin);
+//As above, using an already measured string size (e.g. from a cached layout, see GlyphLayoutCache)
+void CalcStringJustification(StringJustificationID index, const Vec2& size, Vec2& origin);
 
 //Updates window dims using AR index
 void GetNewWindowSize_16_9(AspectRatios_16by9 index, int& x, int& y);
@@ -8,23 +8,96 @@
 
 #include <string>
 #include "document.h"
+#include "prettywriter.h"
+#include "stringbuffer.h"
+
+#include "error/en.h"
+
+#include "IO/AssetPack.h"
 
 #include <fstream>
 #include <sstream>
 
-//Loads and parses JSON file into document object
-static inline void ParseNewJSONDocument(rapidjson::Document& doc, std::string& filePath)
+/*
+	Loads and parses JSON file into document object, returning false (with reason in outError if given) if the file
+	couldn't be read, or doesn't hold a valid JSON object.
+
+	The file is read with a single read straight into the documents own memory pool, and parsed in place (strings
+	reference the buffer rather than being copied), so the buffer lives and dies with the document without any
+	extra allocations.
+
+	Files in a mounted AssetPack are parsed from the pack instead (strings are copied into the pool, as the pack
+	can't be written to), without opening the file.
+*/
+static inline bool ParseNewJSONDocument(rapidjson::Document& doc, const std::string& filePath, std::string* outError = nullptr)
+{
+	//Served from a mounted asset pack if it has the file (parsed straight from the view, as packs are read only)
+	AssetPack::View packed;
+	if (AssetPack::FindMounted(filePath, packed))
+		doc.Parse(reinterpret_cast<const char*>(packed.m_Data), packed.m_Size);
+	else
+	{
+		//Open at the end to get the size
+		std::ifstream inputStream(filePath, std::ios::binary | std::ios::ate);
+		if (!inputStream.is_open())
+		{
+			doc.SetNull();
+			if (outError)
+				*outError = "Failed to open file: " + filePath;
+			return false;
+		}
+		size_t size = static_cast<size_t>(inputStream.tellg());
+		inputStream.seekg(0, std::ios::beg);
+
+		//Read whole file into pool (null terminated for parsing)
+		char* buffer = static_cast<char*>(doc.GetAllocator().Malloc(size + 1));
+		if (!buffer || !inputStream.read(buffer, size))
+		{
+			doc.SetNull();
+			if (outError)
+				*outError = "Failed to read file: " + filePath;
+			return false;
+		}
+		buffer[size] = '\0';
+		inputStream.close();
+
+		//Parse in place
+		doc.ParseInsitu(buffer);
+	}
+
+	//Confirm object status
+	if (doc.HasParseError())
+	{
+		if (outError)
+		{
+			std::ostringstream error;
+			error << filePath << " (offset " << doc.GetErrorOffset() << "): " << rapidjson::GetParseError_En(doc.GetParseError());
+			*outError = error.str();
+		}
+		return false;
+	}
+	if (!doc.IsObject())
+	{
+		if (outError)
+			*outError = filePath + ": Root is not an object";
+		return false;
+	}
+
+	return true;
+}
+
+//Writes document to file (pretty printed), returning false if the file couldn't be written
+static inline bool WriteJSONDocument(const rapidjson::Document& doc, const std::string& filePath)
 {
-	//Open a stringstream and load file into it
-	std::stringstream jsonDocBuffer;
-	std::string inputLine;
-	std::ifstream inputStream(filePath);
-
-	while (std::getline(inputStream, inputLine))
-		jsonDocBuffer << inputLine << "\n";
-
-	//Close, parse and confirm object status
-	inputStream.close();
-	doc.Parse(jsonDocBuffer.str().c_str());
-	assert(doc.IsObject());
+	rapidjson::StringBuffer buffer;
+	rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buffer);
+	writer.SetIndent(' ', 2);
+	doc.Accept(writer);
+
+	std::ofstream outputStream(filePath);
+	if (!outputStream.is_open())
+		return false;
+
+	outputStream << buffer.GetString();
+	return static_cast<bool>(outputStream);
 }
\ No newline at end of file
@@ -1,8 +1,13 @@
 #include "Box2DPhysics_Demo.h"
 
+//Library Includes
+#include <chrono>
+#include <algorithm>
+
 //Utilities
 #include "Utils/MathHelper.h"
 #include "Utils/Utils_General.h"
+#include "Utils/Utils_Debug.h"
 
 //Project Includes
 #include "All_Managers.h"
@@ -26,6 +31,9 @@ void Box2DPhysics_Demo::Setup_Ballpit(System& sys)
 	m_Props.clear();
 	m_Props.reserve((unsigned)ConfigData::DEFAULT_RESERVE_COUNT);
 
+	//Fresh arena for prop modules (previous one is released with the last of its modules)
+	m_PropModuleArena = std::make_shared<ModuleArena>((size_t)ConfigData::POOL_ARENA_BLOCK_SIZE);
+
 	float winX = (float)sys.m_Blackboard->m_NativeWinX;
 	float winY = (float)sys.m_Blackboard->m_NativeWinY;
 
@@ -39,6 +47,7 @@ void Box2DPhysics_Demo::Setup_Ballpit(System& sys)
 		{
 			//Insert new prop
 			m_Props.push_back(Entity_DemoProp());
+			m_Props.back().SetModuleArena(m_PropModuleArena);
 			m_Props.back().RunOnceInit(sys);
 		}
 
@@ -112,6 +121,103 @@ void Box2DPhysics_Demo::Setup_Ballpit(System& sys)
 		a.ReSyncModules();
 }
 
+void Box2DPhysics_Demo::RunSpawnBenchmark(System& sys, unsigned count)
+{
+	PrefabLibrary::PrefabID prefabID = m_PrefabLibrary.FindPrefabID(std::string("Block_Small"));
+	if (prefabID == PrefabLibrary::INVALID_ID)
+	{
+		msg_assert(false, "RunSpawnBenchmark(): Prefab not found!");
+		return;
+	}
+
+	//Spread spawns over the window
+	float winX = (float)sys.m_Blackboard->m_NativeWinX;
+	float winY = (float)sys.m_Blackboard->m_NativeWinY;
+	std::vector<Vec2> positions;
+	positions.reserve(count);
+	for (unsigned i(0); i < count; ++i)
+		positions.push_back({ MathHelper::RandF(0.f, winX), MathHelper::RandF(0.f, winY) });
+
+	typedef std::chrono::high_resolution_clock Clock;
+	double initPropMS = 0.0;
+	double prefabMS = 0.0;
+	double prefabArenaMS = 0.0;
+	//Module heap allocations made by each pass
+	size_t initPropAllocs = 0;
+	size_t prefabAllocs = 0;
+	size_t prefabArenaAllocs = 0;
+
+	//
+	//InitProp
+	//
+
+	{
+		//World declared first so props (and their bodies) are released before it
+		b2World world(b2Vec2(0.f, -9.8f));
+		std::vector<Entity_DemoProp> props(count);
+
+		ModuleArena::ResetGlobalCounters();
+		auto start = Clock::now();
+		for (unsigned i(0); i < count; ++i)
+		{
+			props[i].RunOnceInit(sys);
+			props[i].InitProp(Entity_DemoProp::PropSetupID::BLOCK_SMALL, &world);
+
+			Module_Sprite* spr = recast_static(Module_Sprite*, props[i].GetModule((unsigned)Entity_DemoProp::ModuleIndexes::SPRITE));
+			Module_Box2D_RigidBody2D* body = recast_static(Module_Box2D_RigidBody2D*, props[i].GetModule((unsigned)Entity_DemoProp::ModuleIndexes::RIGIDBODY));
+			spr->GetSpriteData().m_Position = positions[i];
+			body->SyncWithSpriteData(spr->GetSpriteData());
+		}
+		initPropMS = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+		initPropAllocs = ModuleArena::GetGlobalCounters().m_HeapAllocations;
+	}
+
+	//
+	//Prefab
+	//
+
+	{
+		b2World world(b2Vec2(0.f, -9.8f));
+		std::vector<Entity_DemoProp> props(count);
+
+		ModuleArena::ResetGlobalCounters();
+		auto start = Clock::now();
+		m_PrefabLibrary.InstantiateBulk(prefabID, props.data(), positions.data(), props.size(), &world);
+		prefabMS = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+		prefabAllocs = ModuleArena::GetGlobalCounters().m_HeapAllocations;
+	}
+
+	//
+	//Prefab + Pooled Arena
+	//
+
+	{
+		b2World world(b2Vec2(0.f, -9.8f));
+		std::vector<Entity_DemoProp> props(count);
+
+		ModuleArena::ResetGlobalCounters();
+		auto start = Clock::now();
+		std::shared_ptr<ModuleArena> arena = std::make_shared<ModuleArena>((size_t)ConfigData::POOL_ARENA_BLOCK_SIZE);
+		for (auto& a : props)
+			a.SetModuleArena(arena);
+		m_PrefabLibrary.InstantiateBulk(prefabID, props.data(), positions.data(), props.size(), &world);
+		prefabArenaMS = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+		prefabArenaAllocs = ModuleArena::GetGlobalCounters().m_HeapAllocations;
+	}
+
+	//Spawn rates (props per ms), and speed up of each prefab pass over the InitProp path
+	double initPropRate = count / std::max(initPropMS, 1e-6);
+	double prefabRate = count / std::max(prefabMS, 1e-6);
+	double prefabArenaRate = count / std::max(prefabArenaMS, 1e-6);
+
+	DBOUT("Spawn Benchmark (" << count << " props):" <<
+		"\n  InitProp = " << initPropMS << "ms (" << initPropRate << " props/ms), " << initPropAllocs << " module allocations" <<
+		"\n  Prefab = " << prefabMS << "ms (" << prefabRate << " props/ms, x" << prefabRate / initPropRate << " vs InitProp), " <<
+		prefabAllocs << " module allocations" <<
+		"\n  Prefab + Arena = " << prefabArenaMS << "ms (" << prefabArenaRate << " props/ms, x" << prefabArenaRate / initPropRate << " vs InitProp), " <<
+		prefabArenaAllocs << " module allocations");
+}
+
 void Box2DPhysics_Demo::Update_Main(System& sys)
 {
 	for (auto& a : m_Props)
@@ -156,6 +262,14 @@ void Box2DPhysics_Demo::SetupDemo(System& sys, ModeID id)
 		return;
 	}
 
+	//Compile prefabs on first setup
+	if (m_PrefabLibrary.GetPrefabCount() == 0)
+		m_PrefabLibrary.LoadPrefabsFromManifest(std::string(BE_PREFAB_MANIFEST_FP), sys);
+
+#if BE_RUN_PREFAB_SPAWN_BENCHMARK
+	RunSpawnBenchmark(sys, (unsigned)ConfigData::BENCHMARK_SPAWN_COUNT);
+#endif
+
 	switch(id)
 	{
 	case ModeID::BALLPIT:
@@ -6,6 +6,9 @@
 
 #pragma once
 
+//Engine Includes
+#include "Prefabs/PrefabLibrary.h"
+
 //Project Includes
 #include "Entity_DemoProp.h"
 
@@ -70,7 +73,9 @@ private:
 	{
 		DEFAULT_RESERVE_COUNT = 500,
 		DEFAULT_BOUNDARIES_COUNT = 4, 
-		BALLPIT_DEFAULT_PROP_COUNT = 175
+		BALLPIT_DEFAULT_PROP_COUNT = 175,
+		BENCHMARK_SPAWN_COUNT = 2000,
+		POOL_ARENA_BLOCK_SIZE = 16384
 	};
 
 
@@ -87,12 +92,27 @@ private:
 
 	void Setup_Ballpit(System& sys);
 
+	//
+	//Benchmarks
+	//
+
+	/*
+		Spawns the given number of props via InitProp, prefab instancing, and prefab instancing with a pooled module arena
+		(each into its own temporary world), outputting the time taken, spawn rate (and speed up over InitProp) and module
+		heap allocations made for each via DBOUT.
+	*/
+	void RunSpawnBenchmark(System& sys, unsigned count);
+
 	////////////
 	/// Data ///
 	////////////
 
 	//Props
 	std::vector<Entity_DemoProp> m_Props;
+	//Shared arena that prop modules are allocated from
+	std::shared_ptr<ModuleArena> m_PropModuleArena;
+	//Compiled prop prefabs (loaded on first setup)
+	PrefabLibrary m_PrefabLibrary;
 
 	//World be using for simulations
 	b2World* m_World = nullptr;
@@ -14,6 +14,8 @@
 //Project Includes
 #include "Texture_Enums/BE_2DTestingTextureEnums.h"
 
+AnimationStateMachine Entity_DemoPlayer::s_AnimStates;
+
 void Entity_DemoPlayer::Update_Main(System& sys)
 {
 	//
@@ -234,43 +236,17 @@ void Entity_DemoPlayer::Update_Main(System& sys)
 	//Post-Input Animation
 	//
 
-	if (pendingVel.x != 0.f && m_IsGrounded)
-	{
-		if (pendingVel.x < 0.f)
-			spr->GetAnimator().SetAnimation((int)BE_TextureEnums::BE_2DTestingTextureFrames::TEMPLATE_PLAYER_RUN_L, true);
-		else if (pendingVel.x > 0.f)
-			spr->GetAnimator().SetAnimation((int)BE_TextureEnums::BE_2DTestingTextureFrames::TEMPLATE_PLAYER_RUN_R, true);
-	}
-	else if (pendingVel.x == 0.f && m_IsGrounded)
-	{
-		if (m_FacingDirection == Directions4::LEFT)
-			spr->GetAnimator().SetAnimation((int)BE_TextureEnums::BE_2DTestingTextureFrames::TEMPLATE_PLAYER_IDLE_L, true);
-		else
-			spr->GetAnimator().SetAnimation((int)BE_TextureEnums::BE_2DTestingTextureFrames::TEMPLATE_PLAYER_IDLE_R, true);
-	}
-
-
-	if (pendingVel.y != 0.f && !m_IsGrounded && !m_IsWallHanging)
-	{
-		if (m_FacingDirection == Directions4::LEFT)
-		{
-			//If doing the opposite animation, branch to this animation instead of playing it normally, else start as normal
-			if (spr->GetAnimator().GetAnimationID() == (unsigned)BE_TextureEnums::BE_2DTestingTextureFrames::TEMPLATE_PLAYER_JUMP_R)
-				spr->GetAnimator().BranchAnimation((int)BE_TextureEnums::BE_2DTestingTextureFrames::TEMPLATE_PLAYER_JUMP_L, true, false, false, true);
-			else
-				spr->GetAnimator().SetAnimation((int)BE_TextureEnums::BE_2DTestingTextureFrames::TEMPLATE_PLAYER_JUMP_L, true, false, false, false);
-		}
-		else if (m_FacingDirection == Directions4::RIGHT)
-		{
-			//If doing the opposite animation, branch to this animation instead of playing it normally, else start as normal
-			if (spr->GetAnimator().GetAnimationID() == (unsigned)BE_TextureEnums::BE_2DTestingTextureFrames::TEMPLATE_PLAYER_JUMP_L)
-				spr->GetAnimator().BranchAnimation((int)BE_TextureEnums::BE_2DTestingTextureFrames::TEMPLATE_PLAYER_JUMP_R, true, false, false, true);
-			else
-				spr->GetAnimator().SetAnimation((int)BE_TextureEnums::BE_2DTestingTextureFrames::TEMPLATE_PLAYER_JUMP_R, true, false, false, false);
-		}
-
-	}
+	/*
+		Animations are picked by the state machine from the current conditions, with the table handling what animation
+		to move to from the current one (and when to branch between animations, such as turning mid-jump).
+	*/
+	AnimationStateMachine::ConditionBits conditions = 0;
+	conditions |= m_IsGrounded ? m_AnimConditions.m_Grounded : 0;
+	conditions |= pendingVel.x != 0.f ? m_AnimConditions.m_Moving : 0;
+	conditions |= m_FacingDirection == Directions4::LEFT ? m_AnimConditions.m_FacingLeft : 0;
+	conditions |= (pendingVel.y != 0.f && !m_IsGrounded && !m_IsWallHanging) ? m_AnimConditions.m_Airborne : 0;
 
+	s_AnimStates.Apply(spr->GetAnimator(), conditions);
 
 	//Update animator
 	m_Modules[(int)ModuleIndexes::ANIMATED_SPRITE]->Update_Main(sys);
@@ -350,6 +326,15 @@ bool Entity_DemoPlayer::RunOnceInit(System& sys)
 
 		spr->GetSpriteData().SetTexture(std::string(BE_2DTestingTexture_ALIAS), sys);
 
+		//Load animation states if not yet loaded (shared between players), and get the condition bits used
+		if (!s_AnimStates.IsLoaded())
+			s_AnimStates.LoadFromFile(std::string(BE_2DTestingTexture_PlayerStates_FP), spr->GetSpriteData().m_Texture);
+
+		m_AnimConditions.m_Grounded = s_AnimStates.GetConditionMask(std::string("Grounded"));
+		m_AnimConditions.m_Moving = s_AnimStates.GetConditionMask(std::string("Moving"));
+		m_AnimConditions.m_FacingLeft = s_AnimStates.GetConditionMask(std::string("Facing_Left"));
+		m_AnimConditions.m_Airborne = s_AnimStates.GetConditionMask(std::string("Airborne"));
+
 		//Set initial animation state
 		spr->GetAnimator().SetAnimation((int)BE_TextureEnums::BE_2DTestingTextureFrames::TEMPLATE_PLAYER_IDLE_L, true);
 		//Set initial position
@@ -398,7 +383,7 @@ bool Entity_DemoPlayer::RunOnceInit(System& sys)
 		m_UtilityIDs.m_RenderGroupIndex = (unsigned)BE_ManagerEnums::SpritebatchIndexes::MAIN_SCENE;
 
 		//Close init flag
-		m_Flags.m_CanRunOnceInit = false;
+		SetFlag(Actor2D_FlagRegistry::FlagID::CAN_RUN_ONCE_INIT, false);
 		return true;
 	}
 
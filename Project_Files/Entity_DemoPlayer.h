@@ -11,6 +11,9 @@
 //Library Includes
 #include "box2d/b2_math.h"
 
+//Engine Includes
+#include "Animation/AnimationStateMachine.h"
+
 class Entity_DemoPlayer : public Actor2D_Interface
 {
 public:
@@ -136,6 +139,22 @@ private:
 	//Current facing direction (informed by inputs/conditions of collision events)
 	Directions4 m_FacingDirection = Directions4::LEFT;
 
+	//
+	//Animation
+	//
+
+	//Animation state machine (shared by all players, loaded by the first to init)
+	static AnimationStateMachine s_AnimStates;
+
+	//Condition bits for the state machine, looked up by name on init
+	struct AnimConditionMasks
+	{
+		AnimationStateMachine::ConditionBits m_Grounded = 0;
+		AnimationStateMachine::ConditionBits m_Moving = 0;
+		AnimationStateMachine::ConditionBits m_FacingLeft = 0;
+		AnimationStateMachine::ConditionBits m_Airborne = 0;
+	} m_AnimConditions;
+
 	//
 	//Movement 
 	//
@@ -60,7 +60,7 @@ bool Entity_DemoProp::RunOnceInit(System& sys)
 		m_UtilityIDs.m_RenderGroupIndex = (unsigned)BE_ManagerEnums::SpritebatchIndexes::MAIN_SCENE;
 		
 		//Close init flag
-		m_Flags.m_CanRunOnceInit = false;
+		SetFlag(Actor2D_FlagRegistry::FlagID::CAN_RUN_ONCE_INIT, false);
 		return true;
 	}
 
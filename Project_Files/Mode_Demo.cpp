@@ -18,6 +18,20 @@ RetCode Mode_Demo::Update_Main(System& sys)
 	//Entities
 	m_Player.Update_Main(sys);
 
+	//Quick save/load the background scene
+	if (sys.m_KBMMgr->IsKeyPressedNoRepeat(VK_F5))
+	{
+		m_QuickSave.Begin();
+		m_SceneDemo.SaveSnapshot(m_QuickSave);
+		m_QuickSave.End();
+	}
+	else if (sys.m_KBMMgr->IsKeyPressedNoRepeat(VK_F9) && m_QuickSave.GetSize() > 0)
+	{
+		SnapshotReader reader(m_QuickSave.GetBuffer());
+		if (reader.Begin() && m_SceneDemo.LoadSnapshot(reader))
+			m_UIs[(unsigned)MenuIndexes::SCENE_SWITCHER].ForceSceneNameUpdate();
+	}
+
 	//Demo's
 	m_SceneDemo.Update_Main(sys);
 	m_PhysicsDemo.Update_Main(sys);
@@ -13,6 +13,7 @@
 #include "Utils/MathHelper.h"
 
 //Engine Includes
+#include "Types/BE_Snapshot.h"
 
 //Project Includes
 #include "Entity_DemoPlayer.h"
@@ -105,6 +106,8 @@ private:
 
 	Box2DPhysics_Demo m_PhysicsDemo;
 	Scene_Demo m_SceneDemo;
+	//Quick save of the scene demo (F5 to save, F9 to load)
+	SnapshotWriter m_QuickSave;
 
 	//
 	//Entities
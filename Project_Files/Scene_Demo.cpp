@@ -7,6 +7,7 @@
 
 //Engine Includes
 #include "Includes/BE_All_Managers.h"
+#include "Types/BE_Snapshot.h"
 #include "Texture_Enums/Pixel_Sidescroller_City_Enums.h"
 
 
@@ -106,6 +107,51 @@ void DemoEnt_Scroller::SoftReset(System& sys)
 	m_ScrollSpeed = { 0.f, 0.f };
 }
 
+void DemoEnt_Scroller::SaveSnapshot(SnapshotWriter& writer)
+{
+	//Write core data, then scroller specific data
+	Actor2D_Interface::SaveSnapshot(writer);
+
+	size_t section = writer.BeginSection(SnapshotWriter::SECTION_ACTOR_EXTENDED);
+	writer.Write(m_ObjectID);
+	writer.Write(m_SceneID);
+	writer.Write(m_ScrollSpeed);
+	writer.Write(m_Limits);
+	writer.EndSection(section);
+}
+
+bool DemoEnt_Scroller::LoadSnapshot(SnapshotReader& reader, bool apply)
+{
+	//Read scroller data first (after the core actor section), so nothing is applied if it's invalid
+	size_t actorStart = reader.GetPosition();
+	uint32_t sectionID = 0;
+	size_t sectionEnd = 0;
+	if (!reader.BeginSection(sectionID, sectionEnd) || !reader.SkipTo(sectionEnd))
+		return false;
+	if (!reader.BeginSection(sectionID, sectionEnd) || sectionID != SnapshotWriter::SECTION_ACTOR_EXTENDED)
+		return false;
+
+	ObjectID objectID = ObjectID::TRAIN;
+	SceneID sceneID = SceneID::DAYTIME;
+	Vec2 scrollSpeed;
+	Vec2 limits;
+	bool result = reader.Read(objectID) && reader.Read(sceneID) && reader.Read(scrollSpeed) && reader.Read(limits);
+
+	//Then back to the core data
+	if (!result || !reader.SkipTo(actorStart) || !Actor2D_Interface::LoadSnapshot(reader, apply))
+		return false;
+
+	if (apply)
+	{
+		m_ObjectID = objectID;
+		m_SceneID = sceneID;
+		m_ScrollSpeed = scrollSpeed;
+		m_Limits = limits;
+	}
+
+	return reader.SkipTo(sectionEnd);
+}
+
 void DemoEnt_Static::Update_PreRender(System& sys)
 {
 	sys.m_GraphicsMgr->SubmitToRenderGroup((unsigned)BE_ManagerEnums::SpritebatchIndexes::MAIN_SCENE, this);
@@ -160,6 +206,13 @@ bool Scene_Demo::RunOnceInit(System& sys, SceneID id)
 			spr->GetSpriteData().SetFrame((unsigned)PSC_Frames::DAYTIME_BACKGROUND);
 		}
 
+		//Register all objects with the flag registry
+		m_FlagRegistry.Reserve(ArrayDefs::IDLE_COUNT + ArrayDefs::ANIMATED_COUNT);
+		for (auto& a : m_Statics)
+			m_FlagRegistry.RegisterActor(&a);
+		for (auto& a : m_Scrollers)
+			m_FlagRegistry.RegisterActor(&a);
+
 		//Setup the scene based on ID given
 		switch (id)
 		{
@@ -199,11 +252,79 @@ bool Scene_Demo::Update_Main(System& sys)
 
 void Scene_Demo::Update_PreRender(System& sys)
 {
-	//Each entity uses render groups so allow them to submit themselves
+	//Each entity uses render groups so filter for those able to render via groups and allow them to submit themselves
+	m_FlagRegistry.FilterActors(Actor2D_FlagRegistry::MASK_RENDER_GROUPED, m_FilteredActors);
+	for (auto& a : m_FilteredActors)
+		a->Update_PreRender(sys);
+}
+
+void Scene_Demo::SaveSnapshot(SnapshotWriter& writer)
+{
+	size_t section = writer.BeginSection(SnapshotWriter::SECTION_SCENE);
+
+	//Scene data
+	writer.Write(m_SceneID);
+	writer.Write(m_InitSetupDone);
+	writer.WriteString(m_SceneName);
+
+	SaveObjects(writer);
+
+	writer.EndSection(section);
+}
+
+bool Scene_Demo::LoadSnapshot(SnapshotReader& reader)
+{
+	uint32_t sectionID = 0;
+	size_t sectionEnd = 0;
+	if (!reader.BeginSection(sectionID, sectionEnd) || sectionID != SnapshotWriter::SECTION_SCENE)
+	{
+		msg_assert(false, "LoadSnapshot(): Scene section not found!");
+		return false;
+	}
+
+	SceneID sceneID = SceneID::DAYTIME;
+	bool initSetupDone = false;
+	std::string sceneName;
+	if (!reader.Read(sceneID) || !reader.Read(initSetupDone) || !reader.ReadString(sceneName))
+		return false;
+
+	//Check every object reads back before applying any, so an invalid snapshot leaves the scene untouched
+	size_t objectsStart = reader.GetPosition();
+	if (!LoadObjects(reader, false) || !reader.SkipTo(sectionEnd))
+		return false;
+
+	bool applied = reader.SkipTo(objectsStart) && LoadObjects(reader, true) && reader.SkipTo(sectionEnd);
+	if (!applied)
+	{
+		msg_assert(false, "LoadSnapshot(): Scene objects failed to apply after validation!");
+		return false;
+	}
+
+	m_SceneID = sceneID;
+	m_InitSetupDone = initSetupDone;
+	m_SceneName = std::move(sceneName);
+
+	return true;
+}
+
+void Scene_Demo::SaveObjects(SnapshotWriter& writer)
+{
+	for (auto& a : m_Statics)
+		a.SaveSnapshot(writer);
+	for (auto& a : m_Scrollers)
+		a.SaveSnapshot(writer);
+}
+
+bool Scene_Demo::LoadObjects(SnapshotReader& reader, bool apply)
+{
 	for (auto& a : m_Statics)
-		a.Update_PreRender(sys);
+		if (!a.LoadSnapshot(reader, apply))
+			return false;
 	for (auto& a : m_Scrollers)
-		a.Update_PreRender(sys);
+		if (!a.LoadSnapshot(reader, apply))
+			return false;
+
+	return true;
 }
 
 void Scene_Demo::SwitchScene(System& sys, SceneID id)
@@ -50,6 +50,8 @@ public:
 	void Update_PreRender(System& sys) override;
 	void Render(System& sys, DirectX::SpriteBatch* batch) override;
 	void SoftReset(System& sys) override;
+	void SaveSnapshot(SnapshotWriter& writer) override;
+	bool LoadSnapshot(SnapshotReader& reader, bool apply) override;
 
 	//////////////////
 	/// Operations ///
@@ -139,6 +141,15 @@ public:
 	void Update_PreRender(System& sys);
 
 
+	//
+	//Snapshots
+	//
+
+	//Writes the full scene state (scene IDs + all objects) into the snapshot
+	void SaveSnapshot(SnapshotWriter& writer);
+	//Restores scene from snapshot (RunOnceInit must have been called first), leaving the scene as it was on failure
+	bool LoadSnapshot(SnapshotReader& reader);
+
 	//Directly switches scene via given ID
 	void SwitchScene(System& sys, SceneID id);
 
@@ -190,6 +201,10 @@ private:
 	//Resets all scene elements to an unused state
 	void ResetScene();
 
+	//Writes/restores every scene object in order (see SaveSnapshot), only reading and checking the data if apply is false
+	void SaveObjects(SnapshotWriter& writer);
+	bool LoadObjects(SnapshotReader& reader, bool apply);
+
 	//Abandoned city setup function
 	bool Setup_Abandoned(System& sys);
 	bool Setup_Daytime(System& sys);
@@ -203,6 +218,11 @@ private:
 	DemoEnt_Scroller m_Scrollers[ArrayDefs::ANIMATED_COUNT];
 	DemoEnt_Static m_Statics[ArrayDefs::IDLE_COUNT];
 
+	//Mirrors the flags of the scene objects for filtered iteration
+	Actor2D_FlagRegistry m_FlagRegistry;
+	//Reusable results container for registry filtering
+	std::vector<Actor2D_Interface*> m_FilteredActors;
+
 	//Track internal scene
 	SceneID m_SceneID = SceneID::DAYTIME;
 	//Name of the current scene (changed on scene change)
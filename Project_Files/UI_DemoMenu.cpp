@@ -23,9 +23,6 @@ void UI_DemoMenu::Update_Main(System& sys)
 		std::vector<Module_UI_MouseCollider*> colliders = GetTModuleList<Module_UI_MouseCollider>(Module_Interface::ModuleTypeID::UI_MOUSE_COLLIDER);
 		for (unsigned i(0); i < colliders.size(); ++i)
 		{	
-			//Each collider is bound to a sprite, so sync collider to sprite position (as it could have been moved)
-			colliders[i]->SyncPositionWithSpriteData(colliders[i]->GetAssociatedObject<Module_Sprite>()->GetSpriteData());
-
 			//Is this collider being hovered?
 			if (colliders[i]->IsMouseHovering())
 			{
@@ -94,6 +91,16 @@ bool UI_DemoMenu::RunOnceInit(System& sys)
 		float posX = sys.m_Blackboard->m_NativeWinX * 0.5f;
 		float posY = sys.m_Blackboard->m_NativeWinY * 0.5f;
 
+		//
+		//Setup Transforms
+		//
+
+		//Root transform for the whole UI (moved via MoveTo)
+		Transform2D rootTransform;
+		rootTransform.m_Position = { posX, posY };
+		m_Transforms.Reserve((int)ModuleCounts::SPRITE_COUNT + 1);
+		m_RootTransform = m_Transforms.CreateTransform(rootTransform);
+
 		//
 		//Setup Sprites
 		//
@@ -109,6 +116,11 @@ bool UI_DemoMenu::RunOnceInit(System& sys)
 			//Set position + offsets
 			spr->GetSpriteData().m_Position = { posX + m_Offsets[i].x, posY + m_Offsets[i].y };
 
+			//Create child transform using offset as local position, and bind the sprite to it
+			Transform2D sprTransform;
+			sprTransform.m_Position = m_Offsets[i];
+			spr->BindTransform(&m_Transforms, m_Transforms.CreateTransform(sprTransform, m_RootTransform));
+
 			if (i == 1)
 				spr->GetSpriteData().m_SprEffect = DirectX::SpriteEffects::SpriteEffects_FlipHorizontally;
 		}
@@ -146,6 +158,8 @@ bool UI_DemoMenu::RunOnceInit(System& sys)
 
 			//Assign to module
 			collider->SetAsBoundingBox(box);
+			//Share the sprites transform so the collider follows it
+			collider->BindTransform(&m_Transforms, spr->GetTransformID());
 
 			//Submit to UI manager
 			sys.m_UIMgr->AddCollider(collider);
@@ -183,8 +197,8 @@ bool UI_DemoMenu::RunOnceInit(System& sys)
 		str->GetStringData().UpdateOrigin(StringJustificationID::CENTER);
 		//Adjust colour
 		str->GetStringData().m_Colour = Colours::Black;
-		//Sync position to dialog box element
-		str->SyncModulePosition(m_Modules[(unsigned)ModuleIndexes::SPRITE_DIALOG_BOX].get());
+		//Share dialog box elements transform (keeping position synced with it)
+		str->BindTransform(&m_Transforms, m_Modules[(unsigned)ModuleIndexes::SPRITE_DIALOG_BOX]->GetTransformID());
 	}
 
 	return false;
@@ -192,14 +206,10 @@ bool UI_DemoMenu::RunOnceInit(System& sys)
 
 void UI_DemoMenu::MoveTo(const Vec2& pos)
 {
-	std::vector<Module_Sprite*> sprites = GetTModuleList<Module_Sprite>(Module_Interface::ModuleTypeID::SPRITE);
-	msg_assert(sprites.size() == (int)ModuleCounts::SPRITE_COUNT, "MoveTo(): Less/More sprites than expected, will crash!");
-
-	for (unsigned i(0); i < sprites.size(); ++i)
-		sprites[i]->GetSpriteData().m_Position = pos + m_Offsets[i];
+	msg_assert(m_Transforms.IsValidID(m_RootTransform), "MoveTo(): Root transform not setup (call RunOnceInit first)!");
 
-	//Manually sync the msg box string to the box position
-	m_Modules[(int)ModuleIndexes::SFS_BOX_MSG].get()->SyncModulePosition(m_Modules[(int)ModuleIndexes::SPRITE_DIALOG_BOX].get());
+	//Move root, with all elements following via the hierarchy
+	m_Transforms.SetLocalPosition(m_RootTransform, pos);
 }
 
 void UI_DemoMenu::ForceSceneNameUpdate()
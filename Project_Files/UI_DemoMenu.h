@@ -7,6 +7,7 @@
 #pragma once
 
 #include "Actors/Actor2D_Interface.h"	//Parent
+#include "Transforms/TransformHierarchy2D.h"
 
 //Utils
 #include "Utils/Utils_General.h"
@@ -80,6 +81,12 @@ public:
 	UI_DemoMenu() {}
 	~UI_DemoMenu() {}
 
+	//Modules hold pointers into m_Transforms, so a copied/moved menu would leave them pointing at the source
+	UI_DemoMenu(const UI_DemoMenu&) = delete;
+	UI_DemoMenu& operator=(const UI_DemoMenu&) = delete;
+	UI_DemoMenu(UI_DemoMenu&&) = delete;
+	UI_DemoMenu& operator=(UI_DemoMenu&&) = delete;
+
 	/////////////////
 	/// Overrides ///
 	/////////////////
@@ -108,7 +115,7 @@ public:
 	//Utilities
 	//
 
-	//Move the UI and all its elements to this location (preserves offsets)
+	//Move the UI and all its elements to this location (preserves offsets via transform hierarchy)
 	void MoveTo(const Vec2& pos);
 
 	//////////////////
@@ -166,4 +173,8 @@ private:
 
 	//Hold on to scene name here for now (replacing later, this is just a test)
 	std::string m_SceneName = "NULL";
+
+	//Transforms for UI elements, with each sprite a child of the root (modules read world positions from here)
+	TransformHierarchy2D m_Transforms;
+	TransformHierarchy2D::TransformID m_RootTransform = TransformHierarchy2D::INVALID_ID;
 };
@@ -24,12 +24,55 @@ static int g_DEFAULT_WIN_Y = 1080;
 //Default number of frame resources (circular array of resources used to keep CPU/GPU non-idle)
 static const unsigned g_NUM_FRAME_RESOURCES = 3;
 
+//Runs the prop spawn benchmark (InitProp vs prefab instancing) when the physics demo is setup, output via DBOUT
+#define BE_RUN_PREFAB_SPAWN_BENCHMARK 0
+//Runs the JSON load benchmark (old line by line loading vs single read in-situ parsing) over the manifests and texture data at startup, output via DBOUT
+#define BE_RUN_JSON_LOAD_BENCHMARK 0
+//Runs the manifest load benchmark (serial vs threaded loading, headless) with the texture manifest repeated to 64x at startup, output via DBOUT
+#define BE_RUN_MANIFEST_LOAD_BENCHMARK 0
+//Runs the texture manifest through streaming (request, budgeted finalise, evict and reload, headless) at startup, output via DBOUT
+#define BE_RUN_TEXTURE_STREAMING_BENCHMARK 0
+//Runs the sprite animation benchmark (per-actor SpriteAnimators vs SpriteAnimationSystem) up to 100k sprites once textures are loaded, output via DBOUT
+#define BE_RUN_SPRITE_ANIMATION_BENCHMARK 0
+
+//Packs the texture manifest into atlases (see AtlasPacker) at startup, then loads from the packed manifest instead
+#define BE_RUN_ATLAS_PACKER 0
+//Builds polygon hulls for each texture frame (see SpriteHullBuilder) at startup, then loads the frame data with hulls
+#define BE_RUN_SPRITE_HULL_BUILDER 0
+//Bakes frame and animation data of the texture manifest to binary (see SpriteMetaBaker) at startup, loaded in place of the JSON
+#define BE_RUN_SPRITE_META_BAKER 0
+//Enables texture streaming (see TextureStreamer) once the initial textures are loaded, so later textures can be requested asynchronously
+#define BE_ENABLE_TEXTURE_STREAMING 0
+//Enables the texture residency cache (see TextureResidencyCache, requires streaming), evicting least recently drawn textures over the budget
+#define BE_ENABLE_TEXTURE_RESIDENCY 0
+//Reports distinct textures and estimated overdraw per render group (via DBOUT) on the first frame drawn
+#define BE_REPORT_RENDER_GROUP_STATS 0
+//Builds a single asset pack (see AssetPacker) of the texture, font and prefab manifests and every file they reference at startup
+#define BE_RUN_ASSET_PACKER 0
+//Mounts the asset pack (see AssetPack) at startup, so every file in it loads from the pack rather than loose
+#define BE_MOUNT_ASSET_PACK 0
+//Hot reloads texture manifests, frame and animation data when their files change (see Mgr_TextureResources::EnableHotReload)
+#define BE_ENABLE_HOT_RELOAD 0
+//Reports descriptor heap usage and fragmentation (via DBOUT, see DescriptorAllocator) once the initial textures are loaded
+#define BE_REPORT_DESCRIPTOR_HEAPS 0
+
 //================================================================================\\
 //Manifest Filepaths
 //================================================================================\\
 
 #define BE_TEXTURE_MANIFEST_FP "../../BEngine/Resources/Manifests/Texture_Manifest.json"
 #define BE_FONT_MANIFEST_FP "../../BEngine/Resources/Manifests/Font_Manifest.json"
+#define BE_PREFAB_MANIFEST_FP "../../BEngine/Resources/Manifests/Prefab_Manifest.json"
+//Output of the atlas packer (see BE_RUN_ATLAS_PACKER)
+#define BE_ATLAS_TEXTURE_MANIFEST_FP "../../BEngine/Resources/Manifests/Texture_Manifest_Atlased.json"
+//Output of the hull builder (see BE_RUN_SPRITE_HULL_BUILDER)
+#define BE_HULL_TEXTURE_MANIFEST_FP "../../BEngine/Resources/Manifests/Texture_Manifest_Hulls.json"
+//Output of the asset packer, and pack mounted at startup (see BE_RUN_ASSET_PACKER and BE_MOUNT_ASSET_PACK)
+#define BE_ASSET_PACK_FP "../../BEngine/Resources/BEngine_Assets.bepack"
+//Texture (loaded up front) whose first frame is drawn in place of textures still streaming in (see BE_ENABLE_TEXTURE_STREAMING)
+#define BE_STREAMING_PLACEHOLDER_TEXTURE "BE_2DTestingTexture"
+//Texture memory budget of the residency cache (see BE_ENABLE_TEXTURE_RESIDENCY), in MB of texture files
+#define BE_TEXTURE_RESIDENCY_BUDGET_MB 256
 
 //================================================================================\\
 //Manager Enums (Accessed via BE_ManagerEnums)
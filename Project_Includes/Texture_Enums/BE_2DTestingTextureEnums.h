@@ -7,6 +7,8 @@
 #define BE_2DTestingTexture_FP "../../BEngine/Resources/Textures/BE_2DTestingTexture.dds"
 #define BE_2DTestingTexture_Frames_FP "../../BEngine/Resources/Textures/BE_2DTestingTexture.json"
 #define BE_2DTestingTexture_ALIAS "BE_2DTestingTexture"
+//Animation state machine for the template player
+#define BE_2DTestingTexture_PlayerStates_FP "../../BEngine/Resources/Textures/BE_2DTestingTexture_PlayerStates.json"
 
 namespace BE_TextureEnums
 {